@@ -0,0 +1,91 @@
+# Static libraries shared by the retrofe executable, the unit tests and the
+# benchmarks. Include this after RETROFE_DIR, ZLIB_LIBRARIES and the compiler
+# flags are set up. It defines:
+#
+#  retrofe_core    - Utility, Database, Collection, the input script parser
+#                    and ViewInfo. Needs SQLite and zlib but no SDL, so it can
+#                    be linked into tests directly.
+#  retrofe_render  - SDL free pixel and animation kernels. Compiled with
+#                    RETROFE_RENDER_FLAGS (e.g. "-O3 -march=native").
+#  retrofe_sqlite3 - The bundled SQLite amalgamation, unless the system
+#                    SQLite is used (RETROFE_SYSTEM_SQLITE).
+
+option(RETROFE_SYSTEM_SQLITE "Link against the system SQLite instead of ThirdParty/sqlite3" OFF)
+set(RETROFE_RENDER_FLAGS "" CACHE STRING "Extra compiler flags for the pixel and animation kernels")
+option(RETROFE_COUNT_ALLOCATIONS "Count heap allocations per frame in benchmarks (replaces the global operator new)" OFF)
+
+if(RETROFE_COUNT_ALLOCATIONS)
+	add_definitions(-DRETROFE_COUNT_ALLOCATIONS)
+endif()
+
+find_package(Threads REQUIRED)
+
+set(SQLITE3_ROOT "${RETROFE_DIR}/ThirdParty/sqlite3")
+set(RETROFE_USE_SYSTEM_SQLITE ${RETROFE_SYSTEM_SQLITE})
+if(NOT RETROFE_USE_SYSTEM_SQLITE AND NOT EXISTS "${SQLITE3_ROOT}/sqlite3.c")
+	message(STATUS "${SQLITE3_ROOT}/sqlite3.c not found, using the system SQLite")
+	set(RETROFE_USE_SYSTEM_SQLITE ON)
+endif()
+
+if(RETROFE_USE_SYSTEM_SQLITE)
+	find_path(SQLITE3_INCLUDE_DIR sqlite3.h)
+	find_library(SQLITE3_LIBRARY sqlite3)
+	if(NOT SQLITE3_INCLUDE_DIR OR NOT SQLITE3_LIBRARY)
+		message(FATAL_ERROR "System SQLite not found, set SQLITE3_INCLUDE_DIR and SQLITE3_LIBRARY")
+	endif()
+	set(SQLITE3_LIBRARIES ${SQLITE3_LIBRARY})
+else()
+	set(SQLITE3_INCLUDE_DIR "${SQLITE3_ROOT}")
+	add_library(retrofe_sqlite3 STATIC "${SQLITE3_ROOT}/sqlite3.c")
+	target_link_libraries(retrofe_sqlite3 ${CMAKE_DL_LIBS} ${CMAKE_THREAD_LIBS_INIT})
+	set(SQLITE3_LIBRARIES retrofe_sqlite3)
+endif()
+
+include_directories(
+	"${RETROFE_DIR}/Source"
+	"${RETROFE_DIR}/ThirdParty/rapidxml-1.13"
+	"${SQLITE3_INCLUDE_DIR}"
+	${ZLIB_INCLUDE_DIRS}
+)
+
+set(RETROFE_CORE_SOURCES
+	"${RETROFE_DIR}/Source/Collection/CollectionInfo.cpp"
+	"${RETROFE_DIR}/Source/Collection/CollectionInfoBuilder.cpp"
+	"${RETROFE_DIR}/Source/Collection/Item.cpp"
+	"${RETROFE_DIR}/Source/Collection/JumpIndex.cpp"
+	"${RETROFE_DIR}/Source/Collection/MenuParser.cpp"
+	"${RETROFE_DIR}/Source/Collection/PlaylistJournal.cpp"
+	"${RETROFE_DIR}/Source/Control/InputScript.cpp"
+	"${RETROFE_DIR}/Source/Database/Configuration.cpp"
+	"${RETROFE_DIR}/Source/Database/DB.cpp"
+	"${RETROFE_DIR}/Source/Database/MetadataDatabase.cpp"
+	"${RETROFE_DIR}/Source/Execute/Process.cpp"
+	"${RETROFE_DIR}/Source/Graphics/ViewInfo.cpp"
+	"${RETROFE_DIR}/Source/Utility/FrameStats.cpp"
+	"${RETROFE_DIR}/Source/Utility/Log.cpp"
+	"${RETROFE_DIR}/Source/Utility/Lz4.cpp"
+	"${RETROFE_DIR}/Source/Utility/SurfaceBudget.cpp"
+	"${RETROFE_DIR}/Source/Utility/SystemState.cpp"
+	"${RETROFE_DIR}/Source/Utility/Utils.cpp"
+)
+
+set(RETROFE_RENDER_SOURCES
+	"${RETROFE_DIR}/Source/Graphics/AlphaBlend.cpp"
+	"${RETROFE_DIR}/Source/Graphics/FrameCapture.cpp"
+	"${RETROFE_DIR}/Source/Graphics/MipChain.cpp"
+	"${RETROFE_DIR}/Source/Graphics/Reflector.cpp"
+	"${RETROFE_DIR}/Source/Graphics/Resampler.cpp"
+	"${RETROFE_DIR}/Source/Graphics/Rotator.cpp"
+	"${RETROFE_DIR}/Source/Graphics/Animate/Tween.cpp"
+	"${RETROFE_DIR}/Source/Graphics/Animate/TweenBatch.cpp"
+	"${RETROFE_DIR}/Source/Video/YuvConverter.cpp"
+)
+
+add_library(retrofe_core STATIC ${RETROFE_CORE_SOURCES})
+target_link_libraries(retrofe_core ${SQLITE3_LIBRARIES} ${ZLIB_LIBRARIES} ${CMAKE_THREAD_LIBS_INIT})
+
+add_library(retrofe_render STATIC ${RETROFE_RENDER_SOURCES})
+target_link_libraries(retrofe_render ${ZLIB_LIBRARIES} ${CMAKE_THREAD_LIBS_INIT})
+if(RETROFE_RENDER_FLAGS)
+	set_property(TARGET retrofe_render APPEND_STRING PROPERTY COMPILE_FLAGS " ${RETROFE_RENDER_FLAGS}")
+endif()
@@ -15,6 +15,7 @@
  */
 #include "CollectionInfo.h"
 #include "Item.h"
+#include "PlaylistJournal.h"
 #include "../Database/Configuration.h"
 #include "../Utility/Utils.h"
 #include "../Utility/Log.h"
@@ -47,11 +48,15 @@ CollectionInfo::CollectionInfo(std::string name,
     , subsSplit(false)
     , metadataPath_(metadataPath)
 	, extensions_(extensions)
+    , favoritesJournal_(NULL)
 {
 }
 
 CollectionInfo::~CollectionInfo()
 {
+    // Blocks until the pending favorites changes are on disk.
+    delete favoritesJournal_;
+
     Playlists_T::iterator pit = playlists.begin();
 
     while(pit != playlists.end())
@@ -75,78 +80,56 @@ CollectionInfo::~CollectionInfo()
 
 bool CollectionInfo::Save() 
 {
-    bool retval = true;
     if(saveRequest)
     {
-        std::string dir  = Utils::combinePath(Configuration::userPath, "collections", name, "playlists");
-        std::string file = Utils::combinePath(Configuration::userPath, "collections", name, "playlists/favorites.txt");
-        Logger::write(Logger::ZONE_INFO, "Collection", "Saving " + file);
+        std::vector<Item *> *saveitems = playlists["favorites"];
+        std::vector<std::string> entries;
+        for(std::vector<Item *>::iterator it = saveitems->begin(); it != saveitems->end(); it++)
+        {
+            entries.push_back(playlistEntry(*it));
+        }
 
-        Utils::rootfsWritable();
+        // The journal already holds every change; rewriting the playlist
+        // only folds it back into favorites.txt, off the main thread.
+        favoritesJournal()->compact(entries);
+        saveRequest = false;
+    }
 
-        std::ofstream filestream;
-        try
-        {
-            // Create playlists directory if it does not exist yet.
-            struct stat info;
-            if ( stat( dir.c_str(), &info ) != 0 )
-            {
-#if defined(_WIN32) && !defined(__GNUC__)
-                if(!CreateDirectory(dir.c_str(), NULL))
-                {
-                    if(ERROR_ALREADY_EXISTS != GetLastError())
-                    {
-                        Logger::write(Logger::ZONE_WARNING, "Collection", "Could not create directory " + dir);
-                        Utils::rootfsReadOnly();
-                        return false;
-                    }
-                }
-#else 
-#if defined(__MINGW32__)
-                if(mkdir(dir.c_str()) == -1)
-#else
-                if(mkdir(dir.c_str(), 0755) == -1)
-#endif        
-                {
-                    Logger::write(Logger::ZONE_WARNING, "Collection", "Could not create directory " + dir);
-                    Utils::rootfsReadOnly();
-                    return false;
-                }
-#endif
-            }
-            else if ( !(info.st_mode & S_IFDIR) )
-            {
-                Logger::write(Logger::ZONE_WARNING, "Collection", dir + " exists, but is not a directory.");
-                Utils::rootfsReadOnly();
-                return false;
-            }
+    return true;
+}
 
-            filestream.open(file.c_str());
-            std::vector<Item *> *saveitems = playlists["favorites"];
-            for(std::vector<Item *>::iterator it = saveitems->begin(); it != saveitems->end(); it++)
-            {
-                if ((*it)->collectionInfo->name == name)
-                {
-                    filestream << (*it)->name << std::endl;
-                }
-                else
-                {
-                    filestream << "_" << (*it)->collectionInfo->name << ":" << (*it)->name << std::endl;
-                }
-            }
 
-            filestream.close();
-        }
-        catch(std::exception &)
-        {
-            Logger::write(Logger::ZONE_ERROR, "Collection", "Save failed: " + file);
-            retval = false;
-        }
+void CollectionInfo::favoriteChanged(Item *item, bool added)
+{
+    if(added)
+    {
+        favoritesJournal()->add(playlistEntry(item));
+    }
+    else
+    {
+        favoritesJournal()->remove(playlistEntry(item));
+    }
+    saveRequest = true;
+}
+
+
+PlaylistJournal *CollectionInfo::favoritesJournal()
+{
+    if(!favoritesJournal_)
+    {
+        favoritesJournal_ = new PlaylistJournal(Utils::combinePath(Configuration::userPath, "collections", name, "playlists/favorites.txt"));
+    }
+    return favoritesJournal_;
+}
+
 
-        Utils::rootfsReadOnly();
+std::string CollectionInfo::playlistEntry(Item *item)
+{
+    if(item->collectionInfo->name == name)
+    {
+        return item->name;
     }
-    
-    return retval;
+    return "_" + item->collectionInfo->name + ":" + item->name;
 }
 
 std::string CollectionInfo::settingsPath() const
@@ -20,6 +20,7 @@
 #include <map>
 
 class Item;
+class PlaylistJournal;
 
 class CollectionInfo
 {
@@ -28,6 +29,7 @@ public:
     virtual ~CollectionInfo();
     std::string settingsPath() const;
     bool Save();
+    void favoriteChanged(Item *item, bool added);
     void sortItems();
     void sortPlaylists();
     void addSubcollection(CollectionInfo *info);
@@ -48,6 +50,9 @@ public:
 private:
     std::string metadataPath_;
     std::string extensions_;
+    PlaylistJournal *favoritesJournal_;
+    PlaylistJournal *favoritesJournal();
+    std::string playlistEntry(Item *item);
     static bool itemIsLess(Item *lhs, Item *rhs);
 
 };
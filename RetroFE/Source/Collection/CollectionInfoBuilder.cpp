@@ -16,6 +16,7 @@
 #include "CollectionInfoBuilder.h"
 #include "CollectionInfo.h"
 #include "Item.h"
+#include "PlaylistJournal.h"
 #include "../Database/Configuration.h"
 #include "../Database/MetadataDatabase.h"
 #include "../Database/DB.h"
@@ -406,43 +407,20 @@ void CollectionInfoBuilder::addPlaylists(CollectionInfo *info)
             {
                 Logger::write(Logger::ZONE_INFO, "RetroFE", "Loading playlist: " + basename);
 
-                std::map<std::string, Item *> playlistFilter;
                 std::string playlistFile = Utils::combinePath(Configuration::userPath, "collections", info->name, "playlists", file);
-                ImportBasicList(info, playlistFile, playlistFilter);
-
-                info->playlists[basename] = new std::vector<Item *>();
-
-                // add the playlist list 
-                for(std::map<std::string, Item *>::iterator it = playlistFilter.begin(); it != playlistFilter.end(); it++)
-                {
-                    std::string collectionName = info->name;
-                    std::string itemName       = it->first;
-                    if (itemName.at(0) == '_') // name consists of _<collectionName>:<itemName>
-                    {
-                         itemName.erase(0, 1); // Remove _
-                         size_t position = itemName.find(":");
-                         if (position != std::string::npos )
-                         {
-                             collectionName = itemName.substr(0, position);
-                             itemName       = itemName.erase(0, position+1);
-                         }
-                    }
-
-                    for(std::vector<Item *>::iterator it = info->items.begin(); it != info->items.end(); it++)
-                    {
-                        if ( (*it)->name == itemName && (*it)->collectionInfo->name == collectionName)
-                        {
-                            info->playlists[basename]->push_back((*it));
-                        }
-                    }
-                }
-
+                ImportPlaylist(info, basename, playlistFile);
             }
         }
     }
 
     closedir(dp);
 
+    // A crash before the first compaction leaves only the favorites journal.
+    if(info->playlists["favorites"] == NULL)
+    {
+        ImportPlaylist(info, "favorites", Utils::combinePath(path, "favorites.txt"));
+    }
+
     if(info->playlists["favorites"] == NULL)
     {
         info->playlists["favorites"] = new std::vector<Item *>();
@@ -452,6 +430,47 @@ void CollectionInfoBuilder::addPlaylists(CollectionInfo *info)
 }
 
 
+bool CollectionInfoBuilder::ImportPlaylist(CollectionInfo *info, std::string playlistName, std::string file)
+{
+    std::vector<std::string> entries;
+
+    // Replays any journal left next to the playlist, so favorites toggled
+    // just before a crash or power loss are not lost.
+    if(!PlaylistJournal::replay(file, entries))
+    {
+        return false;
+    }
+
+    info->playlists[playlistName] = new std::vector<Item *>();
+
+    for(std::vector<std::string>::iterator entry = entries.begin(); entry != entries.end(); entry++)
+    {
+        std::string collectionName = info->name;
+        std::string itemName       = *entry;
+        if (itemName.at(0) == '_') // name consists of _<collectionName>:<itemName>
+        {
+             itemName.erase(0, 1); // Remove _
+             size_t position = itemName.find(":");
+             if (position != std::string::npos )
+             {
+                 collectionName = itemName.substr(0, position);
+                 itemName       = itemName.erase(0, position+1);
+             }
+        }
+
+        for(std::vector<Item *>::iterator it = info->items.begin(); it != info->items.end(); it++)
+        {
+            if ( (*it)->name == itemName && (*it)->collectionInfo->name == collectionName)
+            {
+                info->playlists[playlistName]->push_back((*it));
+            }
+        }
+    }
+
+    return true;
+}
+
+
 void CollectionInfoBuilder::ImportRomDirectory(std::string path, CollectionInfo *info, std::map<std::string, Item *> includeFilter, std::map<std::string, Item *> excludeFilter, bool romHierarchy, bool truRIP)
 {
 
@@ -41,5 +41,6 @@ private:
     MetadataDatabase &metaDB_;
     bool ImportBasicList(CollectionInfo *info, std::string file, std::map<std::string, Item *> &list);
     bool ImportDirectory(CollectionInfo *info, std::string mergedCollectionName);
+    bool ImportPlaylist(CollectionInfo *info, std::string playlistName, std::string file);
     void ImportRomDirectory(std::string path, CollectionInfo *info, std::map<std::string, Item *> includeFilter, std::map<std::string, Item *> excludeFilter, bool romHierarchy, bool truRIP);
 };
@@ -0,0 +1,138 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "JumpIndex.h"
+#include "Item.h"
+#include <cctype>
+
+JumpIndex::JumpIndex()
+    : items_(NULL)
+    , size_(0)
+    , attribute_(LETTER)
+{
+}
+
+
+void JumpIndex::build(const std::vector<Item *> &items, Attribute attribute)
+{
+    clear();
+    items_     = &items;
+    size_      = items.size();
+    attribute_ = attribute;
+
+    if(items.empty())
+    {
+        return;
+    }
+
+    groupOf_.resize(items.size());
+
+    std::string previousKey = groupKey(items[0], attribute);
+    std::string key;
+    groupStart_.push_back(0);
+
+    for(unsigned int i = 0; i < items.size(); ++i)
+    {
+        key = groupKey(items[i], attribute);
+        if(key != previousKey)
+        {
+            groupStart_.push_back(i);
+            previousKey = key;
+        }
+        groupOf_[i] = groupStart_.size() - 1;
+    }
+
+    // the last group continues into the first one when the list wraps
+    if(groupStart_.size() > 1 && key == groupKey(items[0], attribute))
+    {
+        unsigned int last = groupStart_.size() - 2;
+        groupStart_.erase(groupStart_.begin());
+        for(unsigned int i = 0; i < groupOf_.size(); ++i)
+        {
+            groupOf_[i] = (groupOf_[i] == 0) ? last : groupOf_[i] - 1;
+        }
+    }
+}
+
+
+void JumpIndex::clear()
+{
+    items_ = NULL;
+    size_  = 0;
+    groupOf_.clear();
+    groupStart_.clear();
+}
+
+
+// True when the index still describes this list; items added or removed
+// since it was built make it stale.
+bool JumpIndex::isBuilt(const std::vector<Item *> *items, Attribute attribute) const
+{
+    return items_ == items && items && size_ == items->size() && attribute_ == attribute;
+}
+
+
+// First position of the group after the one holding position; position
+// itself when the whole list is one group.
+unsigned int JumpIndex::next(unsigned int position) const
+{
+    if(groupStart_.size() <= 1 || position >= groupOf_.size())
+    {
+        return position;
+    }
+    return groupStart_[(groupOf_[position] + 1) % groupStart_.size()];
+}
+
+
+// First position of the group before the one holding position.
+unsigned int JumpIndex::previous(unsigned int position) const
+{
+    if(groupStart_.size() <= 1 || position >= groupOf_.size())
+    {
+        return position;
+    }
+    unsigned int count = groupStart_.size();
+    return groupStart_[(groupOf_[position] + count - 1) % count];
+}
+
+
+unsigned int JumpIndex::groups() const
+{
+    return groupStart_.size();
+}
+
+
+// Letters group by their lowercase form; digits and symbols form one group.
+std::string JumpIndex::groupKey(Item *item, Attribute attribute)
+{
+    switch(attribute)
+    {
+        case YEAR:
+            return item->year;
+        case GENRE:
+            return item->genre;
+        case MANUFACTURER:
+            return item->manufacturer;
+        case LETTER:
+        default:
+            break;
+    }
+
+    if(item->fullTitle.empty() || !isalpha(static_cast<unsigned char>(item->fullTitle[0])))
+    {
+        return "";
+    }
+    return std::string(1, static_cast<char>(tolower(static_cast<unsigned char>(item->fullTitle[0]))));
+}
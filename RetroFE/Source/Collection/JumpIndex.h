@@ -0,0 +1,53 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+class Item;
+
+// Boundaries of the groups of neighbouring items that share a first letter
+// (or year, genre, manufacturer), so jumping to the next or previous group
+// is a table lookup instead of a walk over the list. Like the list itself,
+// groups wrap around: a group split over the end and the start is one group.
+class JumpIndex
+{
+public:
+    enum Attribute
+    {
+        LETTER,
+        YEAR,
+        GENRE,
+        MANUFACTURER
+    };
+
+    JumpIndex();
+    void build(const std::vector<Item *> &items, Attribute attribute = LETTER);
+    void clear();
+    bool isBuilt(const std::vector<Item *> *items, Attribute attribute) const;
+    unsigned int next(unsigned int position) const;
+    unsigned int previous(unsigned int position) const;
+    unsigned int groups() const;
+    static std::string groupKey(Item *item, Attribute attribute);
+
+private:
+    const std::vector<Item *> *items_;
+    size_t                     size_;
+    Attribute                  attribute_;
+    std::vector<unsigned int>  groupOf_;
+    std::vector<unsigned int>  groupStart_;
+};
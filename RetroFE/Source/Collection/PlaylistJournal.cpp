@@ -0,0 +1,420 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlaylistJournal.h"
+#include "../Utility/Log.h"
+#include "../Utility/Utils.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+
+PlaylistJournal::PlaylistJournal(std::string file, bool remountRootfs)
+    : file_(file)
+    , journalFile_(file + ".journal")
+    , compactingFile_(file + ".journal.compacting")
+    , remountRootfs_(remountRootfs)
+    , busy_(false)
+    , stop_(false)
+    , journalFd_(-1)
+{
+}
+
+PlaylistJournal::~PlaylistJournal()
+{
+    if(thread_.joinable())
+    {
+        wait();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wakeup_.notify_one();
+        thread_.join();
+    }
+
+    if(journalFd_ != -1)
+    {
+        close(journalFd_);
+    }
+}
+
+
+void PlaylistJournal::add(std::string entry)
+{
+    Operation op;
+    op.type  = '+';
+    op.entry = entry;
+    push(op);
+}
+
+
+void PlaylistJournal::remove(std::string entry)
+{
+    Operation op;
+    op.type  = '-';
+    op.entry = entry;
+    push(op);
+}
+
+
+// entries must be the full list with every add/remove queued so far applied.
+void PlaylistJournal::compact(const std::vector<std::string> &entries)
+{
+    Operation op;
+    op.type    = 'c';
+    op.entries = entries;
+    push(op);
+}
+
+
+// Blocks until everything queued so far is on storage.
+void PlaylistJournal::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return queue_.empty() && !busy_; });
+}
+
+
+bool PlaylistJournal::replay(std::string file, std::vector<std::string> &entries)
+{
+    std::ifstream playlist(file.c_str());
+    bool found = playlist.good();
+    std::string line;
+
+    while(std::getline(playlist, line))
+    {
+        line = Utils::filterComments(line);
+        line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
+        if(!line.empty() && std::find(entries.begin(), entries.end(), line) == entries.end())
+        {
+            entries.push_back(line);
+        }
+    }
+
+    // a compaction interrupted by a crash leaves its journal behind; its
+    // operations are idempotent, so replaying them over either version of
+    // the playlist gives the same list
+    found = replayJournal(file + ".journal.compacting", entries) || found;
+    found = replayJournal(file + ".journal", entries) || found;
+
+    return found;
+}
+
+
+void PlaylistJournal::push(Operation &op)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    queue_.push_back(Operation());
+    std::swap(queue_.back(), op);
+
+    if(!thread_.joinable())
+    {
+        thread_ = std::thread(&PlaylistJournal::worker, this);
+    }
+    wakeup_.notify_one();
+}
+
+
+void PlaylistJournal::worker()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(!stop_)
+    {
+        if(queue_.empty())
+        {
+            wakeup_.wait(lock);
+            continue;
+        }
+
+        // take the whole backlog so the rootfs is remounted once per batch
+        std::deque<Operation> batch;
+        batch.swap(queue_);
+        busy_ = true;
+        lock.unlock();
+
+        if(remountRootfs_)
+        {
+            Utils::rootfsWritable();
+        }
+
+        std::string dir = Utils::getDirectory(file_);
+        struct stat info;
+        if(stat(dir.c_str(), &info) != 0 && mkdir(dir.c_str(), 0755) == -1)
+        {
+            Logger::write(Logger::ZONE_WARNING, "Playlist", "Could not create directory " + dir);
+        }
+
+        for(std::deque<Operation>::iterator it = batch.begin(); it != batch.end(); ++it)
+        {
+            if(it->type == 'c')
+            {
+                writePlaylist(it->entries);
+            }
+            else
+            {
+                append(*it);
+            }
+        }
+
+        if(remountRootfs_)
+        {
+            Utils::rootfsReadOnly();
+        }
+
+        lock.lock();
+        busy_ = false;
+        if(queue_.empty())
+        {
+            idle_.notify_all();
+        }
+    }
+}
+
+
+bool PlaylistJournal::append(const Operation &op)
+{
+    if(journalFd_ == -1)
+    {
+        journalFd_ = open(journalFile_.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if(journalFd_ == -1)
+        {
+            Logger::write(Logger::ZONE_ERROR, "Playlist", "Could not open " + journalFile_ + ": " + std::strerror(errno));
+            return false;
+        }
+    }
+
+    // a line is only valid once its newline is written, so a torn record
+    // is dropped on replay
+    std::string line = std::string(1, op.type) + op.entry + "\n";
+    bool retVal = writeData(journalFd_, line);
+    checkpoint();
+    retVal = retVal && fdatasync(journalFd_) == 0;
+
+    if(!retVal)
+    {
+        Logger::write(Logger::ZONE_ERROR, "Playlist", "Could not write " + journalFile_ + ": " + std::strerror(errno));
+    }
+    return retVal;
+}
+
+
+bool PlaylistJournal::writePlaylist(const std::vector<std::string> &entries)
+{
+    // Keep the operations being folded in until the new playlist is in
+    // place; later ones go to a fresh journal
+    if(journalFd_ != -1)
+    {
+        close(journalFd_);
+        journalFd_ = -1;
+    }
+    retireJournal();
+    checkpoint();
+
+    std::string data;
+    for(std::vector<std::string>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        data += *it + "\n";
+    }
+
+    std::string tmpFile = file_ + ".tmp";
+    int fd = open(tmpFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd == -1)
+    {
+        Logger::write(Logger::ZONE_ERROR, "Playlist", "Could not open " + tmpFile + ": " + std::strerror(errno));
+        return false;
+    }
+
+    bool retVal = writeData(fd, data) && fsync(fd) == 0;
+    close(fd);
+    checkpoint();
+
+    if(!retVal || rename(tmpFile.c_str(), file_.c_str()) != 0)
+    {
+        Logger::write(Logger::ZONE_ERROR, "Playlist", "Could not save " + file_ + ": " + std::strerror(errno));
+        unlink(tmpFile.c_str());
+        return false;
+    }
+    syncDirectory();
+    checkpoint();
+
+    unlink(compactingFile_.c_str());
+
+    Logger::write(Logger::ZONE_INFO, "Playlist", "Saved " + file_);
+    return true;
+}
+
+
+// Moves the journal to the compacting file. A compaction interrupted by a
+// crash leaves a compacting file whose operations are not in the playlist
+// yet, so the journal is appended to it (through a temporary file) instead
+// of replacing it. If a crash keeps both, replaying the journal twice gives
+// the same list.
+bool PlaylistJournal::retireJournal()
+{
+    std::string leftover;
+    if(!readRecords(compactingFile_, leftover))
+    {
+        if(rename(journalFile_.c_str(), compactingFile_.c_str()) == 0)
+        {
+            syncDirectory();
+        }
+        return true;
+    }
+
+    std::string journal;
+    readRecords(journalFile_, journal);
+
+    std::string tmpFile = compactingFile_ + ".tmp";
+    int fd = open(tmpFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd == -1)
+    {
+        Logger::write(Logger::ZONE_ERROR, "Playlist", "Could not open " + tmpFile + ": " + std::strerror(errno));
+        return false;
+    }
+
+    bool retVal = writeData(fd, leftover + journal) && fsync(fd) == 0;
+    close(fd);
+    checkpoint();
+
+    if(!retVal || rename(tmpFile.c_str(), compactingFile_.c_str()) != 0)
+    {
+        Logger::write(Logger::ZONE_ERROR, "Playlist", "Could not save " + compactingFile_ + ": " + std::strerror(errno));
+        unlink(tmpFile.c_str());
+        return false;
+    }
+    syncDirectory();
+    checkpoint();
+
+    unlink(journalFile_.c_str());
+    return true;
+}
+
+
+// Writes data in full. Crash tests override it to tear the write.
+bool PlaylistJournal::writeData(int fd, const std::string &data)
+{
+    return writeAll(fd, data);
+}
+
+
+// Called after each step that must survive a crash; crash tests override it
+// to stop the process there.
+void PlaylistJournal::checkpoint()
+{
+}
+
+
+bool PlaylistJournal::writeAll(int fd, const std::string &data)
+{
+    std::size_t written = 0;
+
+    while(written < data.size())
+    {
+        ssize_t result = write(fd, data.data() + written, data.size() - written);
+        if(result < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        written += result;
+    }
+
+    return true;
+}
+
+
+void PlaylistJournal::syncDirectory()
+{
+    int fd = open(Utils::getDirectory(file_).c_str(), O_RDONLY);
+    if(fd != -1)
+    {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+
+void PlaylistJournal::apply(const std::string &line, std::vector<std::string> &entries)
+{
+    if(line.size() < 2)
+    {
+        return;
+    }
+
+    std::string entry = line.substr(1);
+    std::vector<std::string>::iterator it = std::find(entries.begin(), entries.end(), entry);
+
+    if(line[0] == '+' && it == entries.end())
+    {
+        entries.push_back(entry);
+    }
+    else if(line[0] == '-' && it != entries.end())
+    {
+        entries.erase(it);
+    }
+}
+
+
+// Reads the complete records of a journal, without a torn last line.
+bool PlaylistJournal::readRecords(std::string file, std::string &data)
+{
+    std::ifstream journal(file.c_str(), std::ios::binary);
+    if(!journal.good())
+    {
+        return false;
+    }
+
+    std::stringstream ss;
+    ss << journal.rdbuf();
+    data = ss.str();
+    data.erase(data.rfind('\n') + 1);
+
+    return true;
+}
+
+
+bool PlaylistJournal::replayJournal(std::string file, std::vector<std::string> &entries)
+{
+    std::string data;
+    if(!readRecords(file, data))
+    {
+        return false;
+    }
+
+    std::size_t start = 0;
+    std::size_t end;
+    while((end = data.find('\n', start)) != std::string::npos)
+    {
+        apply(data.substr(start, end - start), entries);
+        start = end + 1;
+    }
+
+    return true;
+}
+
@@ -0,0 +1,77 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Crash safe persistence of one playlist file. Every add/remove is appended
+// to "<file>.journal" and synced; compact() rewrites the whole playlist
+// through a temporary file and a rename. All file I/O runs on a background
+// thread, so callers never wait for the storage. replay() rebuilds the list
+// from the playlist and whatever journals a crash left behind. Crash tests
+// derive from it to tear writes and stop the process at checkpoint().
+class PlaylistJournal
+{
+public:
+    PlaylistJournal(std::string file, bool remountRootfs = true);
+    virtual ~PlaylistJournal();
+    void add(std::string entry);
+    void remove(std::string entry);
+    void compact(const std::vector<std::string> &entries);
+    void wait();
+    static bool replay(std::string file, std::vector<std::string> &entries);
+
+protected:
+    virtual bool writeData(int fd, const std::string &data);
+    virtual void checkpoint();
+    bool writeAll(int fd, const std::string &data);
+
+private:
+    struct Operation
+    {
+        char                     type;
+        std::string              entry;
+        std::vector<std::string> entries;
+    };
+
+    void push(Operation &op);
+    void worker();
+    bool append(const Operation &op);
+    bool writePlaylist(const std::vector<std::string> &entries);
+    bool retireJournal();
+    void syncDirectory();
+    static void apply(const std::string &line, std::vector<std::string> &entries);
+    static bool readRecords(std::string file, std::string &data);
+    static bool replayJournal(std::string file, std::vector<std::string> &entries);
+
+    std::string           file_;
+    std::string           journalFile_;
+    std::string           compactingFile_;
+    bool                  remountRootfs_;
+    std::deque<Operation> queue_;
+    std::mutex            mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable idle_;
+    std::thread           thread_;
+    bool                  busy_;
+    bool                  stop_;
+    int                   journalFd_;
+};
@@ -0,0 +1,224 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "InputScript.h"
+#include "../Utility/Log.h"
+#include <fstream>
+#include <sstream>
+
+const int InputScript::KEY_COUNT;
+
+// In UserInput::KeyCode_E order, KeyCodeNull first
+const char *InputScript::keyNames_[KEY_COUNT] =
+{
+    "null",
+    "up",
+    "down",
+    "left",
+    "right",
+    "select",
+    "back",
+    "pageDown",
+    "pageUp",
+    "letterDown",
+    "letterUp",
+    "favPlaylist",
+    "nextPlaylist",
+    "prevPlaylist",
+    "random",
+    "menu",
+    "addPlaylist",
+    "removePlaylist",
+    "adminMode",
+    "hideItem",
+    "quit"
+};
+
+
+InputScript::InputScript()
+    : next_(0)
+    , hasEnd_(false)
+    , endFrame_(0)
+    , out_(NULL)
+{
+}
+
+
+InputScript::~InputScript()
+{
+    if(out_)
+    {
+        fclose(out_);
+    }
+}
+
+
+bool InputScript::load(const std::string &file)
+{
+    std::ifstream in(file.c_str());
+
+    if(!in.good())
+    {
+        Logger::write(Logger::ZONE_ERROR, "Input", "Could not open input script " + file);
+        return false;
+    }
+    if(!parse(in))
+    {
+        Logger::write(Logger::ZONE_ERROR, "Input", "Invalid input script " + file);
+        return false;
+    }
+    return true;
+}
+
+
+bool InputScript::parse(std::istream &in)
+{
+    std::string line;
+    int lineNumber = 0;
+
+    events_.clear();
+    next_   = 0;
+    hasEnd_ = false;
+
+    while(std::getline(in, line))
+    {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if(comment != std::string::npos)
+        {
+            line.erase(comment);
+        }
+
+        if(line.find_first_not_of(" \t\r") == std::string::npos)
+        {
+            continue;
+        }
+
+        std::stringstream ss(line);
+        long long frame = -1;
+        std::string key;
+        std::string state;
+        if(!(ss >> frame >> key))
+        {
+            frame = -1;
+        }
+        if(frame >= 0 && key == "end")
+        {
+            hasEnd_   = true;
+            endFrame_ = static_cast<unsigned int>(frame);
+            continue;
+        }
+
+        ss >> state;
+        Event e;
+        e.key = keyCode(key);
+        e.pressed = (state == "down");
+        if(frame < 0 || e.key < 0 || (state != "down" && state != "up") ||
+           (!events_.empty() && static_cast<unsigned int>(frame) < events_.back().frame))
+        {
+            std::stringstream error;
+            error << "Input script line " << lineNumber << " is invalid: " << line;
+            Logger::write(Logger::ZONE_WARNING, "Input", error.str());
+            return false;
+        }
+        e.frame = static_cast<unsigned int>(frame);
+        events_.push_back(e);
+    }
+
+    return true;
+}
+
+
+void InputScript::take(unsigned int frame, std::vector<Event> &events)
+{
+    while(next_ < events_.size() && events_[next_].frame <= frame)
+    {
+        events.push_back(events_[next_++]);
+    }
+}
+
+
+bool InputScript::isFinished(unsigned int frame) const
+{
+    return hasEnd_ && frame >= endFrame_;
+}
+
+
+const std::vector<InputScript::Event> &InputScript::getEvents() const
+{
+    return events_;
+}
+
+
+bool InputScript::record(const std::string &file)
+{
+    if(out_)
+    {
+        fclose(out_);
+    }
+    out_ = fopen(file.c_str(), "w");
+    if(!out_)
+    {
+        Logger::write(Logger::ZONE_ERROR, "Input", "Could not create input script " + file);
+        return false;
+    }
+    fprintf(out_, "# frame key state\n");
+    return true;
+}
+
+
+void InputScript::write(unsigned int frame, int key, bool pressed)
+{
+    if(out_)
+    {
+        fprintf(out_, "%u %s %s\n", frame, keyName(key), pressed ? "down" : "up");
+    }
+}
+
+
+void InputScript::close(unsigned int frame)
+{
+    if(out_)
+    {
+        fprintf(out_, "%u end\n", frame);
+        fclose(out_);
+        out_ = NULL;
+    }
+}
+
+
+bool InputScript::isRecording() const
+{
+    return out_ != NULL;
+}
+
+
+const char *InputScript::keyName(int key)
+{
+    return (key >= 0 && key < KEY_COUNT) ? keyNames_[key] : "null";
+}
+
+
+int InputScript::keyCode(const std::string &name)
+{
+    for(int i = 1; i < KEY_COUNT; ++i)
+    {
+        if(name == keyNames_[i])
+        {
+            return i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,73 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdio>
+#include <istream>
+#include <string>
+#include <vector>
+
+// Text journal of key presses and releases, keyed by frame number, used to
+// record a session and to replay it deterministically. One event per line:
+//
+//     # frame key state
+//     0 right down
+//     300 right up
+//     360 end
+//
+// Keys are numbered as UserInput::KeyCode_E and named as in controls.conf.
+// The optional "end" line marks the frame at which a replay is finished.
+class InputScript
+{
+public:
+    struct Event
+    {
+        unsigned int frame;
+        int key;
+        bool pressed;
+    };
+
+    static const int KEY_COUNT = 21;
+
+    InputScript();
+    ~InputScript();
+
+    bool load(const std::string &file);
+    bool parse(std::istream &in);
+    // Appends the events due at or before frame, in script order.
+    void take(unsigned int frame, std::vector<Event> &events);
+    bool isFinished(unsigned int frame) const;
+    const std::vector<Event> &getEvents() const;
+
+    bool record(const std::string &file);
+    void write(unsigned int frame, int key, bool pressed);
+    void close(unsigned int frame);
+    bool isRecording() const;
+
+    static const char *keyName(int key);
+    static int keyCode(const std::string &name);
+
+private:
+    InputScript(const InputScript &);
+    InputScript &operator=(const InputScript &);
+
+    static const char *keyNames_[KEY_COUNT];
+    std::vector<Event> events_;
+    size_t             next_;
+    bool               hasEnd_;
+    unsigned int       endFrame_;
+    FILE              *out_;
+};
@@ -116,13 +116,18 @@ const key_names_s key_names[] = {
 };
 
 
+static_assert(InputScript::KEY_COUNT == UserInput::KeyCodeMax, "InputScript key names must match KeyCode_E");
+
 UserInput::UserInput(Configuration &c)
     : config_(c)
+    , replaying_(false)
+    , frame_(0)
 {
     for(unsigned int i = 0; i < KeyCodeMax; ++i)
     {
         currentKeyState_[i] = false;
         lastKeyState_[i] = false;
+        recordedKeyState_[i] = false;
     }
     /*for ( unsigned int i = 0; i < cMaxJoy; i++ )
     {
@@ -377,6 +382,16 @@ void UserInput::resetStates()
         }
         currentKeyState_[keyHandlers_[i].second] = false;
     }
+
+    // a replay resets the same way, so the reset itself is not recorded
+    for (unsigned int i = 0; i < KeyCodeMax; ++i)
+    {
+        if (replaying_)
+        {
+            currentKeyState_[i] = false;
+        }
+        recordedKeyState_[i] = false;
+    }
 }
 
 
@@ -384,6 +399,12 @@ bool UserInput::update( SDL_Event &e )
 {
     bool updated = false;
 
+    // live input is ignored while a script drives the keys
+    if ( replaying_ )
+    {
+        return false;
+    }
+
     memcpy( lastKeyState_, currentKeyState_, sizeof( lastKeyState_ ) );
     memset( currentKeyState_, 0, sizeof( currentKeyState_ ) );
 
@@ -445,10 +466,79 @@ bool UserInput::update( SDL_Event &e )
         }
     }
 
+    if ( script_.isRecording( ) )
+    {
+        for ( unsigned int i = 0; i < KeyCodeMax; ++i )
+        {
+            if ( currentKeyState_[i] != recordedKeyState_[i] )
+            {
+                script_.write( frame_, i, currentKeyState_[i] );
+                recordedKeyState_[i] = currentKeyState_[i];
+            }
+        }
+    }
+
     return updated;
 }
 
 
+bool UserInput::record(std::string file)
+{
+    replaying_ = false;
+    memcpy( recordedKeyState_, currentKeyState_, sizeof( recordedKeyState_ ) );
+    return script_.record( file );
+}
+
+
+bool UserInput::replay(std::string file)
+{
+    replaying_ = script_.load( file );
+    if ( replaying_ )
+    {
+        memset( currentKeyState_, 0, sizeof( currentKeyState_ ) );
+        memset( lastKeyState_, 0, sizeof( lastKeyState_ ) );
+    }
+    return replaying_;
+}
+
+
+// Called once per main loop iteration. Replayed events are applied one at a
+// time, like live events in update(), so newKeyPressed() behaves the same.
+void UserInput::setFrame(unsigned int frame)
+{
+    frame_ = frame;
+
+    if ( replaying_ )
+    {
+        std::vector<InputScript::Event> events;
+        script_.take( frame, events );
+        for ( unsigned int i = 0; i < events.size( ); ++i )
+        {
+            memcpy( lastKeyState_, currentKeyState_, sizeof( lastKeyState_ ) );
+            currentKeyState_[events[i].key] = events[i].pressed;
+        }
+    }
+}
+
+
+void UserInput::stopRecording()
+{
+    script_.close( frame_ );
+}
+
+
+bool UserInput::isReplaying()
+{
+    return replaying_;
+}
+
+
+bool UserInput::isReplayFinished()
+{
+    return replaying_ && script_.isFinished( frame_ );
+}
+
+
 bool UserInput::keystate(KeyCode_E code)
 {
     return currentKeyState_[code];
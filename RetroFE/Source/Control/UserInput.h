@@ -16,6 +16,7 @@
 #pragma once
 #include <SDL/SDL.h>
 //#include <SDL/SDL_joystick.h>
+#include "InputScript.h"
 #include <map>
 #include <string>
 #include <vector>
@@ -68,6 +69,12 @@ public:
     bool keystate(KeyCode_E);
     bool newKeyPressed(KeyCode_E code);
     void clearJoysticks( );
+    bool record(std::string file);
+    bool replay(std::string file);
+    void setFrame(unsigned int frame);
+    void stopRecording();
+    bool isReplaying();
+    bool isReplayFinished();
 
 private:
     SDLKey SDL_GetScancodeFromName(const char *name);
@@ -79,4 +86,8 @@ private:
     std::vector<std::pair<InputHandler *, KeyCode_E> > keyHandlers_;
     bool lastKeyState_[KeyCodeMax]; 
     bool currentKeyState_[KeyCodeMax]; 
+    bool recordedKeyState_[KeyCodeMax];
+    InputScript script_;
+    bool replaying_;
+    unsigned int frame_;
 };
@@ -347,6 +347,32 @@ bool Configuration::exportCurrentLayout(std::string layoutFilePath, std::string
 }
 
 
+// Select an entry of layouts_ as the active layout, as importCurrentLayout
+// does at startup.
+bool Configuration::setCurrentLayout(int index)
+{
+    if(index < 0 || index >= static_cast<int>(layouts_.size()))
+    {
+        return false;
+    }
+
+    std::string layoutName = Utils::getFileName(layouts_[index].first);
+    bool userLayout = layouts_[index].second;
+
+    properties_.erase("layout");
+    properties_.erase("userTheme");
+    properties_.insert(PropertiesPair("layout", layoutName));
+    properties_.insert(PropertiesPair("userTheme", userLayout?"yes":"no"));
+
+    Configuration::isUserLayout_ = userLayout;
+    currentLayoutIdx_ = index;
+
+    Logger::write(Logger::ZONE_INFO, "Configuration", "Current layout set to \"" + layoutName + "\"");
+
+    return true;
+}
+
+
 bool Configuration::parseLine(std::string collection, std::string keyPrefix, std::string line, int lineCount)
 {
     bool retVal = false;
@@ -33,6 +33,7 @@ public:
     bool importLayouts(std::string folder, std::string file, bool userLayout=false, bool mustExist = true);
     bool importCurrentLayout(std::string folder, std::string file, bool mustExist = true);
     bool exportCurrentLayout(std::string layoutFilePath, std::string layoutName);
+    bool setCurrentLayout(int index);
     bool getProperty(std::string key, std::string &value);
     bool getProperty(std::string key, int &value);
     bool getProperty(std::string key, bool &value);
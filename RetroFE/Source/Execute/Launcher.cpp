@@ -15,6 +15,7 @@
  */
 
 #include "Launcher.h"
+#include "Process.h"
 #include "../Collection/Item.h"
 #include "../Utility/Log.h"
 #include "../Database/Configuration.h"
@@ -24,6 +25,7 @@
 #include <cstdlib>
 #include <sys/types.h>
 #include <unistd.h>
+#include <chrono>
 #include <locale>
 #include <sstream>
 #include <fstream>
@@ -32,11 +34,24 @@
 #include <cstring>
 #endif
 
+// how long game start waits for the pre-launch hooks
+static const int HOOK_TIMEOUT_MS = 2000;
+
+static float elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
 Launcher::Launcher(Configuration &c)
     : config_(c)
 {
 }
 
+Launcher::~Launcher()
+{
+    Process::waitAll(pendingHooks_, HOOK_TIMEOUT_MS);
+}
+
 bool Launcher::run(std::string collection, Item *collectionItem)
 {
     std::string launcherName = collectionItem->collectionInfo->launcher;
@@ -47,7 +62,9 @@ bool Launcher::run(std::string collection, Item *collectionItem)
     std::string matchedExtension;
     std::string args;
     bool res = true;
-    FILE *fp;
+
+    // post-exit hooks of the previous launch run in the background
+    Process::reap(pendingHooks_);
 
     std::string launcherFile = Utils::combinePath( Configuration::absolutePath, "collections", collectionItem->collectionInfo->name, "launchers", collectionItem->name + ".conf" );
     std::ifstream launcherStream( launcherFile.c_str( ) );
@@ -94,12 +111,18 @@ bool Launcher::run(std::string collection, Item *collectionItem)
     else
         findFile(selectedItemsPath, matchedExtension, selectedItemsDirectory, collectionItem->file, extensionstr);
 
-    args = replaceVariables(args,
-                            selectedItemsPath,
-                            collectionItem->name,
-                            Utils::getFileName(selectedItemsPath),
-                            selectedItemsDirectory,
-                            collection);
+    // split before substituting so nothing in a rom name can break an
+    // argument apart
+    Process::Args argv = Process::splitArguments(args);
+    for(unsigned int i = 0; i < argv.size(); i++)
+    {
+        argv[i] = replaceVariables(argv[i],
+                                   selectedItemsPath,
+                                   collectionItem->name,
+                                   Utils::getFileName(selectedItemsPath),
+                                   selectedItemsDirectory,
+                                   collection);
+    }
 
     executablePath = replaceVariables(executablePath,
                                       selectedItemsPath,
@@ -120,35 +143,50 @@ bool Launcher::run(std::string collection, Item *collectionItem)
                                         selectedItemsDirectory,
                                         collection);
 
-    /* Initialize keymap rom command */
-    std::string cmd = SHELL_CMD_MAPPING_ROM;
-    cmd += " '" + selectedItemsPath + "'";
+    std::chrono::steady_clock::time_point phaseStart = std::chrono::steady_clock::now();
+    std::stringstream ss;
+
+    /* Pre-launch hooks: keymap for this rom and audio amp, run concurrently */
     Logger::write(Logger::ZONE_INFO, "Launcher", "Applying keymap rom: \"" + selectedItemsPath + "\"");
-    printf("Applying keymap rom cmd: \"%s\"\n", cmd.c_str());
-    system(cmd.c_str());
+    Process::Args keymapRom = Process::splitArguments(SHELL_CMD_MAPPING_ROM);
+    keymapRom.push_back(selectedItemsPath);
+
+    std::vector<pid_t> hooks;
+    startHook(hooks, keymapRom);
+    startHook(hooks, Process::splitArguments(SHELL_CMD_AUDIO_AMP_ON));
+    if(!Process::waitAll(hooks, HOOK_TIMEOUT_MS))
+    {
+        Logger::write(Logger::ZONE_WARNING, "Launcher", "Pre-launch hooks still running, launching anyway");
+        pendingHooks_.insert(pendingHooks_.end(), hooks.begin(), hooks.end());
+    }
 
-    /* Restart audio amp */
-    system(SHELL_CMD_AUDIO_AMP_ON);
+    ss << "Pre-launch hooks took " << elapsedMs(phaseStart) << " ms";
+    Logger::write(Logger::ZONE_INFO, "Launcher", ss.str());
 
     /* Execute game */
-    if(!execute(executablePath, args, currentDirectory))
+    phaseStart = std::chrono::steady_clock::now();
+    if(!execute(executablePath, argv, currentDirectory))
     {
         Logger::write(Logger::ZONE_ERROR, "Launcher", "Failed to launch.");
         res = false;
     }
 
-    /* Stop audio amp */
-    system(SHELL_CMD_AUDIO_AMP_OFF);
+    ss.str("");
+    ss << "Game ran for " << elapsedMs(phaseStart) << " ms";
+    Logger::write(Logger::ZONE_INFO, "Launcher", ss.str());
 
-    /* Restore default keymap */
+    /* Post-exit hooks: stop audio amp, restore default keymap and record our
+       pid again. Nothing waits on them, they finish while the UI comes back */
+    phaseStart = std::chrono::steady_clock::now();
     Logger::write(Logger::ZONE_INFO, "Launcher", "Applying keymap default");
-    printf("Applying keymap default cmd: \"%s\"\n", SHELL_CMD_MAPPING_DEFAULT);
-    system(SHELL_CMD_MAPPING_DEFAULT);
+    startHook(pendingHooks_, Process::splitArguments(SHELL_CMD_AUDIO_AMP_OFF));
+    startHook(pendingHooks_, Process::splitArguments(SHELL_CMD_MAPPING_DEFAULT));
 
-    /* Restore retrofe PID */
-    char shellCmd[20];
-    sprintf(shellCmd, "%s %d", SHELL_CMD_PID_RECORD, getpid());
-    Utils::executeRawPath((const char*)shellCmd);
+    Process::Args pidRecord = Process::splitArguments(SHELL_CMD_PID_RECORD);
+    std::stringstream pid;
+    pid << getpid();
+    pidRecord.push_back(pid.str());
+    startHook(pendingHooks_, pidRecord);
 
     /* Clean VT */
     int current_VT = Utils::getVTid();
@@ -162,9 +200,27 @@ bool Launcher::run(std::string collection, Item *collectionItem)
         }
     }
 
+    ss.str("");
+    ss << "Post-exit hooks started in " << elapsedMs(phaseStart) << " ms";
+    Logger::write(Logger::ZONE_INFO, "Launcher", ss.str());
+
     return res;
 }
 
+void Launcher::startHook(std::vector<pid_t> &pids, const Process::Args &argv)
+{
+    pid_t pid = Process::spawn(argv);
+
+    if(pid > 0)
+    {
+        pids.push_back(pid);
+    }
+    else
+    {
+        Logger::write(Logger::ZONE_ERROR, "Launcher", "Failed to run hook: " + argv.front());
+    }
+}
+
 std::string Launcher::replaceVariables(std::string str,
                                        std::string itemFilePath,
                                        std::string itemName,
@@ -187,10 +243,14 @@ std::string Launcher::replaceVariables(std::string str,
     return str;
 }
 
-bool Launcher::execute(std::string executable, std::string args, std::string currentDirectory)
+bool Launcher::execute(std::string executable, const Process::Args &args, std::string currentDirectory)
 {
     bool retVal = false;
-    std::string executionString = "\"" + executable + "\" " + args;
+    std::string executionString = "\"" + executable + "\"";
+    for(unsigned int i = 0; i < args.size(); i++)
+    {
+        executionString += " \"" + args[i] + "\"";
+    }
 
     Logger::write(Logger::ZONE_INFO, "Launcher", "Attempting to launch: " + executionString);
     Logger::write(Logger::ZONE_INFO, "Launcher", "     from within folder: " + currentDirectory);
@@ -213,13 +273,18 @@ bool Launcher::execute(std::string executable, std::string args, std::string cur
 
     if(!CreateProcess(NULL, applicationName, NULL, NULL, FALSE, CREATE_NO_WINDOW, NULL, currDir, &startupInfo, &processInfo))
 #else
+    // run the program from inside its folder, as "./name" when it is given
+    // with a path
+    Process::Args argv(1, executable);
     const std::size_t last_slash_idx = executable.rfind(Utils::pathSeparator);
     if (last_slash_idx != std::string::npos)
     {
-        std::string applicationName = executable.substr(last_slash_idx + 1);
-        executionString = "cd \"" + currentDirectory + "\" && exec \"./" + applicationName + "\" " + args;
+        argv[0] = "./" + executable.substr(last_slash_idx + 1);
     }
-    if(system(executionString.c_str()) != 0)
+    argv.insert(argv.end(), args.begin(), args.end());
+
+    int exitCode = Process::run(argv, currentDirectory);
+    if(exitCode != 0)
 #endif
     {
         Logger::write(Logger::ZONE_ERROR, "Launcher", "Failed to run: " + executable);
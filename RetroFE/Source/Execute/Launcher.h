@@ -15,7 +15,9 @@
  */
 #pragma once
 
+#include "Process.h"
 #include <string>
+#include <vector>
 
 class Configuration;
 class Item;
@@ -25,6 +27,7 @@ class Launcher
 {
 public:
     Launcher(Configuration &c);
+    ~Launcher();
     bool run(std::string collection, Item *collectionItem);
 
 private:
@@ -38,7 +41,8 @@ private:
     bool launcherArgs(std::string &args, std::string launcherName);
     bool extensions(std::string &extensions, std::string launcherName);
     bool collectionDirectory(std::string &directory, std::string collection);
-    bool execute(std::string executable, std::string arguments, std::string currentDirectory);
+    bool execute(std::string executable, const Process::Args &arguments, std::string currentDirectory);
+    void startHook(std::vector<pid_t> &pids, const Process::Args &argv);
     bool findFile(std::string &foundFilePath, std::string &foundFilename, std::string directory, std::string filenameWithoutExtension, std::string extensions);
     std::string replaceVariables(std::string str,
                                  std::string itemFilePath,
@@ -47,5 +51,6 @@ private:
                                  std::string itemDirectory,
                                  std::string itemCollectionName);
 
-    Configuration &config_;
+    Configuration     &config_;
+    std::vector<pid_t> pendingHooks_;
 };
@@ -0,0 +1,350 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Process.h"
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+extern char **environ;
+
+const int Process::FAILED;
+const int Process::TIMEOUT;
+
+static int exitStatus(int status)
+{
+    if(WIFEXITED(status))
+    {
+        return WEXITSTATUS(status);
+    }
+    if(WIFSIGNALED(status))
+    {
+        return 128 + WTERMSIG(status);
+    }
+    return Process::FAILED;
+}
+
+// Sleeps for the polling interval and doubles it, up to 10 ms, so short
+// lived helpers are noticed quickly without spinning on long ones.
+static void backOff(long &intervalUs)
+{
+    struct timespec ts;
+    ts.tv_sec  = 0;
+    ts.tv_nsec = intervalUs * 1000;
+    nanosleep(&ts, NULL);
+
+    if(intervalUs < 10000)
+    {
+        intervalUs *= 2;
+    }
+}
+
+// Returns the pid of the started program, or -1 if it could not be executed.
+pid_t Process::spawn(const Args &argv, const std::string &currentDirectory)
+{
+    return spawn(argv, currentDirectory, -1);
+}
+
+// As above; when outputFd is not -1 it becomes the program's stdout.
+pid_t Process::spawn(const Args &argv, const std::string &currentDirectory, int outputFd)
+{
+    if(argv.empty())
+    {
+        return -1;
+    }
+
+    // build the argument array before forking, the child may only use
+    // async-signal-safe calls
+    std::vector<char *> args;
+    for(unsigned int i = 0; i < argv.size(); i++)
+    {
+        args.push_back(const_cast<char *>(argv[i].c_str()));
+    }
+    args.push_back(NULL);
+
+    pid_t pid = -1;
+
+    // posix_spawn is the cheap path (vfork semantics) but cannot change the
+    // working directory, so fall back to fork when one is requested
+    if(currentDirectory.empty())
+    {
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        if(outputFd >= 0)
+        {
+            posix_spawn_file_actions_adddup2(&actions, outputFd, STDOUT_FILENO);
+        }
+
+        int result = posix_spawnp(&pid, args[0], &actions, NULL, &args[0], environ);
+        posix_spawn_file_actions_destroy(&actions);
+
+        return (result == 0) ? pid : -1;
+    }
+
+    // the child reports a failed chdir or exec through this pipe; it is closed
+    // on a successful exec, so the parent reads nothing
+    int status[2];
+    if(pipe(status) != 0)
+    {
+        return -1;
+    }
+    fcntl(status[1], F_SETFD, FD_CLOEXEC);
+
+    pid = fork();
+    if(pid == 0)
+    {
+        close(status[0]);
+        if(outputFd >= 0)
+        {
+            dup2(outputFd, STDOUT_FILENO);
+        }
+        if(chdir(currentDirectory.c_str()) == 0)
+        {
+            execvp(args[0], &args[0]);
+        }
+        int error = errno;
+        ssize_t written = write(status[1], &error, sizeof(error));
+        (void)written;
+        _exit(127);
+    }
+
+    close(status[1]);
+
+    if(pid > 0)
+    {
+        int error = 0;
+        ssize_t bytes;
+        do
+        {
+            bytes = read(status[0], &error, sizeof(error));
+        } while(bytes < 0 && errno == EINTR);
+
+        if(bytes > 0)
+        {
+            waitpid(pid, NULL, 0);
+            pid = -1;
+        }
+    }
+
+    close(status[0]);
+
+    return pid;
+}
+
+// Waits for pid to exit and returns its exit code (128 + signal if it was
+// killed), FAILED, or TIMEOUT if it is still running after timeoutMs
+// (negative waits forever).
+int Process::wait(pid_t pid, int timeoutMs)
+{
+    if(pid <= 0)
+    {
+        return FAILED;
+    }
+
+    int status = 0;
+
+    if(timeoutMs < 0)
+    {
+        while(waitpid(pid, &status, 0) < 0)
+        {
+            if(errno != EINTR)
+            {
+                return FAILED;
+            }
+        }
+        return exitStatus(status);
+    }
+
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    long intervalUs = 500;
+
+    while(true)
+    {
+        pid_t result = waitpid(pid, &status, WNOHANG);
+
+        if(result == pid)
+        {
+            return exitStatus(status);
+        }
+        if(result < 0 && errno != EINTR)
+        {
+            return FAILED;
+        }
+        if(std::chrono::steady_clock::now() >= deadline)
+        {
+            return TIMEOUT;
+        }
+
+        backOff(intervalUs);
+    }
+}
+
+int Process::run(const Args &argv, const std::string &currentDirectory)
+{
+    return wait(spawn(argv, currentDirectory));
+}
+
+// Runs a program to completion and collects what it writes to stdout.
+int Process::capture(const Args &argv, std::string &output)
+{
+    int out[2];
+    if(pipe(out) != 0)
+    {
+        return FAILED;
+    }
+    fcntl(out[0], F_SETFD, FD_CLOEXEC);
+
+    pid_t pid = spawn(argv, "", out[1]);
+    close(out[1]);
+
+    output.clear();
+    if(pid > 0)
+    {
+        char buffer[256];
+        ssize_t bytes;
+        while((bytes = read(out[0], buffer, sizeof(buffer))) != 0)
+        {
+            if(bytes > 0)
+            {
+                output.append(buffer, bytes);
+            }
+            else if(errno != EINTR)
+            {
+                break;
+            }
+        }
+    }
+    close(out[0]);
+
+    return wait(pid);
+}
+
+// Waits for every pid in the list, polling with a growing interval. Reaped
+// pids are removed; returns false if some are still running at the timeout.
+bool Process::waitAll(std::vector<pid_t> &pids, int timeoutMs)
+{
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    long intervalUs = 500;
+
+    while(true)
+    {
+        reap(pids);
+
+        if(pids.empty())
+        {
+            return true;
+        }
+        if(std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+
+        backOff(intervalUs);
+    }
+}
+
+// Collects the pids that have exited without blocking.
+void Process::reap(std::vector<pid_t> &pids)
+{
+    for(std::vector<pid_t>::iterator it = pids.begin(); it != pids.end();)
+    {
+        pid_t result = waitpid(*it, NULL, WNOHANG);
+
+        if(result == 0 || (result < 0 && errno == EINTR))
+        {
+            ++it;
+        }
+        else
+        {
+            it = pids.erase(it);
+        }
+    }
+}
+
+// Splits a configured argument string into words the way a shell would for
+// plain text: whitespace separates, "..." and '...' group, and a backslash
+// escapes the next character (inside double quotes only before " and \).
+// Nothing else is expanded.
+Process::Args Process::splitArguments(const std::string &args)
+{
+    Args words;
+    std::string word;
+    bool inWord = false;
+    char quote  = 0;
+
+    for(unsigned int i = 0; i < args.size(); i++)
+    {
+        char c = args[i];
+
+        if(quote == '\'')
+        {
+            if(c == '\'') quote = 0;
+            else word += c;
+        }
+        else if(quote == '"')
+        {
+            if(c == '"')
+            {
+                quote = 0;
+            }
+            else if(c == '\\' && i + 1 < args.size() && (args[i + 1] == '"' || args[i + 1] == '\\'))
+            {
+                word += args[++i];
+            }
+            else
+            {
+                word += c;
+            }
+        }
+        else if(c == ' ' || c == '\t' || c == '\n' || c == '\r')
+        {
+            if(inWord)
+            {
+                words.push_back(word);
+                word.clear();
+                inWord = false;
+            }
+        }
+        else
+        {
+            inWord = true;
+
+            if(c == '"' || c == '\'')
+            {
+                quote = c;
+            }
+            else if(c == '\\' && i + 1 < args.size())
+            {
+                word += args[++i];
+            }
+            else
+            {
+                word += c;
+            }
+        }
+    }
+
+    if(inWord)
+    {
+        words.push_back(word);
+    }
+
+    return words;
+}
@@ -0,0 +1,43 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+// Starts helper programs and games directly from an argv vector instead of
+// handing a command line to /bin/sh, so nothing in an argument (quotes,
+// spaces, '$' in a ROM name) is ever interpreted by a shell.
+class Process
+{
+public:
+    typedef std::vector<std::string> Args;
+
+    static const int FAILED  = -1;
+    static const int TIMEOUT = -2;
+
+    static pid_t spawn(const Args &argv, const std::string &currentDirectory = "");
+    static int wait(pid_t pid, int timeoutMs = -1);
+    static int run(const Args &argv, const std::string &currentDirectory = "");
+    static int capture(const Args &argv, std::string &output);
+    static bool waitAll(std::vector<pid_t> &pids, int timeoutMs);
+    static void reap(std::vector<pid_t> &pids);
+    static Args splitArguments(const std::string &args);
+
+private:
+    static pid_t spawn(const Args &argv, const std::string &currentDirectory, int outputFd);
+};
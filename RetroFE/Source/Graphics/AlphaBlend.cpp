@@ -0,0 +1,236 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "AlphaBlend.h"
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ALPHABLEND_NEON
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ALPHABLEND_SSE2
+#endif
+
+// x / 255 rounded to nearest, exact for x <= 255 * 255
+static inline uint32_t div255(uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+
+static inline uint32_t swapRedBlue(uint32_t pixel)
+{
+    return (pixel & 0xff00ff00) | ((pixel >> 16) & 0xff) | ((pixel & 0xff) << 16);
+}
+
+
+void AlphaBlend::blend(const uint32_t *src, int srcPitch, uint32_t *dst, int dstPitch,
+                       int width, int height, uint8_t alpha, bool srcHasAlpha, bool swapRedBlue)
+{
+    if(alpha == 0 || width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    for(int y = 0; y < height; ++y)
+    {
+        const uint32_t *srcRow = reinterpret_cast<const uint32_t *>(reinterpret_cast<const uint8_t *>(src) + y * srcPitch);
+        uint32_t *dstRow       = reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(dst) + y * dstPitch);
+
+        // an opaque source at full alpha simply replaces the destination
+        if(alpha == 255 && !srcHasAlpha)
+        {
+            copyRow(srcRow, dstRow, width, swapRedBlue);
+            continue;
+        }
+
+        int done = blendRowVector(srcRow, dstRow, width, alpha, srcHasAlpha, swapRedBlue);
+        blendRowScalar(srcRow + done, dstRow + done, width - done, alpha, srcHasAlpha, swapRedBlue);
+    }
+}
+
+
+void AlphaBlend::blendScalar(const uint32_t *src, int srcPitch, uint32_t *dst, int dstPitch,
+                             int width, int height, uint8_t alpha, bool srcHasAlpha, bool swapRedBlue)
+{
+    if(alpha == 0 || width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    for(int y = 0; y < height; ++y)
+    {
+        const uint32_t *srcRow = reinterpret_cast<const uint32_t *>(reinterpret_cast<const uint8_t *>(src) + y * srcPitch);
+        uint32_t *dstRow       = reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(dst) + y * dstPitch);
+        blendRowScalar(srcRow, dstRow, width, alpha, srcHasAlpha, swapRedBlue);
+    }
+}
+
+
+void AlphaBlend::copyRow(const uint32_t *src, uint32_t *dst, int width, bool swap)
+{
+    if(!swap)
+    {
+        for(int x = 0; x < width; ++x)
+        {
+            dst[x] = (dst[x] & 0xff000000) | (src[x] & 0x00ffffff);
+        }
+        return;
+    }
+
+    for(int x = 0; x < width; ++x)
+    {
+        dst[x] = (dst[x] & 0xff000000) | (swapRedBlue(src[x]) & 0x00ffffff);
+    }
+}
+
+
+void AlphaBlend::blendRowScalar(const uint32_t *src, uint32_t *dst, int width, uint8_t alpha, bool srcHasAlpha, bool swap)
+{
+    for(int x = 0; x < width; ++x)
+    {
+        uint32_t s = swap ? swapRedBlue(src[x]) : src[x];
+        uint32_t a = srcHasAlpha ? div255((s >> 24) * alpha) : alpha;
+
+        if(a == 0)
+        {
+            continue;
+        }
+
+        uint32_t d = dst[x];
+        if(a == 255)
+        {
+            dst[x] = (d & 0xff000000) | (s & 0x00ffffff);
+            continue;
+        }
+
+        uint32_t out = d & 0xff000000;
+        for(int shift = 0; shift < 24; shift += 8)
+        {
+            uint32_t sc = (s >> shift) & 0xff;
+            uint32_t dc = (d >> shift) & 0xff;
+            out |= div255(sc * a + dc * (255 - a)) << shift;
+        }
+        dst[x] = out;
+    }
+}
+
+
+// Blends as many whole vectors of the row as possible and returns how many
+// pixels it handled; the scalar loop finishes the tail.
+#if defined(ALPHABLEND_NEON)
+
+static inline uint8x8_t div255(uint16x8_t x)
+{
+    x = vaddq_u16(x, vdupq_n_u16(128));
+    return vshrn_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+}
+
+
+int AlphaBlend::blendRowVector(const uint32_t *src, uint32_t *dst, int width, uint8_t alpha, bool srcHasAlpha, bool swap)
+{
+    const uint8x8_t globalAlpha = vdup_n_u8(alpha);
+    const uint8x8_t full        = vdup_n_u8(255);
+    int x = 0;
+
+    for(; x + 8 <= width; x += 8)
+    {
+        // de-interleaved: val[0..2] colour bytes in memory order, val[3] alpha
+        uint8x8x4_t s = vld4_u8(reinterpret_cast<const uint8_t *>(src + x));
+        uint8x8x4_t d = vld4_u8(reinterpret_cast<const uint8_t *>(dst + x));
+
+        if(swap)
+        {
+            uint8x8_t red = s.val[0];
+            s.val[0] = s.val[2];
+            s.val[2] = red;
+        }
+
+        uint8x8_t a    = srcHasAlpha ? div255(vmull_u8(s.val[3], globalAlpha)) : globalAlpha;
+        uint8x8_t invA = vsub_u8(full, a);
+
+        for(int c = 0; c < 3; ++c)
+        {
+            d.val[c] = div255(vmlal_u8(vmull_u8(s.val[c], a), d.val[c], invA));
+        }
+
+        vst4_u8(reinterpret_cast<uint8_t *>(dst + x), d);
+    }
+
+    return x;
+}
+
+#elif defined(ALPHABLEND_SSE2)
+
+static inline __m128i div255(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+
+// Blends two pixels unpacked to 16 bit lanes; each product fits in 16 bits.
+static inline __m128i blendPair(__m128i s, __m128i d, __m128i globalAlpha, bool srcHasAlpha)
+{
+    __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    a = srcHasAlpha ? div255(_mm_mullo_epi16(a, globalAlpha)) : globalAlpha;
+    __m128i invA = _mm_sub_epi16(_mm_set1_epi16(255), a);
+    return div255(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, invA)));
+}
+
+
+int AlphaBlend::blendRowVector(const uint32_t *src, uint32_t *dst, int width, uint8_t alpha, bool srcHasAlpha, bool swap)
+{
+    const __m128i zero        = _mm_setzero_si128();
+    const __m128i globalAlpha = _mm_set1_epi16(alpha);
+    const __m128i topByte     = _mm_set1_epi32(0xff000000);
+    const __m128i greenAlpha  = _mm_set1_epi32(0xff00ff00);
+    const __m128i lowByte     = _mm_set1_epi32(0x000000ff);
+    int x = 0;
+
+    for(; x + 4 <= width; x += 4)
+    {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + x));
+
+        if(swap)
+        {
+            s = _mm_or_si128(_mm_and_si128(s, greenAlpha),
+                             _mm_or_si128(_mm_and_si128(_mm_srli_epi32(s, 16), lowByte),
+                                          _mm_slli_epi32(_mm_and_si128(s, lowByte), 16)));
+        }
+
+        __m128i lo = blendPair(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), globalAlpha, srcHasAlpha);
+        __m128i hi = blendPair(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), globalAlpha, srcHasAlpha);
+        __m128i out = _mm_packus_epi16(lo, hi);
+
+        // keep the destination's top byte
+        out = _mm_or_si128(_mm_andnot_si128(topByte, out), _mm_and_si128(topByte, d));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), out);
+    }
+
+    return x;
+}
+
+#else
+
+int AlphaBlend::blendRowVector(const uint32_t *, uint32_t *, int, uint8_t, bool, bool)
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,41 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <stdint.h>
+
+// Source-over compositing of a 32bpp surface onto an opaque 32bpp
+// destination, modulated by a global alpha, in one pass and without
+// touching the source. Pixels carry their alpha (if any) in the top byte;
+// the colour bytes are either in the destination's order or have red and
+// blue swapped (RGBA images drawn onto the XRGB window). The destination's
+// top byte is left as it was.
+//
+// blend() uses NEON or SSE2 when the build has them; blendScalar() is the
+// reference both must match bit for bit.
+class AlphaBlend
+{
+public:
+    static void blend(const uint32_t *src, int srcPitch, uint32_t *dst, int dstPitch,
+                      int width, int height, uint8_t alpha, bool srcHasAlpha, bool swapRedBlue);
+    static void blendScalar(const uint32_t *src, int srcPitch, uint32_t *dst, int dstPitch,
+                            int width, int height, uint8_t alpha, bool srcHasAlpha, bool swapRedBlue);
+
+private:
+    static void copyRow(const uint32_t *src, uint32_t *dst, int width, bool swapRedBlue);
+    static int blendRowVector(const uint32_t *src, uint32_t *dst, int width, uint8_t alpha, bool srcHasAlpha, bool swapRedBlue);
+    static void blendRowScalar(const uint32_t *src, uint32_t *dst, int width, uint8_t alpha, bool srcHasAlpha, bool swapRedBlue);
+};
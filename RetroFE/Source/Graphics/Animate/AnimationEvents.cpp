@@ -18,6 +18,9 @@
 #include <string>
 
 
+std::map<std::string, int> AnimationEvents::eventIdMap_;
+std::vector<std::string> AnimationEvents::eventNames_;
+
 
 AnimationEvents::AnimationEvents()
 {
@@ -25,12 +28,17 @@ AnimationEvents::AnimationEvents()
 
 AnimationEvents::AnimationEvents(AnimationEvents &copy)
 {
-    for(std::map<std::string, std::map<int , Animation *> >::iterator it = copy.animationMap_.begin(); it != copy.animationMap_.end(); it++)
+    animationTable_.resize(copy.animationTable_.size());
+    for(unsigned int event = 0; event < copy.animationTable_.size(); event++)
     {
-        for(std::map<int, Animation *>::iterator it2 = (it->second).begin(); it2 != (it->second).end(); it2++)
+        std::vector<Animation *> &row = copy.animationTable_[event];
+        animationTable_[event].resize(row.size(), NULL);
+        for(unsigned int i = 0; i < row.size(); i++)
         {
-            Animation *t = new Animation(*it2->second);
-            animationMap_[it->first][it2->first] = t;
+            if(row[i])
+            {
+                animationTable_[event][i] = new Animation(*row[i]);
+            }
         }
     }
 }
@@ -40,52 +48,149 @@ AnimationEvents::~AnimationEvents()
     clear();
 }
 
-Animation *AnimationEvents::getAnimation(std::string tween)
+Animation *AnimationEvents::getAnimation(int event)
 {
-    return getAnimation(tween, -1);
+    return getAnimation(event, -1);
 }
 
-Animation *AnimationEvents::getAnimation(std::string tween, int index)
+Animation *AnimationEvents::getAnimation(int event, int index)
 {
-    if(animationMap_.find(tween) == animationMap_.end())
+    if(event < 0)
     {
-        animationMap_[tween][-1] = new Animation();
+        return NULL;
     }
 
-    if(animationMap_[tween].find(index) == animationMap_[tween].end())
+    if(static_cast<unsigned int>(event) >= animationTable_.size())
     {
-        index = -1;
+        animationTable_.resize(event + 1);
+    }
 
-        if(animationMap_[tween].find(index) == animationMap_[tween].end())
-        {
-            animationMap_[tween][index] = new Animation();
-        }
+    std::vector<Animation *> &row = animationTable_[event];
+    unsigned int column = static_cast<unsigned int>(index + 1);
+
+    if(index >= -1 && column < row.size() && row[column])
+    {
+        return row[column];
     }
 
-    return animationMap_[tween][index];
+    if(row.size() == 0)
+    {
+        row.resize(1, NULL);
+    }
+    if(!row[0])
+    {
+        row[0] = new Animation();
+    }
+
+    return row[0];
 }
 
-void AnimationEvents::setAnimation(std::string tween, int index, Animation *animation)
+void AnimationEvents::setAnimation(int event, int index, Animation *animation)
 {
-    animationMap_[tween][index] = animation;
+    if(event < 0 || index < -1)
+    {
+        delete animation;
+        return;
+    }
+
+    if(static_cast<unsigned int>(event) >= animationTable_.size())
+    {
+        animationTable_.resize(event + 1);
+    }
+
+    std::vector<Animation *> &row = animationTable_[event];
+    unsigned int column = static_cast<unsigned int>(index + 1);
+
+    if(column >= row.size())
+    {
+        row.resize(column + 1, NULL);
+    }
+
+    if(row[column] != animation)
+    {
+        delete row[column];
+    }
+    row[column] = animation;
 }
 
 void AnimationEvents::clear()
 {
-    std::map<std::string, std::map<int, Animation *> >::iterator it = animationMap_.begin();
-    while(it != animationMap_.end())
+    for(unsigned int event = 0; event < animationTable_.size(); event++)
     {
-        std::map<int, Animation *>::iterator it2 = (it->second).begin();
-        while(it2 != (it->second).end())
+        std::vector<Animation *> &row = animationTable_[event];
+        for(unsigned int i = 0; i < row.size(); i++)
         {
-            delete it2->second;
-            (it->second).erase(it2);
+            delete row[i];
         }
+    }
+
+    animationTable_.clear();
+}
 
-        (it->second).clear();
-        animationMap_.erase(it);
-        it = animationMap_.begin();
+int AnimationEvents::getEventId(std::string name)
+{
+    initializeEvents();
+
+    std::map<std::string, int>::iterator it = eventIdMap_.find(name);
+    if(it != eventIdMap_.end())
+    {
+        return it->second;
     }
 
-    animationMap_.clear();
+    int event = static_cast<int>(eventNames_.size());
+    eventNames_.push_back(name);
+    eventIdMap_[name] = event;
+
+    return event;
+}
+
+std::string AnimationEvents::getEventName(int event)
+{
+    initializeEvents();
+
+    if(event < 0 || static_cast<unsigned int>(event) >= eventNames_.size())
+    {
+        return "";
+    }
+
+    return eventNames_[event];
+}
+
+void AnimationEvents::initializeEvents()
+{
+    if(eventNames_.size() > 0)
+    {
+        return;
+    }
+
+    // must follow the order of AnimationEventId
+    eventNames_.push_back("enter");
+    eventNames_.push_back("exit");
+    eventNames_.push_back("idle");
+    eventNames_.push_back("menuIdle");
+    eventNames_.push_back("menuScroll");
+    eventNames_.push_back("menuScrollPrev");
+    eventNames_.push_back("menuScrollNext");
+    eventNames_.push_back("menuFastScroll");
+    eventNames_.push_back("menuFastScrollPrev");
+    eventNames_.push_back("menuFastScrollNext");
+    eventNames_.push_back("highlightEnter");
+    eventNames_.push_back("highlightExit");
+    eventNames_.push_back("menuEnter");
+    eventNames_.push_back("menuExit");
+    eventNames_.push_back("gameEnter");
+    eventNames_.push_back("gameExit");
+    eventNames_.push_back("playlistEnter");
+    eventNames_.push_back("playlistExit");
+    eventNames_.push_back("menuJumpEnter");
+    eventNames_.push_back("menuJumpExit");
+    eventNames_.push_back("menuActionInputEnter");
+    eventNames_.push_back("menuActionInputExit");
+    eventNames_.push_back("menuActionSelectEnter");
+    eventNames_.push_back("menuActionSelectExit");
+
+    for(unsigned int i = 0; i < eventNames_.size(); i++)
+    {
+        eventIdMap_[eventNames_[i]] = static_cast<int>(i);
+    }
 }
@@ -21,6 +21,38 @@
 #include <vector>
 #include <map>
 
+// Built-in animation events. Event names that are not listed here are given
+// ids starting at EVENT_COUNT the first time they are seen.
+enum AnimationEventId
+{
+    EVENT_NONE = -1,
+    EVENT_ENTER,
+    EVENT_EXIT,
+    EVENT_IDLE,
+    EVENT_MENU_IDLE,
+    EVENT_MENU_SCROLL,
+    EVENT_MENU_SCROLL_PREV,
+    EVENT_MENU_SCROLL_NEXT,
+    EVENT_MENU_FAST_SCROLL,
+    EVENT_MENU_FAST_SCROLL_PREV,
+    EVENT_MENU_FAST_SCROLL_NEXT,
+    EVENT_HIGHLIGHT_ENTER,
+    EVENT_HIGHLIGHT_EXIT,
+    EVENT_MENU_ENTER,
+    EVENT_MENU_EXIT,
+    EVENT_GAME_ENTER,
+    EVENT_GAME_EXIT,
+    EVENT_PLAYLIST_ENTER,
+    EVENT_PLAYLIST_EXIT,
+    EVENT_MENU_JUMP_ENTER,
+    EVENT_MENU_JUMP_EXIT,
+    EVENT_MENU_ACTION_INPUT_ENTER,
+    EVENT_MENU_ACTION_INPUT_EXIT,
+    EVENT_MENU_ACTION_SELECT_ENTER,
+    EVENT_MENU_ACTION_SELECT_EXIT,
+    EVENT_COUNT
+};
+
 class AnimationEvents
 {
 public:
@@ -28,11 +60,20 @@ public:
     AnimationEvents(AnimationEvents &copy);
     ~AnimationEvents();
 
-    Animation *getAnimation(std::string tween);
-    Animation *getAnimation(std::string tween, int index);
-    void setAnimation(std::string tween, int index, Animation *animation);
+    Animation *getAnimation(int event);
+    Animation *getAnimation(int event, int index);
+    void setAnimation(int event, int index, Animation *animation);
     void clear();
 
+    static int getEventId(std::string name);
+    static std::string getEventName(int event);
+
 private:
-    std::map<std::string, std::map<int, Animation *> > animationMap_;
+    static void initializeEvents();
+
+    // indexed by [event][menuIndex + 1]; column 0 holds the animation for all menu indexes
+    std::vector<std::vector<Animation *> > animationTable_;
+
+    static std::map<std::string, int> eventIdMap_;
+    static std::vector<std::string> eventNames_;
 };
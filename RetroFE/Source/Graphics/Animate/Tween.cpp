@@ -123,6 +123,10 @@ double Tween::getEnd( ){
 	return end;
 }
 
+TweenAlgorithm Tween::getType( ){
+	return type;
+}
+
 float Tween::animate(double elapsedTime)
 {
     return animateSingle(type, start, end, duration, elapsedTime);
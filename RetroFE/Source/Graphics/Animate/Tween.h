@@ -37,6 +37,7 @@ public:
     bool   startDefined;
     double getStart( );
     double getEnd( );
+    TweenAlgorithm getType( );
 
 private:
     static double easeInQuadratic(double elapsedTime, double duration, double b, double c);
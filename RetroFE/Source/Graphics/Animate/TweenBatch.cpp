@@ -0,0 +1,415 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TweenBatch.h"
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+bool  TweenBatch::tablesInitialized_ = false;
+float TweenBatch::easeInSineTable_[TweenBatch::TABLE_SIZE + 1];
+float TweenBatch::easeOutSineTable_[TweenBatch::TABLE_SIZE + 1];
+float TweenBatch::easeInOutSineTable_[TweenBatch::TABLE_SIZE + 1];
+float TweenBatch::easeInExponentialTable_[TweenBatch::TABLE_SIZE + 1];
+float TweenBatch::easeOutExponentialTable_[TweenBatch::TABLE_SIZE + 1];
+float TweenBatch::easeInOutExponentialTable_[TweenBatch::TABLE_SIZE + 1];
+
+namespace
+{
+    // Normalized easing curves: progress in [0,1] maps to a 0..1 fraction
+    // of the tween's range. They match the double versions in Tween.cpp.
+    inline float linear(float p)
+    {
+        return p;
+    }
+
+    inline float easeInQuadratic(float p)
+    {
+        return p*p;
+    }
+
+    inline float easeOutQuadratic(float p)
+    {
+        return p*(2.0f - p);
+    }
+
+    inline float easeInOutQuadratic(float p)
+    {
+        p *= 2.0f;
+        float q = p - 2.0f;
+        return (p < 1.0f) ? 0.5f*p*p : 0.5f*(2.0f - q*q);
+    }
+
+    inline float easeInCubic(float p)
+    {
+        return p*p*p;
+    }
+
+    inline float easeOutCubic(float p)
+    {
+        p -= 1.0f;
+        return p*p*p + 1.0f;
+    }
+
+    inline float easeInOutCubic(float p)
+    {
+        p *= 2.0f;
+        float q = p - 2.0f;
+        return (p < 1.0f) ? 0.5f*p*p*p : 0.5f*(q*q*q + 2.0f);
+    }
+
+    inline float easeInQuartic(float p)
+    {
+        p *= p;
+        return p*p;
+    }
+
+    inline float easeOutQuartic(float p)
+    {
+        p -= 1.0f;
+        p *= p;
+        return 1.0f - p*p;
+    }
+
+    inline float easeInOutQuartic(float p)
+    {
+        p *= 2.0f;
+        float p2 = p*p;
+        float q  = (p - 2.0f)*(p - 2.0f);
+        return (p < 1.0f) ? 0.5f*p2*p2 : 0.5f*(2.0f - q*q);
+    }
+
+    inline float easeInQuintic(float p)
+    {
+        float p2 = p*p;
+        return p2*p2*p;
+    }
+
+    inline float easeOutQuintic(float p)
+    {
+        p -= 1.0f;
+        float p2 = p*p;
+        return p2*p2*p + 1.0f;
+    }
+
+    inline float easeInOutQuintic(float p)
+    {
+        p *= 2.0f;
+        float p2 = p*p;
+        float q  = p - 2.0f;
+        float q2 = q*q;
+        return (p < 1.0f) ? 0.5f*p2*p2*p : 0.5f*(q2*q2*q + 2.0f);
+    }
+
+    inline float easeInCircular(float p)
+    {
+        float r = 1.0f - p*p;
+        return 1.0f - sqrtf(r > 0.0f ? r : 0.0f);
+    }
+
+    inline float easeOutCircular(float p)
+    {
+        p -= 1.0f;
+        float r = 1.0f - p*p;
+        return sqrtf(r > 0.0f ? r : 0.0f);
+    }
+
+    inline float easeInOutCircular(float p)
+    {
+        p *= 2.0f;
+        float q  = (p < 1.0f) ? p : p - 2.0f;
+        float r  = 1.0f - q*q;
+        float s  = sqrtf(r > 0.0f ? r : 0.0f);
+        return (p < 1.0f) ? 0.5f*(1.0f - s) : 0.5f*(s + 1.0f);
+    }
+
+    template<float (*Curve)(float)>
+    void applyCurve(const float *progress, float *out, unsigned int count)
+    {
+        for(unsigned int i = 0; i < count; ++i)
+        {
+            out[i] = Curve(progress[i]);
+        }
+    }
+}
+
+
+TweenBatch::TweenBatch()
+    : deferDepth_(0)
+{
+    initializeTables();
+}
+
+
+void TweenBatch::initializeTables()
+{
+    if(tablesInitialized_) return;
+
+    for(unsigned int i = 0; i <= TABLE_SIZE; ++i)
+    {
+        double p = static_cast<double>(i) / TABLE_SIZE;
+        double p2 = p * 2;
+
+        easeInSineTable_[i]    = static_cast<float>(1 - cos(p * (M_PI/2)));
+        easeOutSineTable_[i]   = static_cast<float>(sin(p * (M_PI/2)));
+        easeInOutSineTable_[i] = static_cast<float>(-0.5 * (cos(M_PI * p) - 1));
+
+        easeInExponentialTable_[i]  = static_cast<float>(pow(2, 10 * (p - 1)));
+        easeOutExponentialTable_[i] = static_cast<float>(1 - pow(2, -10 * p));
+        if(p2 < 1)
+        {
+            easeInOutExponentialTable_[i] = static_cast<float>(0.5 * pow(2, 10 * (p2 - 1)));
+        }
+        else
+        {
+            easeInOutExponentialTable_[i] = static_cast<float>(0.5 * (2 - pow(2, -10 * (p2 - 1))));
+        }
+    }
+
+    tablesInitialized_ = true;
+}
+
+
+float TweenBatch::lookup(const float *table, float progress)
+{
+    float position = progress * TABLE_SIZE;
+    unsigned int index = static_cast<unsigned int>(position);
+    if(index >= TABLE_SIZE) return table[TABLE_SIZE];
+
+    float fraction = position - index;
+    return table[index] + (table[index + 1] - table[index]) * fraction;
+}
+
+
+void TweenBatch::push(TweenAlgorithm type, float start, float end, float progress, float *target)
+{
+    if(!(progress > 0.0f)) progress = 0.0f;
+    if(progress > 1.0f)    progress = 1.0f;
+
+    types_.push_back(static_cast<unsigned char>(type));
+    progress_.push_back(progress);
+    start_.push_back(start);
+    delta_.push_back(end - start);
+    floatTargets_.push_back(target);
+    uintTargets_.push_back(NULL);
+
+    if(deferDepth_ == 0) flush();
+}
+
+
+void TweenBatch::push(TweenAlgorithm type, float start, float end, float progress, unsigned int *target)
+{
+    if(!(progress > 0.0f)) progress = 0.0f;
+    if(progress > 1.0f)    progress = 1.0f;
+
+    types_.push_back(static_cast<unsigned char>(type));
+    progress_.push_back(progress);
+    start_.push_back(start);
+    delta_.push_back(end - start);
+    floatTargets_.push_back(NULL);
+    uintTargets_.push_back(target);
+
+    if(deferDepth_ == 0) flush();
+}
+
+
+void TweenBatch::begin()
+{
+    deferDepth_++;
+}
+
+
+void TweenBatch::end()
+{
+    if(deferDepth_ > 0) deferDepth_--;
+    if(deferDepth_ == 0) flush();
+}
+
+
+bool TweenBatch::isDeferred()
+{
+    return (deferDepth_ > 0);
+}
+
+
+unsigned int TweenBatch::size()
+{
+    return types_.size();
+}
+
+
+void TweenBatch::flush()
+{
+    unsigned int count = types_.size();
+    if(count == 0) return;
+
+    result_.resize(count);
+
+    // evaluate runs of the same easing curve together so each run is a
+    // tight, branch-free loop
+    unsigned int runStart = 0;
+    while(runStart < count)
+    {
+        unsigned int runEnd = runStart + 1;
+        while(runEnd < count && types_[runEnd] == types_[runStart])
+        {
+            runEnd++;
+        }
+
+        easeRange(static_cast<TweenAlgorithm>(types_[runStart]), &progress_[runStart], &result_[runStart], runEnd - runStart);
+        runStart = runEnd;
+    }
+
+    for(unsigned int i = 0; i < count; ++i)
+    {
+        result_[i] = start_[i] + delta_[i] * result_[i];
+    }
+
+    // write back in push order so later tweens on the same property win
+    for(unsigned int i = 0; i < count; ++i)
+    {
+        if(floatTargets_[i])
+        {
+            *floatTargets_[i] = result_[i];
+        }
+        else if(uintTargets_[i])
+        {
+            *uintTargets_[i] = static_cast<unsigned int>(result_[i]);
+        }
+    }
+
+    types_.clear();
+    progress_.clear();
+    start_.clear();
+    delta_.clear();
+    result_.clear();
+    floatTargets_.clear();
+    uintTargets_.clear();
+}
+
+
+float TweenBatch::ease(TweenAlgorithm type, float progress)
+{
+    initializeTables();
+
+    if(!(progress > 0.0f)) progress = 0.0f;
+    if(progress > 1.0f)    progress = 1.0f;
+
+    float result = 0;
+    easeRange(type, &progress, &result, 1);
+    return result;
+}
+
+
+void TweenBatch::easeRange(TweenAlgorithm type, const float *progress, float *out, unsigned int count)
+{
+    const float *table = NULL;
+
+    switch(type)
+    {
+    case EASE_IN_QUADRATIC:
+        applyCurve<easeInQuadratic>(progress, out, count);
+        return;
+
+    case EASE_OUT_QUADRATIC:
+        applyCurve<easeOutQuadratic>(progress, out, count);
+        return;
+
+    case EASE_INOUT_QUADRATIC:
+        applyCurve<easeInOutQuadratic>(progress, out, count);
+        return;
+
+    case EASE_IN_CUBIC:
+        applyCurve<easeInCubic>(progress, out, count);
+        return;
+
+    case EASE_OUT_CUBIC:
+        applyCurve<easeOutCubic>(progress, out, count);
+        return;
+
+    case EASE_INOUT_CUBIC:
+        applyCurve<easeInOutCubic>(progress, out, count);
+        return;
+
+    case EASE_IN_QUARTIC:
+        applyCurve<easeInQuartic>(progress, out, count);
+        return;
+
+    case EASE_OUT_QUARTIC:
+        applyCurve<easeOutQuartic>(progress, out, count);
+        return;
+
+    case EASE_INOUT_QUARTIC:
+        applyCurve<easeInOutQuartic>(progress, out, count);
+        return;
+
+    case EASE_IN_QUINTIC:
+        applyCurve<easeInQuintic>(progress, out, count);
+        return;
+
+    case EASE_OUT_QUINTIC:
+        applyCurve<easeOutQuintic>(progress, out, count);
+        return;
+
+    case EASE_INOUT_QUINTIC:
+        applyCurve<easeInOutQuintic>(progress, out, count);
+        return;
+
+    case EASE_IN_CIRCULAR:
+        applyCurve<easeInCircular>(progress, out, count);
+        return;
+
+    case EASE_OUT_CIRCULAR:
+        applyCurve<easeOutCircular>(progress, out, count);
+        return;
+
+    case EASE_INOUT_CIRCULAR:
+        applyCurve<easeInOutCircular>(progress, out, count);
+        return;
+
+    case EASE_IN_SINE:
+        table = easeInSineTable_;
+        break;
+
+    case EASE_OUT_SINE:
+        table = easeOutSineTable_;
+        break;
+
+    case EASE_INOUT_SINE:
+        table = easeInOutSineTable_;
+        break;
+
+    case EASE_IN_EXPONENTIAL:
+        table = easeInExponentialTable_;
+        break;
+
+    case EASE_OUT_EXPONENTIAL:
+        table = easeOutExponentialTable_;
+        break;
+
+    case EASE_INOUT_EXPONENTIAL:
+        table = easeInOutExponentialTable_;
+        break;
+
+    case LINEAR:
+    default:
+        applyCurve<linear>(progress, out, count);
+        return;
+    }
+
+    for(unsigned int i = 0; i < count; ++i)
+    {
+        out[i] = lookup(table, progress[i]);
+    }
+}
@@ -0,0 +1,60 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "TweenTypes.h"
+#include <vector>
+
+// Collects the tweens that are active during a page update and evaluates
+// them in one pass. Easing curves are computed in float, using plain
+// polynomials where possible and precomputed tables for the sine and
+// exponential curves, instead of Tween::animateSingle's double math.
+class TweenBatch
+{
+public:
+    TweenBatch();
+    void push(TweenAlgorithm type, float start, float end, float progress, float *target);
+    void push(TweenAlgorithm type, float start, float end, float progress, unsigned int *target);
+    void begin();
+    void end();
+    void flush();
+    bool isDeferred();
+    unsigned int size();
+    static float ease(TweenAlgorithm type, float progress);
+
+private:
+    static void easeRange(TweenAlgorithm type, const float *progress, float *out, unsigned int count);
+    static void initializeTables();
+    static float lookup(const float *table, float progress);
+
+    static const unsigned int TABLE_SIZE = 256;
+    static bool  tablesInitialized_;
+    static float easeInSineTable_[TABLE_SIZE + 1];
+    static float easeOutSineTable_[TABLE_SIZE + 1];
+    static float easeInOutSineTable_[TABLE_SIZE + 1];
+    static float easeInExponentialTable_[TABLE_SIZE + 1];
+    static float easeOutExponentialTable_[TABLE_SIZE + 1];
+    static float easeInOutExponentialTable_[TABLE_SIZE + 1];
+
+    std::vector<unsigned char>  types_;
+    std::vector<float>          progress_;
+    std::vector<float>          start_;
+    std::vector<float>          delta_;
+    std::vector<float>          result_;
+    std::vector<float *>        floatTargets_;
+    std::vector<unsigned int *> uintTargets_;
+    int                         deferDepth_;
+};
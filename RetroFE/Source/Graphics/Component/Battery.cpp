@@ -2,6 +2,7 @@
 #include "../ViewInfo.h"
 #include "../../SDL.h"
 #include "../../Utility/Log.h"
+#include "../../Utility/SystemState.h"
 #include "../../Database/Configuration.h"
 #include <SDL/SDL_image.h>
 
@@ -76,11 +77,6 @@ static uint32_t noBatIcon [NOBAT_ICON_HEIGHT][NOBAT_ICON_WIDTH] = {
         {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
 
 
-/*Default value, reset with config*/
-std::string Battery::fileUsbConnected_ = "/sys/class/power_supply/axp20x-usb/present";
-std::string Battery::fileBatConnected_ = "/sys/class/power_supply/axp20x-battery/present";
-std::string Battery::fileBatCapacity_ = "/sys/class/power_supply/axp20x-battery/capacity";
-
 int 	Battery::last_id_ = 0;
 int 	Battery::percentage_ = 0;
 int 	Battery::prevPercentage_ = 0;
@@ -111,17 +107,7 @@ Battery::Battery(Page &p, Configuration &config, float reloadPeriod, SDL_Color f
 
     allocateGraphicsMemory();
 
-    if( config_.propertyExists( "fileUsbConnected" ) ){
-        config_.getProperty( "fileUsbConnected", fileUsbConnected_ );
-    }
-    if( config_.propertyExists( "fileBatConnected" ) ){
-        config_.getProperty( "fileBatConnected", fileBatConnected_ );
-    }
-    if( config_.propertyExists( "fileBatCapacity" ) ){
-        config_.getProperty( "fileBatCapacity", fileBatCapacity_ );
-    }
-
-    //printf("battery init OK, fileUsbConnected_=%s, id=%d\n", fileUsbConnected_.c_str(), id_);
+    //printf("battery init OK, id=%d\n", id_);
 }
 
 Battery::~Battery()
@@ -146,9 +132,16 @@ void Battery::freeGraphicsMemory()
         SDL_FreeSurface(texture_prescaled_);
 	texture_prescaled_ = NULL;
     }
+    accountSurfaces();
     SDL_UnlockMutex(SDL::getMutex());
 }
 
+void Battery::accountSurfaces()
+{
+    account_.set(SurfaceBudget::CategoryArtwork, SDL::surfaceBytes(texture_));
+    account_.set(SurfaceBudget::CategoryScaled, SDL::surfaceBytes(texture_prescaled_));
+}
+
 void Battery::allocateGraphicsMemory()
 {
 
@@ -189,6 +182,7 @@ void Battery::allocateGraphicsMemory()
 	    baseViewInfo.ImageWidth = texture_->w * scaleX_;
 	    baseViewInfo.ImageHeight = texture_->h * scaleY_;
         }
+        accountSurfaces();
         SDL_UnlockMutex(SDL::getMutex());
 
     }
@@ -313,50 +307,34 @@ void Battery::drawBatteryCharging()
 
 }
 
-int Battery::readFileValue(std::string file){
-
-	std::ifstream ifs(file.c_str());
-    std::string line;
-    int retVal = -1;
-
-	if (!ifs.is_open())
-	{
-		Logger::write(Logger::ZONE_ERROR, "Configuration", "Could not open " + file + "\"");
-		return -1;
-	}
-
-	while (std::getline (ifs, line))
-	{
-		retVal = atoi(line.c_str());
-	}
-
-	ifs.close();
-
-	return retVal;
-}
-
+// Values are polled by the system state service, these only read its cache
 bool Battery::isBatConnected(){
 
-	int res = readFileValue(fileBatConnected_);
-	//printf("%s: %d \n", __func__, res);
-
-	return (res==1)?true:false;
+	return SystemState::isBatteryConnected();
 }
 
 bool Battery::isUsbConnected(){
 
-	int res = readFileValue(fileUsbConnected_);
-	//printf("%s: %d \n", __func__, res);
-
-	return (res==1)?true:false;
+	return SystemState::isUsbConnected();
 }
 
 int Battery::getBatPercent(){
 
-	int res = readFileValue(fileBatCapacity_);
-	//printf("%s: %d \n", __func__, res);
+	return SystemState::getBatteryPercent();
+}
+
+float Battery::getIdleTimeout()
+{
+    float timeout = Component::getIdleTimeout();
+
+    // only the first battery component polls the battery
+    if(id_==0)
+    {
+        float reload = reloadPeriod_ - currentWaitTime_;
+        timeout = earliestTimeout(timeout, (reload > 0) ? reload : 0);
+    }
 
-	return res;
+    return timeout;
 }
 
 void Battery::update(float dt)
@@ -432,10 +410,12 @@ void Battery::draw()
     if(texture_ && valuesReady_ && baseViewInfo.Alpha > 0.0f )
     {
         SDL_Rect rect;
-        rect.x = static_cast<int>(baseViewInfo.XRelativeToOrigin());
-        rect.y = static_cast<int>(baseViewInfo.YRelativeToOrigin());
-        rect.h = static_cast<int>(baseViewInfo.ScaledHeight());
-        rect.w = static_cast<int>(baseViewInfo.ScaledWidth());
+        float x, y, width, height;
+        baseViewInfo.Bounds(x, y, width, height);
+        rect.x = static_cast<int>(x);
+        rect.y = static_cast<int>(y);
+        rect.h = static_cast<int>(height);
+        rect.w = static_cast<int>(width);
 
 		/* Cache scaling */
 		scaling_needed = rect.w!=0 && rect.h!=0 && (texture_->w != rect.w || texture_->h != rect.h);
@@ -460,6 +440,7 @@ void Battery::draw()
 		else{
 			SDL::renderCopy(texture_, baseViewInfo.Alpha, NULL, &rect, baseViewInfo);
 		}
+		accountSurfaces();
     }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "../../Utility/SurfaceBudget.h"
 #include <SDL/SDL.h>
 #include <string>
 
@@ -12,6 +13,7 @@ public:
     void freeGraphicsMemory();
     void allocateGraphicsMemory();
     void update(float dt);
+    float getIdleTimeout();
     void draw();
     bool mustRender();
     bool isBatConnected();
@@ -22,7 +24,7 @@ protected:
     void drawBatteryPercent();
     void drawBatteryCharging();
     void drawNoBattery();
-    int readFileValue(std::string file);
+    void accountSurfaces();
 
     int 		id_;
     Configuration &config_;
@@ -33,10 +35,7 @@ protected:
     float 		scaleY_;
     float		reloadPeriod_;
     bool 		mustUpdate_;
-
-    static std::string fileUsbConnected_;
-    static std::string fileBatConnected_;
-    static std::string fileBatCapacity_;
+    SurfaceBudget::Account account_;
 
     static int		last_id_;
     static float	currentWaitTime_;
@@ -15,6 +15,7 @@
  */
 #include "Component.h"
 #include "../Animate/Tween.h"
+#include "../Animate/TweenBatch.h"
 #include "../../Graphics/ViewInfo.h"
 #include "../../Utility/Log.h"
 #include "../../SDL.h"
@@ -48,13 +49,15 @@ Component::Component(const Component &copy)
 
 Component::~Component()
 {
+    // write out any tween results still queued for this component
+    page.getTweenBatch().flush();
     freeGraphicsMemory();
 }
 
 void Component::freeGraphicsMemory()
 {
-    animationRequestedType_ = "";
-    animationType_          = "";
+    animationRequestedType_ = EVENT_NONE;
+    animationType_          = EVENT_NONE;
     animationRequested_     = false;
     newItemSelected         = false;
     newScrollItemSelected   = false;
@@ -112,7 +115,7 @@ void Component::initializeFonts()
 }
 
 
-void Component::triggerEvent(std::string event, int menuIndex)
+void Component::triggerEvent(int event, int menuIndex)
 {
     animationRequestedType_ = event;
     animationRequested_     = true;
@@ -141,7 +144,7 @@ void Component::setId( int id )
 
 bool Component::isIdle()
 {
-    return (currentTweenComplete_ || animationType_ == "idle" || animationType_ == "menuIdle");
+    return (currentTweenComplete_ || animationType_ == EVENT_IDLE || animationType_ == EVENT_MENU_IDLE);
 }
 
 bool Component::mustRender()
@@ -151,7 +154,31 @@ bool Component::mustRender()
 
 bool Component::isMenuScrolling()
 {
-    return (!currentTweenComplete_ && animationType_ == "menuScroll");
+    return (!currentTweenComplete_ && animationType_ == EVENT_MENU_SCROLL);
+}
+
+// Seconds this component can go without an update before it has something to
+// show; 0 while it is animating and negative when nothing is scheduled.
+float Component::getIdleTimeout()
+{
+    if ( animationRequested_ || newItemSelected || newScrollItemSelected )
+    {
+        return 0;
+    }
+
+    if ( currentTweens_ && currentTweens_->size( ) > 0 && !currentTweenComplete_ )
+    {
+        return 0;
+    }
+
+    return -1;
+}
+
+float Component::earliestTimeout(float a, float b)
+{
+    if ( a < 0 ) return b;
+    if ( b < 0 ) return a;
+    return (a < b) ? a : b;
 }
 
 void Component::setTweens(AnimationEvents *set)
@@ -163,7 +190,7 @@ void Component::update(float dt)
 {
     elapsedTweenTime_ += dt;
 
-    if ( animationRequested_ && animationRequestedType_ != "" )
+    if ( animationRequested_ && animationRequestedType_ != EVENT_NONE )
     {
       Animation *newTweens;
       // Check if this component is part of an active scrolling list
@@ -184,6 +211,7 @@ void Component::update(float dt)
       }
       if (newTweens && newTweens->size() > 0)
       {
+        page.getTweenBatch().flush();
         animationType_        = animationRequestedType_;
         currentTweens_        = newTweens;
         currentTweenIndex_    = 0;
@@ -195,16 +223,17 @@ void Component::update(float dt)
     }
     else if (tweens_ && currentTweenComplete_)
     {
-        animationType_        = "idle";
-        currentTweens_        = tweens_->getAnimation( "idle", menuIndex_ );
+        animationType_        = EVENT_IDLE;
+        currentTweens_        = tweens_->getAnimation( EVENT_IDLE, menuIndex_ );
         if ( currentTweens_ && currentTweens_->size( ) == 0 && !page.isMenuScrolling( ) )
         {
-            currentTweens_    = tweens_->getAnimation( "menuIdle", menuIndex_ );
+            currentTweens_    = tweens_->getAnimation( EVENT_MENU_IDLE, menuIndex_ );
             if ( currentTweens_ && currentTweens_->size( ) > 0 )
             {
                 currentTweens_ = currentTweens_;
             }
         }
+        page.getTweenBatch().flush();
         currentTweenIndex_    = 0;
         elapsedTweenTime_     = 0;
         storeViewInfo_        = baseViewInfo;
@@ -244,6 +273,38 @@ void Component::draw()
 #endif
 }
 
+float *Component::tweenTarget(ViewInfo &info, TweenProperty property)
+{
+    switch(property)
+    {
+    case TWEEN_PROPERTY_X:               return &info.X;
+    case TWEEN_PROPERTY_Y:               return &info.Y;
+    case TWEEN_PROPERTY_HEIGHT:          return &info.Height;
+    case TWEEN_PROPERTY_WIDTH:           return &info.Width;
+    case TWEEN_PROPERTY_ANGLE:           return &info.Angle;
+    case TWEEN_PROPERTY_ALPHA:           return &info.Alpha;
+    case TWEEN_PROPERTY_X_ORIGIN:        return &info.XOrigin;
+    case TWEEN_PROPERTY_Y_ORIGIN:        return &info.YOrigin;
+    case TWEEN_PROPERTY_X_OFFSET:        return &info.XOffset;
+    case TWEEN_PROPERTY_Y_OFFSET:        return &info.YOffset;
+    case TWEEN_PROPERTY_X_OFFSET_SHIFT_MENU_DIRECTION: return &info.XOffset;
+    case TWEEN_PROPERTY_Y_OFFSET_SHIFT_MENU_DIRECTION: return &info.YOffset;
+    case TWEEN_PROPERTY_FONT_SIZE:       return &info.FontSize;
+    case TWEEN_PROPERTY_BACKGROUND_ALPHA: return &info.BackgroundAlpha;
+    case TWEEN_PROPERTY_MAX_WIDTH:       return &info.MaxWidth;
+    case TWEEN_PROPERTY_MAX_HEIGHT:      return &info.MaxHeight;
+    case TWEEN_PROPERTY_CONTAINER_X:     return &info.ContainerX;
+    case TWEEN_PROPERTY_CONTAINER_Y:     return &info.ContainerY;
+    case TWEEN_PROPERTY_CONTAINER_WIDTH: return &info.ContainerWidth;
+    case TWEEN_PROPERTY_CONTAINER_HEIGHT: return &info.ContainerHeight;
+    case TWEEN_PROPERTY_LAYER:
+    case TWEEN_PROPERTY_NOP:
+    default:
+        return NULL;
+    }
+}
+
+
 bool Component::animate()
 {
     bool completeDone = false;
@@ -255,6 +316,7 @@ bool Component::animate()
     {
         bool currentDone = true;
         TweenSet *tweens = currentTweens_->tweenSet(currentTweenIndex_);
+        TweenBatch &batch = page.getTweenBatch();
 
 
         for(unsigned int i = 0; i < tweens->size(); i++)
@@ -273,189 +335,46 @@ bool Component::animate()
                 elapsedTime = static_cast<float>(duration);
             }
 
-            switch(tween->property)
-            {
-            case TWEEN_PROPERTY_X:
-                if (tween->startDefined)
-                    baseViewInfo.X = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.X = tween->animate(elapsedTime, storeViewInfo_.X);
-                break;
-
-            case TWEEN_PROPERTY_Y:
-                if (tween->startDefined)
-                    baseViewInfo.Y = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.Y = tween->animate(elapsedTime, storeViewInfo_.Y);
-                break;
-
-            case TWEEN_PROPERTY_HEIGHT:
-                if (tween->startDefined)
-                    baseViewInfo.Height = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.Height = tween->animate(elapsedTime, storeViewInfo_.Height);
-                break;
-
-            case TWEEN_PROPERTY_WIDTH:
-                if (tween->startDefined)
-                    baseViewInfo.Width = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.Width = tween->animate(elapsedTime, storeViewInfo_.Width);
-                break;
-
-            case TWEEN_PROPERTY_ANGLE:
-                if (tween->startDefined)
-                    baseViewInfo.Angle = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.Angle = tween->animate(elapsedTime, storeViewInfo_.Angle);
-                break;
-
-            case TWEEN_PROPERTY_ALPHA:
-                if (tween->startDefined)
-                    baseViewInfo.Alpha = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.Alpha = tween->animate(elapsedTime, storeViewInfo_.Alpha);
-                break;
-
-            case TWEEN_PROPERTY_X_ORIGIN:
-                if (tween->startDefined)
-                    baseViewInfo.XOrigin = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.XOrigin = tween->animate(elapsedTime, storeViewInfo_.XOrigin);
-                break;
-
-            case TWEEN_PROPERTY_Y_ORIGIN:
-                if (tween->startDefined)
-                    baseViewInfo.YOrigin = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.YOrigin = tween->animate(elapsedTime, storeViewInfo_.YOrigin);
-                break;
+            if ( tween->property == TWEEN_PROPERTY_NOP ) continue;
 
-            case TWEEN_PROPERTY_X_OFFSET:
-                if (tween->startDefined)
-                    baseViewInfo.XOffset = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.XOffset = tween->animate(elapsedTime, storeViewInfo_.XOffset);
-                break;
-
-            case TWEEN_PROPERTY_Y_OFFSET:
-                if (tween->startDefined)
-                    baseViewInfo.YOffset = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.YOffset = tween->animate(elapsedTime, storeViewInfo_.YOffset);
-                break;
+            double start         = tween->getStart();
+            double end           = tween->getEnd();
+            double tweenDuration = tween->duration;
 
+            switch(tween->property)
+            {
             case TWEEN_PROPERTY_X_OFFSET_SHIFT_MENU_DIRECTION:
-                if (tween->startDefined){
-                    baseViewInfo.XOffset = tween->animate(elapsedTime,
-							  tween->getStart(),
-							  tween->getStart() + tween->getEnd()* (static_cast<double>(page.isMenuScrollForward()?-1.0f:1.0f)),
-							  duration);
-                }
-                else{
-                    baseViewInfo.XOffset = tween->animate(elapsedTime,
-							  static_cast<double>(storeViewInfo_.YOffset),
-							  static_cast<double>(storeViewInfo_.YOffset) + tween->getEnd()* (static_cast<double>(page.isMenuScrollForward()?-1.0f:1.0f)),
-							  duration);
-                }
-                break;
-
             case TWEEN_PROPERTY_Y_OFFSET_SHIFT_MENU_DIRECTION:
-                if (tween->startDefined){
-		    /*printf("storeViewInfo_.YOffset = %f, tween->start() = %f, page.isMenuScrollForward()=%d, tween->getEnd()=%f, newEnd=%f\n",
-		      storeViewInfo_.YOffset, tween->getStart(), page.isMenuScrollForward(), tween->getOriginalEnd(),
-		      tween->getStart() + tween->getOriginalEnd()* (static_cast<double>(page.isMenuScrollForward()?-1.0f:1.0f)) );*/
-		    /*printf("y_shift_animation, elapsedTime = %f\n", elapsedTime);
-		      printf("page.getScrollPeriod() = %f\n", page.getScrollPeriod());*/
-
-                    baseViewInfo.YOffset = tween->animate(elapsedTime,
-							  tween->getStart(),
-							  tween->getStart() + tween->getEnd()* (static_cast<double>(page.isMenuScrollForward()?-1.0f:1.0f)),
-							  duration);
-                }
-                else{
-		    /*printf("storeViewInfo_.YOffset = %f, page.isMenuScrollForward()=%d, tween->getEnd()=%f, newEnd=%f\n",
-		      storeViewInfo_.YOffset, page.isMenuScrollForward(), tween->getOriginalEnd(),
-		      static_cast<double>(storeViewInfo_.YOffset) + tween->getOriginalEnd()* (static_cast<double>(page.isMenuScrollForward()?-1.0f:1.0f)) );
-		    */
-
-                    baseViewInfo.YOffset = tween->animate(elapsedTime,
-							  static_cast<double>(storeViewInfo_.YOffset),
-							  static_cast<double>(storeViewInfo_.YOffset) + tween->getEnd()* (static_cast<double>(page.isMenuScrollForward()?-1.0f:1.0f)),
-							  duration);
-                }
-                break;
-
-            case TWEEN_PROPERTY_FONT_SIZE:
-                if (tween->startDefined)
-                    baseViewInfo.FontSize = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.FontSize = tween->animate(elapsedTime, storeViewInfo_.FontSize);
-                break;
-
-            case TWEEN_PROPERTY_BACKGROUND_ALPHA:
-                if (tween->startDefined)
-                    baseViewInfo.BackgroundAlpha = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.BackgroundAlpha = tween->animate(elapsedTime, storeViewInfo_.BackgroundAlpha);
-                break;
-
-            case TWEEN_PROPERTY_MAX_WIDTH:
-                if (tween->startDefined)
-                    baseViewInfo.MaxWidth = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.MaxWidth = tween->animate(elapsedTime, storeViewInfo_.MaxWidth);
-                break;
-
-            case TWEEN_PROPERTY_MAX_HEIGHT:
-                if (tween->startDefined)
-                    baseViewInfo.MaxHeight = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.MaxHeight = tween->animate(elapsedTime, storeViewInfo_.MaxHeight);
+                // shift by the end value in the direction the menu is scrolling
+                if (!tween->startDefined)
+                    start = storeViewInfo_.YOffset;
+                end           = start + tween->getEnd()* (static_cast<double>(page.isMenuScrollForward()?-1.0f:1.0f));
+                tweenDuration = duration;
                 break;
 
             case TWEEN_PROPERTY_LAYER:
-                if (tween->startDefined)
-                    baseViewInfo.Layer = static_cast<unsigned int>(tween->animate(elapsedTime));
-                else
-                    baseViewInfo.Layer = static_cast<unsigned int>(tween->animate(elapsedTime, storeViewInfo_.Layer));
-                break;
-
-            case TWEEN_PROPERTY_CONTAINER_X:
-                if (tween->startDefined)
-                    baseViewInfo.ContainerX = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.ContainerX = tween->animate(elapsedTime, storeViewInfo_.ContainerX);
+                if (!tween->startDefined)
+                    start = storeViewInfo_.Layer;
                 break;
 
-            case TWEEN_PROPERTY_CONTAINER_Y:
-                if (tween->startDefined)
-                    baseViewInfo.ContainerY = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.ContainerY = tween->animate(elapsedTime, storeViewInfo_.ContainerY);
+            default:
+                if (!tween->startDefined)
+                    start = *tweenTarget(storeViewInfo_, tween->property);
                 break;
+            }
 
-            case TWEEN_PROPERTY_CONTAINER_WIDTH:
-                if (tween->startDefined)
-                    baseViewInfo.ContainerWidth = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.ContainerWidth = tween->animate(elapsedTime, storeViewInfo_.ContainerWidth);
-                break;
+            float progress = (tweenDuration > 0) ? static_cast<float>(elapsedTime / tweenDuration) : 0.0f;
 
-            case TWEEN_PROPERTY_CONTAINER_HEIGHT:
-                if (tween->startDefined)
-                    baseViewInfo.ContainerHeight = tween->animate(elapsedTime);
-                else
-                    baseViewInfo.ContainerHeight = tween->animate(elapsedTime, storeViewInfo_.ContainerHeight);
-                break;
-
-            case TWEEN_PROPERTY_NOP:
-                break;
-            }
+            if ( tween->property == TWEEN_PROPERTY_LAYER )
+                batch.push(tween->getType(), static_cast<float>(start), static_cast<float>(end), progress, &baseViewInfo.Layer);
+            else
+                batch.push(tween->getType(), static_cast<float>(start), static_cast<float>(end), progress, tweenTarget(baseViewInfo, tween->property));
         }
 
         if ( currentDone )
         {
+            // the next tween set starts from the values just written
+            batch.flush();
             currentTweenIndex_++;
             elapsedTweenTime_ = 0;
             storeViewInfo_    = baseViewInfo;
@@ -33,8 +33,12 @@ public:
     virtual void allocateGraphicsMemory();
     virtual void deInitializeFonts();
     virtual void initializeFonts();
+    // stop videos and free their frames while the page is cached, keeping
+    // everything else loaded
+    virtual void suspendVideos() {};
+    virtual void resumeVideos() {};
     virtual bool mustRender();
-    void triggerEvent(std::string event, int menuIndex = -1);
+    void triggerEvent(int event, int menuIndex = -1);
     void setPlaylist(std::string name );
     void setNewItemSelected();
     void setNewScrollItemSelected();
@@ -48,6 +52,8 @@ public:
     virtual void draw();
     void setTweens(AnimationEvents *set);
     virtual bool isPlaying();
+    virtual float getIdleTimeout();
+    static float earliestTimeout(float a, float b);
     ViewInfo baseViewInfo;
     std::string collectionName;
     void setMenuScrollReload(bool menuScrollReload);
@@ -65,6 +71,7 @@ private:
 
     bool animate();
     bool tweenSequencingComplete();
+    static float *tweenTarget(ViewInfo &info, TweenProperty property);
 
     AnimationEvents *tweens_;
     Animation *currentTweens_;
@@ -74,8 +81,8 @@ private:
     unsigned int currentTweenIndex_;
     bool         currentTweenComplete_;
     float        elapsedTweenTime_;
-    std::string  animationRequestedType_;
-    std::string  animationType_;
+    int          animationRequestedType_;
+    int          animationType_;
     bool         animationRequested_;
     bool         menuScrollReload_;
     int          menuIndex_;
@@ -16,13 +16,18 @@
 #include "Image.h"
 #include "../ViewInfo.h"
 #include "../../SDL.h"
+#include "../SurfaceSnapshot.h"
 #include "../../Utility/Log.h"
 #include <SDL/SDL_image.h>
+#include <cmath>
 
 Image::Image(std::string file, std::string altFile, Page &p, float scaleX, float scaleY, bool dithering)
     : Component(p)
     , texture_(NULL)
     , texture_prescaled_(NULL)
+    , reflection_(NULL)
+    , reflectionSource_(NULL)
+    , reflectionStale_(true)
     , ditheringAuthorized_(dithering)
     , needDithering_(false)
     , imgBitsPerPx_(32)
@@ -30,6 +35,7 @@ Image::Image(std::string file, std::string altFile, Page &p, float scaleX, float
     , altFile_(altFile)
     , scaleX_(scaleX)
     , scaleY_(scaleY)
+    , evicted_(false)
 {
     allocateGraphicsMemory();
 }
@@ -45,8 +51,10 @@ void Image::freeGraphicsMemory()
     //printf("freeGraphicsMemory: %s\n", file_.c_str());
 
     SDL_LockMutex(SDL::getMutex());
+    mips_.reset();
     if (texture_ != NULL)
     {
+        SurfaceSnapshot::store(file_ + "\n" + altFile_, texture_);
         SDL_FreeSurface(texture_);
         texture_ = NULL;
     }
@@ -55,6 +63,42 @@ void Image::freeGraphicsMemory()
         SDL_FreeSurface(texture_prescaled_);
 	texture_prescaled_ = NULL;
     }
+    if (reflection_ != NULL)
+    {
+        SDL_FreeSurface(reflection_);
+        reflection_ = NULL;
+    }
+    reflectionSource_ = NULL;
+    evicted_ = false;
+    accountSurfaces();
+    SurfaceBudget::forget(this);
+    SDL_UnlockMutex(SDL::getMutex());
+}
+
+// Drop the surfaces of an image which is not on screen when the surface
+// memory budget runs out; draw() loads them again.
+void Image::releaseSurfaces()
+{
+    SDL_LockMutex(SDL::getMutex());
+    mips_.reset();
+    if (texture_ != NULL)
+    {
+        SDL_FreeSurface(texture_);
+        texture_ = NULL;
+        evicted_ = true;
+    }
+    if (texture_prescaled_ != NULL)
+    {
+        SDL_FreeSurface(texture_prescaled_);
+        texture_prescaled_ = NULL;
+    }
+    if (reflection_ != NULL)
+    {
+        SDL_FreeSurface(reflection_);
+        reflection_ = NULL;
+    }
+    reflectionSource_ = NULL;
+    accountSurfaces();
     SDL_UnlockMutex(SDL::getMutex());
 }
 
@@ -67,11 +111,17 @@ void Image::allocateGraphicsMemory()
     {
         SDL_LockMutex(SDL::getMutex());
 
+        /* Reuse the decoded image kept across a game launch */
+        texture_ = SurfaceSnapshot::restore(file_ + "\n" + altFile_);
+
         /* Load image */
         SDL_Surface * img_tmp = NULL;
         //printf("Loading image: %s\n", file_.c_str());
-        img_tmp = IMG_Load(file_.c_str());
-        if (!img_tmp && altFile_ != "")
+        if (!texture_)
+        {
+            img_tmp = IMG_Load(file_.c_str());
+        }
+        if (!texture_ && !img_tmp && altFile_ != "")
         {
 	    //printf("	Failed-> Loading backup image: %s\n", altFile_.c_str());
 	    img_tmp = IMG_Load(altFile_.c_str());
@@ -98,14 +148,18 @@ void Image::allocateGraphicsMemory()
 	        texture_ = img_tmp;
 	    }
 	    //SDL_SetAlpha(texture_, SDL_SRCALPHA, 255);
+        }
 
-	    /* Set real dimensions */
-	    if (texture_ != NULL)
-	    {
-	      baseViewInfo.ImageWidth = texture_->w * scaleX_;
-	      baseViewInfo.ImageHeight = texture_->h * scaleY_;
-	    }
+        /* Set real dimensions */
+        if (texture_ != NULL)
+        {
+            buildMips();
+            baseViewInfo.ImageWidth = texture_->w * scaleX_;
+            baseViewInfo.ImageHeight = texture_->h * scaleY_;
+            accountSurfaces();
+            SurfaceBudget::loaded(this);
         }
+        evicted_ = false;
         SDL_UnlockMutex(SDL::getMutex());
 
     }
@@ -115,6 +169,43 @@ void Image::allocateGraphicsMemory()
 }
 
 
+// Queue half size copies of the texture for drawing it scaled down
+void Image::buildMips()
+{
+    if (texture_ == NULL || texture_->format->BytesPerPixel != 4)
+    {
+        return;
+    }
+
+    Resampler::Image source;
+    source.pixels = static_cast<const uint32_t *>(texture_->pixels);
+    source.pitch  = texture_->pitch;
+    source.width  = texture_->w;
+    source.height = texture_->h;
+    mips_.build(source);
+}
+
+
+void Image::accountSurfaces()
+{
+    account_.set(SurfaceBudget::CategoryArtwork, SDL::surfaceBytes(texture_));
+    account_.set(SurfaceBudget::CategoryScaled, SDL::surfaceBytes(texture_prescaled_) +
+                 SDL::surfaceBytes(reflection_) + mips_.bytes());
+}
+
+
+// Visible and at least partly inside the window. The layout size is kept
+// while the surfaces are evicted, so this also works before reloading them.
+bool Image::isOnScreen()
+{
+    float x, y, width, height;
+    baseViewInfo.Bounds(x, y, width, height);
+    return baseViewInfo.Alpha > 0 && width >= 1 && height >= 1 &&
+           x < SDL::getWindowWidth() && y < SDL::getWindowHeight() &&
+           x + width > 0 && y + height > 0;
+}
+
+
 void Image::draw()
 {
 	bool scaling_needed = false;
@@ -123,13 +214,21 @@ void Image::draw()
 
     Component::draw();
 
+    /* Reload the surfaces the memory budget took away */
+    if(evicted_ && isOnScreen())
+    {
+        allocateGraphicsMemory();
+    }
+
     if(texture_)
     {
         SDL_Rect rect;
-        rect.x = static_cast<int>(baseViewInfo.XRelativeToOrigin());
-        rect.y = static_cast<int>(baseViewInfo.YRelativeToOrigin());
-        rect.h = static_cast<int>(baseViewInfo.ScaledHeight());
-        rect.w = static_cast<int>(baseViewInfo.ScaledWidth());
+        float x, y, width, height;
+        baseViewInfo.Bounds(x, y, width, height);
+        rect.x = static_cast<int>(x);
+        rect.y = static_cast<int>(y);
+        rect.h = static_cast<int>(height);
+        rect.w = static_cast<int>(width);
 
         /* Cropping needed ? */
         bool cropping_needed = false;
@@ -154,7 +253,11 @@ void Image::draw()
 	       (cropping_needed && (texture_prescaled_->w != rect_cropping.w || texture_prescaled_->h != rect_cropping.h) ));
 	    if(cache_scaling_needed){
 	        /*printf("\nComputing prescaling and cropping in Image.cpp %s\n", cropping_needed?"and cropping":"");*/
-	        texture_prescaled_ = SDL::zoomSurface(texture_, NULL, &rect, cropping_needed?&rect_cropping:NULL);
+	        /* Filter from the nearest mip level into the reused prescaled surface */
+	        if(!SDL::resampleSurface(texture_, mips_.nearest(rect.w, rect.h), rect.w, rect.h,
+	                                 cropping_needed?&rect_cropping:NULL, &texture_prescaled_)){
+	            texture_prescaled_ = SDL::zoomSurface(texture_, NULL, &rect, cropping_needed?&rect_cropping:NULL);
+	        }
 		if(texture_prescaled_ == NULL){
 		    printf("ERROR in %s - Could not create texture_prescaled_\n", __func__);
 		    use_prescaled = false;
@@ -162,6 +265,7 @@ void Image::draw()
 		if(imgBitsPerPx_ > 16 && ditheringAuthorized_){
 		    needDithering_ = true;
 		}
+		reflectionStale_ = true;
 	    }
 
 	    if(texture_prescaled_ != NULL){
@@ -181,12 +285,101 @@ void Image::draw()
 	/* Dithering */
 	if(needDithering_){
 	    //printf("Dither: %s\n", file_.c_str());
+	    /* The mip levels are read from texture_ in the background */
+	    if(surfaceToRender == texture_){
+	        mips_.reset();
+	    }
 	    SDL::ditherSurface32bppTo16Bpp(surfaceToRender);
+	    reflectionStale_ = true;
+	    if(surfaceToRender == texture_){
+	        buildMips();
+	    }
 	    needDithering_ = false;
 	}
 
 	/* Render */
 	//printf("image render\n");
 	SDL::renderCopy(surfaceToRender, baseViewInfo.Alpha, NULL, &rect, baseViewInfo);
+
+	if(baseViewInfo.Reflection != ViewInfo::ReflectionNone){
+	    if(cropping_needed && surfaceToRender == texture_prescaled_){
+	        rect.x += rect_cropping.x;
+	        rect.y += rect_cropping.y;
+	        rect.w = rect_cropping.w;
+	        rect.h = rect_cropping.h;
+	    }
+	    drawReflection(surfaceToRender, rect);
+	}
+
+	/* Surfaces on screen are kept when over the memory budget */
+	accountSurfaces();
+	if(isOnScreen()){
+	    SurfaceBudget::drawn(this);
+	}
+    }
+}
+
+
+// Draw the reflection of surface, drawn at rect. The reflection is made
+// once and only remade when the drawn surface or the reflection changes.
+void Image::drawReflection(SDL_Surface *surface, SDL_Rect &rect)
+{
+    if(reflectionStale_ || surface != reflectionSource_ ||
+       reflectionInfo_.Reflection != baseViewInfo.Reflection ||
+       reflectionInfo_.ReflectionScale != baseViewInfo.ReflectionScale ||
+       reflectionInfo_.ReflectionAlpha != baseViewInfo.ReflectionAlpha)
+    {
+        if(reflection_ != NULL)
+        {
+            SDL_FreeSurface(reflection_);
+        }
+        reflection_ = SDL::createReflection(surface, baseViewInfo);
+        reflectionSource_ = surface;
+        reflectionInfo_ = baseViewInfo;
+        reflectionStale_ = false;
+    }
+    if(reflection_ == NULL || surface->w <= 0 || surface->h <= 0)
+    {
+        return;
+    }
+
+    /* The reflection is made at the size of surface, scale it like rect */
+    SDL_Rect reflectionRect;
+    reflectionRect.w = static_cast<Uint16>(reflection_->w * rect.w / surface->w);
+    reflectionRect.h = static_cast<Uint16>(reflection_->h * rect.h / surface->h);
+    reflectionRect.x = rect.x;
+    reflectionRect.y = rect.y;
+
+    switch(baseViewInfo.Reflection)
+    {
+    case ViewInfo::ReflectionTop:
+        reflectionRect.y = rect.y - reflectionRect.h - baseViewInfo.ReflectionDistance;
+        break;
+    case ViewInfo::ReflectionBottom:
+        reflectionRect.y = rect.y + rect.h + baseViewInfo.ReflectionDistance;
+        break;
+    case ViewInfo::ReflectionLeft:
+        reflectionRect.x = rect.x - reflectionRect.w - baseViewInfo.ReflectionDistance;
+        break;
+    case ViewInfo::ReflectionRight:
+        reflectionRect.x = rect.x + rect.w + baseViewInfo.ReflectionDistance;
+        break;
+    default:
+        return;
+    }
+
+    /* The reflection is not cropped, but turns with the image: rotate its
+       centre about the centre of the image by the same angle */
+    ViewInfo reflectionView;
+    reflectionView.Angle = baseViewInfo.Angle;
+    if(baseViewInfo.Angle != 0){
+        float radians = baseViewInfo.Angle * static_cast<float>(M_PI) / 180.0f;
+        float dx = (reflectionRect.x + reflectionRect.w / 2.0f) - (rect.x + rect.w / 2.0f);
+        float dy = (reflectionRect.y + reflectionRect.h / 2.0f) - (rect.y + rect.h / 2.0f);
+        float cx = rect.x + rect.w / 2.0f + dx * cosf(radians) - dy * sinf(radians);
+        float cy = rect.y + rect.h / 2.0f + dx * sinf(radians) + dy * cosf(radians);
+        reflectionRect.x = static_cast<Sint16>(floorf(cx - reflectionRect.w / 2.0f + 0.5f));
+        reflectionRect.y = static_cast<Sint16>(floorf(cy - reflectionRect.h / 2.0f + 0.5f));
     }
+    SDL::renderCopy(reflection_, baseViewInfo.Alpha, NULL, &reflectionRect, reflectionView);
 }
@@ -16,21 +16,33 @@
 #pragma once
 
 #include "Component.h"
+#include "../MipChain.h"
+#include "../../Utility/SurfaceBudget.h"
 #include <SDL/SDL.h>
 #include <string>
 
-class Image : public Component
+class Image : public Component, public SurfaceBudget::Client
 {
 public:
     Image(std::string file, std::string altFile, Page &p, float scaleX, float scaleY, bool dithering);
     virtual ~Image();
     void freeGraphicsMemory();
     void allocateGraphicsMemory();
+    void releaseSurfaces();
     void draw();
 
 protected:
+    void buildMips();
+    void accountSurfaces();
+    bool isOnScreen();
+    void drawReflection(SDL_Surface *surface, SDL_Rect &rect);
     SDL_Surface *texture_;
     SDL_Surface *texture_prescaled_;
+    SDL_Surface *reflection_;
+    SDL_Surface *reflectionSource_;
+    ViewInfo reflectionInfo_;
+    bool reflectionStale_;
+    MipChain mips_;
     std::string file_;
     std::string altFile_;
     float scaleX_;
@@ -38,4 +50,6 @@ protected:
     bool ditheringAuthorized_;
     bool needDithering_;
     int imgBitsPerPx_;
+    SurfaceBudget::Account account_;
+    bool evicted_;
 };
@@ -114,6 +114,18 @@ void ReloadableMedia::update(float dt)
 
 }
 
+float ReloadableMedia::getIdleTimeout()
+{
+    float timeout = Component::getIdleTimeout();
+
+    if(loadedComponent_)
+    {
+        timeout = earliestTimeout(timeout, loadedComponent_->getIdleTimeout());
+    }
+
+    return timeout;
+}
+
 void ReloadableMedia::allocateGraphicsMemory()
 {
     if(loadedComponent_)
@@ -137,6 +149,24 @@ void ReloadableMedia::freeGraphicsMemory()
 }
 
 
+void ReloadableMedia::suspendVideos()
+{
+    if(loadedComponent_)
+    {
+        loadedComponent_->suspendVideos();
+    }
+}
+
+
+void ReloadableMedia::resumeVideos()
+{
+    if(loadedComponent_)
+    {
+        loadedComponent_->resumeVideos();
+    }
+}
+
+
 void ReloadableMedia::reloadTexture()
 {
 	reloadTexture(false);
@@ -30,9 +30,12 @@ public:
     ReloadableMedia(Configuration &config, bool systemMode, bool layoutMode, bool commonMode, bool menuMode, std::string type, Page &page, int displayOffset, bool isVideo, Font *font, float scaleX, float scaleY, bool dithering);
     virtual ~ReloadableMedia();
     void update(float dt);
+    float getIdleTimeout();
     void draw();
     void freeGraphicsMemory();
     void allocateGraphicsMemory();
+    void suspendVideos();
+    void resumeVideos();
     Component *findComponent(std::string collection, std::string type, std::string basename, std::string filepath, bool systemMode);
 
     void enableImageAndText_(bool value);
@@ -128,6 +128,30 @@ void ReloadableScrollingText::update(float dt)
 }
 
 
+float ReloadableScrollingText::getIdleTimeout( )
+{
+    float timeout = Component::getIdleTimeout( );
+
+    if ( needScrolling_ )
+    {
+        if ( waitEndTime_ > 0 )
+        {
+            timeout = earliestTimeout( timeout, waitEndTime_ );
+        }
+        else if ( waitStartTime_ > 0 )
+        {
+            timeout = earliestTimeout( timeout, waitStartTime_ );
+        }
+        else
+        {
+            timeout = 0;
+        }
+    }
+
+    return timeout;
+}
+
+
 void ReloadableScrollingText::allocateGraphicsMemory( )
 {
     Component::allocateGraphicsMemory( );
@@ -612,25 +636,16 @@ void ReloadableScrollingText::draw( )
 	    }
         }
 
-        float oldWidth       = baseViewInfo.Width;
-        float oldHeight      = baseViewInfo.Height;
-        float oldImageWidth  = baseViewInfo.ImageHeight;
-        float oldImageHeight = baseViewInfo.ImageWidth;
+        ViewInfo textInfo    = baseViewInfo;
+        textInfo.Width       = imageWidth*scale;
+        textInfo.Height      = baseViewInfo.FontSize;
+        textInfo.ImageWidth  = imageWidth;
+        textInfo.ImageHeight = imageHeight;
 
-        baseViewInfo.Width       = imageWidth*scale;
-        baseViewInfo.Height      = baseViewInfo.FontSize;
-        baseViewInfo.ImageWidth  = imageWidth;
-        baseViewInfo.ImageHeight = imageHeight;
-
-        float xOrigin = baseViewInfo.XRelativeToOrigin( );
-        float yOrigin = baseViewInfo.YRelativeToOrigin( );
+        float xOrigin = textInfo.XRelativeToOrigin( );
+        float yOrigin = textInfo.YRelativeToOrigin( );
         //printf("IN SCROLLABLE_TEXT - xOrigin=%f, yOrigin=%f, imageWidth=%f\n", xOrigin, yOrigin, imageWidth);
 
-        baseViewInfo.Width       = oldWidth;
-        baseViewInfo.Height      = oldHeight;
-        baseViewInfo.ImageWidth  = oldImageWidth;
-        baseViewInfo.ImageHeight = oldImageHeight;
-
 
 
 
@@ -112,6 +112,7 @@ ScrollingList::~ScrollingList( )
 void ScrollingList::setItems( std::vector<Item *> *items )
 {
     items_ = items;
+    jumpIndex_.clear( );
     if ( items_ )
     {
         prevItemIndex_ = itemIndex_;
@@ -173,7 +174,7 @@ void ScrollingList::allocateSpritePoints( )
 
         Component *c = components_.at( i );
 
-        ViewInfo *view = scrollPoints_->at( i );
+        ViewInfo *view = &scrollPoints_->at( i );
 
         resetTweens( c, tweenPoints_->at( i ), view, view, 0 );
 
@@ -197,7 +198,7 @@ void ScrollingList::destroyItems( )
 }
 
 
-void ScrollingList::setPoints( std::vector<ViewInfo *> *scrollPoints, std::vector<AnimationEvents *> *tweenPoints )
+void ScrollingList::setPoints( std::vector<ViewInfo> *scrollPoints, std::vector<AnimationEvents *> *tweenPoints )
 {
     scrollPoints_ = scrollPoints;
     tweenPoints_  = tweenPoints;
@@ -326,54 +327,29 @@ void ScrollingList::letterDown( )
 
 void ScrollingList::letterChange( bool increment )
 {
+    jumpChange( increment, JumpIndex::LETTER );
+}
 
-    if ( !items_ || items_->size( ) == 0 ) return;
-
-    std::string startname = items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->lowercaseFullTitle( );
-
-    for ( unsigned int i = 0; i < items_->size( ); ++i )
-    {
-        unsigned int index = 0;
-        if ( increment )
-        {
-            index = loopIncrement( itemIndex_, i, items_->size( ) );
-        }
-        else
-        {
-            index = loopDecrement( itemIndex_, i, items_->size( ) );
-        }
 
-        std::string endname = items_->at( (index+selectedOffsetIndex_ ) % items_->size( ) )->lowercaseFullTitle( );
+// Jump to the first item of the next or previous group of items sharing a
+// first letter (or metadata attribute), wrapping around the list
+void ScrollingList::jumpChange( bool increment, JumpIndex::Attribute attribute )
+{
 
-        // check if we are changing characters from a-z, or changing from alpha character to non-alpha character
-        if ((isalpha(startname[0] ) ^ isalpha(endname[0] ) ) ||
-            (isalpha(startname[0] ) && isalpha(endname[0] ) && startname[0] != endname[0] ) )
-        {
-	    prevItemIndex_ = itemIndex_;
-            itemIndex_ = index;
-            break;
-        }
-    }
+    if ( !items_ || items_->size( ) == 0 ) return;
 
-    if ( !increment ) // For decrement, find the first game of the new letter
+    if ( !jumpIndex_.isBuilt( items_, attribute ) )
     {
-        startname = items_->at( (itemIndex_+selectedOffsetIndex_ ) % items_->size( ) )->lowercaseFullTitle( );
-
-        for ( unsigned int i = 0; i < items_->size( ); ++i )
-        {
-            unsigned int index = loopDecrement( itemIndex_, i, items_->size( ) );
+        jumpIndex_.build( *items_, attribute );
+    }
 
-            std::string endname = items_->at( (index+selectedOffsetIndex_ ) % items_->size( ) )->lowercaseFullTitle( );
+    unsigned int position = loopIncrement( itemIndex_, selectedOffsetIndex_, items_->size( ) );
+    unsigned int target   = increment ? jumpIndex_.next( position ) : jumpIndex_.previous( position );
 
-            // check if we are changing characters from a-z, or changing from alpha character to non-alpha character
-            if ((isalpha(startname[0] ) ^ isalpha(endname[0] ) ) ||
-                (isalpha(startname[0] ) && isalpha(endname[0] ) && startname[0] != endname[0] ) )
-            {
-	        prevItemIndex_ = itemIndex_;
-		itemIndex_ = loopIncrement( index,1,items_->size( ) );
-		break;
-            }
-        }
+    if ( target != position )
+    {
+        prevItemIndex_ = itemIndex_;
+        itemIndex_     = loopDecrement( target, selectedOffsetIndex_, items_->size( ) );
     }
 
 }
@@ -396,12 +372,32 @@ void ScrollingList::freeGraphicsMemory( )
     deallocateSpritePoints( );
 }
 
+
+void ScrollingList::suspendVideos( )
+{
+    for ( unsigned int i = 0; i < components_.size( ); ++i )
+    {
+        Component *c = components_.at( i );
+        if ( c ) c->suspendVideos( );
+    }
+}
+
+
+void ScrollingList::resumeVideos( )
+{
+    for ( unsigned int i = 0; i < components_.size( ); ++i )
+    {
+        Component *c = components_.at( i );
+        if ( c ) c->resumeVideos( );
+    }
+}
+
 void ScrollingList::triggerEnterEvent( )
 {
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         Component *c = components_.at( i );
-        if ( c ) c->triggerEvent( "enter" );
+        if ( c ) c->triggerEvent( EVENT_ENTER );
     }
 }
 
@@ -410,7 +406,7 @@ void ScrollingList::triggerExitEvent( )
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         Component *c = components_.at(i );
-        if ( c ) c->triggerEvent( "exit" );
+        if ( c ) c->triggerEvent( EVENT_EXIT );
     }
 }
 
@@ -419,7 +415,7 @@ void ScrollingList::triggerMenuEnterEvent( int menuIndex )
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         Component *c = components_.at( i );
-        if ( c ) c->triggerEvent( "menuEnter", menuIndex );
+        if ( c ) c->triggerEvent( EVENT_MENU_ENTER, menuIndex );
     }
 }
 
@@ -428,7 +424,7 @@ void ScrollingList::triggerMenuExitEvent( int menuIndex )
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         Component *c = components_.at( i );
-        if ( c ) c->triggerEvent( "menuExit", menuIndex );
+        if ( c ) c->triggerEvent( EVENT_MENU_EXIT, menuIndex );
     }
 }
 
@@ -437,7 +433,7 @@ void ScrollingList::triggerGameEnterEvent( int menuIndex )
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         Component *c = components_.at( i );
-        if ( c ) c->triggerEvent( "gameEnter", menuIndex );
+        if ( c ) c->triggerEvent( EVENT_GAME_ENTER, menuIndex );
     }
 }
 
@@ -446,7 +442,7 @@ void ScrollingList::triggerGameExitEvent( int menuIndex )
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         Component *c = components_.at( i );
-        if ( c ) c->triggerEvent( "gameExit", menuIndex );
+        if ( c ) c->triggerEvent( EVENT_GAME_EXIT, menuIndex );
     }
 }
 
@@ -455,7 +451,7 @@ void ScrollingList::triggerHighlightEnterEvent( int menuIndex )
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         Component *c = components_.at( i );
-        if ( c ) c->triggerEvent( "highlightEnter", menuIndex );
+        if ( c ) c->triggerEvent( EVENT_HIGHLIGHT_ENTER, menuIndex );
     }
 }
 
@@ -464,7 +460,7 @@ void ScrollingList::triggerHighlightExitEvent( int menuIndex )
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         Component *c = components_.at( i );
-        if ( c ) c->triggerEvent( "highlightExit", menuIndex );
+        if ( c ) c->triggerEvent( EVENT_HIGHLIGHT_EXIT, menuIndex );
     }
 }
 
@@ -473,7 +469,7 @@ void ScrollingList::triggerPlaylistEnterEvent( int menuIndex )
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         Component *c = components_.at( i );
-        if ( c ) c->triggerEvent( "playlistEnter", menuIndex );
+        if ( c ) c->triggerEvent( EVENT_PLAYLIST_ENTER, menuIndex );
     }
 }
 
@@ -482,7 +478,7 @@ void ScrollingList::triggerPlaylistExitEvent( int menuIndex )
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         Component *c = components_.at( i );
-        if ( c ) c->triggerEvent( "playlistExit", menuIndex );
+        if ( c ) c->triggerEvent( EVENT_PLAYLIST_EXIT, menuIndex );
     }
 }
 
@@ -491,7 +487,7 @@ void ScrollingList::triggerMenuJumpEnterEvent( int menuIndex )
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         Component *c = components_.at( i );
-        if ( c ) c->triggerEvent( "menuJumpEnter", menuIndex );
+        if ( c ) c->triggerEvent( EVENT_MENU_JUMP_ENTER, menuIndex );
     }
 }
 
@@ -500,7 +496,7 @@ void ScrollingList::triggerMenuJumpExitEvent( int menuIndex )
     for ( unsigned int i = 0; i < components_.size( ); ++i )
     {
         Component *c = components_.at( i );
-        if ( c ) c->triggerEvent( "menuJumpExit", menuIndex );
+        if ( c ) c->triggerEvent( EVENT_MENU_JUMP_EXIT, menuIndex );
     }
 }
 
@@ -527,6 +523,20 @@ void ScrollingList::update( float dt )
 }
 
 
+float ScrollingList::getIdleTimeout( )
+{
+    float timeout = Component::getIdleTimeout( );
+
+    for ( unsigned int i = 0; i < components_.size( ); i++ )
+    {
+        Component *c = components_.at( i );
+        if ( c ) timeout = earliestTimeout( timeout, c->getIdleTimeout( ) );
+    }
+
+    return timeout;
+}
+
+
 unsigned int ScrollingList::getSelectedIndex( )
 {
     if ( !items_ ) return 0;
@@ -571,7 +581,7 @@ void ScrollingList::resetTweens( Component *c, AnimationEvents *sets, ViewInfo *
 
     c->setTweens(sets );
 
-    Animation *scrollTween = sets->getAnimation("menuScroll" );
+    Animation *scrollTween = sets->getAnimation(EVENT_MENU_SCROLL );
     scrollTween->Clear( );
     c->baseViewInfo = *currentViewInfo;
 
@@ -842,9 +852,9 @@ void ScrollingList::updateScrollPeriod(  )
 
 	    Component *c = components_.at( i );
 
-	    resetTweens( c, tweenPoints_->at( nextI ), scrollPoints_->at( i ), scrollPoints_->at( nextI ), scrollPeriod_ );
-	    c->baseViewInfo.font = scrollPoints_->at( nextI )->font; // Use the font settings of the next index
-	    c->triggerEvent( "menuFastScroll" );
+	    resetTweens( c, tweenPoints_->at( nextI ), &scrollPoints_->at( i ), &scrollPoints_->at( nextI ), scrollPeriod_ );
+	    c->baseViewInfo.font = scrollPoints_->at( nextI ).font; // Use the font settings of the next index
+	    c->triggerEvent( EVENT_MENU_FAST_SCROLL );
 	}
     }
 #endif
@@ -892,11 +902,11 @@ void ScrollingList::scroll( bool forward )
 
         Component *c = components_.at( i );
 
-        resetTweens( c, tweenPoints_->at( nextI ), scrollPoints_->at( i ), scrollPoints_->at( nextI ), scrollPeriod_ );
-        c->baseViewInfo.font = scrollPoints_->at( nextI )->font; // Use the font settings of the next index
-        c->triggerEvent(  forward?"menuScrollNext":"menuScrollPrev" );
+        resetTweens( c, tweenPoints_->at( nextI ), &scrollPoints_->at( i ), &scrollPoints_->at( nextI ), scrollPeriod_ );
+        c->baseViewInfo.font = scrollPoints_->at( nextI ).font; // Use the font settings of the next index
+        c->triggerEvent(  forward?EVENT_MENU_SCROLL_NEXT:EVENT_MENU_SCROLL_PREV );
         c->update(0);
-        c->triggerEvent(  "menuScroll" );
+        c->triggerEvent(  EVENT_MENU_SCROLL );
     }
 
     // Reorder the components
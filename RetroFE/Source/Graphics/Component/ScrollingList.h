@@ -21,6 +21,7 @@
 #include "../Animate/Tween.h"
 #include "../Page.h"
 #include "../ViewInfo.h"
+#include "../../Collection/JumpIndex.h"
 #include "../../Database/Configuration.h"
 #include <SDL/SDL.h>
 
@@ -63,7 +64,7 @@ public:
     void deallocateTexture( unsigned int index );
     void setItems( std::vector<Item *> *items );
     void destroyItems( );
-    void setPoints( std::vector<ViewInfo *> *scrollPoints, std::vector<AnimationEvents *> *tweenPoints );
+    void setPoints( std::vector<ViewInfo> *scrollPoints, std::vector<AnimationEvents *> *tweenPoints );
     unsigned int getSelectedIndex( );
     unsigned int getPreviousSelectedIndex( );
     void setSelectedIndex( unsigned int index );
@@ -73,6 +74,7 @@ public:
     void letterUp( );
     void letterDown( );
     void letterChange( bool increment );
+    void jumpChange( bool increment, JumpIndex::Attribute attribute );
     void random( );
     bool isIdle( );
     bool getScrollDirectionForward( );
@@ -85,7 +87,10 @@ public:
     Item *getSelectedItem( );
     void allocateGraphicsMemory( );
     void freeGraphicsMemory( );
+    void suspendVideos( );
+    void resumeVideos( );
     void update( float dt );
+    float getIdleTimeout( );
     void draw( );
     void draw( unsigned int layer );
     void setScrollAcceleration( float value );
@@ -106,7 +111,7 @@ private:
     bool layoutMode_;
     bool commonMode_;
     std::vector<Component *> *spriteList_;
-    std::vector<ViewInfo *> *scrollPoints_;
+    std::vector<ViewInfo> *scrollPoints_;
     std::vector<AnimationEvents *> *tweenPoints_;
 
     unsigned int itemIndex_;
@@ -128,6 +133,7 @@ private:
     bool 			ditheringAuthorized_;
 
     std::vector<Item *>     *items_;
+    JumpIndex                jumpIndex_;
     std::vector<Component *> components_;
 
 };
@@ -134,26 +134,18 @@ void Text::draw( )
         }
     }
 
-    float oldWidth       = baseViewInfo.Width;
-    float oldHeight      = baseViewInfo.Height;
-    float oldImageWidth  = baseViewInfo.ImageHeight;
-    float oldImageHeight = baseViewInfo.ImageWidth;
+    // Place the rendered text on a copy so baseViewInfo is left untouched
+    ViewInfo textInfo    = baseViewInfo;
+    textInfo.Width       = imageWidth*scale;
+    textInfo.Height      = baseViewInfo.FontSize;
+    textInfo.ImageWidth  = imageWidth;
+    textInfo.ImageHeight = imageHeight;
 
-    baseViewInfo.Width       = imageWidth*scale;
-    baseViewInfo.Height      = baseViewInfo.FontSize;
-    baseViewInfo.ImageWidth  = imageWidth;
-    baseViewInfo.ImageHeight = imageHeight;
-
-    float xOrigin = baseViewInfo.XRelativeToOrigin( );
-    float yOrigin = baseViewInfo.YRelativeToOrigin( );
+    float xOrigin = textInfo.XRelativeToOrigin( );
+    float yOrigin = textInfo.YRelativeToOrigin( );
 
     //printf("IN TEXT %s - xOrigin=%f, yOrigin=%f\n",textData_.c_str(), xOrigin, yOrigin);
 
-    baseViewInfo.Width       = oldWidth;
-    baseViewInfo.Height      = oldHeight;
-    baseViewInfo.ImageWidth  = oldImageWidth;
-    baseViewInfo.ImageHeight = oldImageHeight;
-
 
     SDL_Rect rect;
     rect.x = static_cast<int>( xOrigin );
@@ -113,6 +113,24 @@ void Video::allocateGraphicsMemory( )
 }
 
 
+void Video::suspendVideos( )
+{
+    if (video_)
+    {
+        video_->suspendVideos( );
+    }
+}
+
+
+void Video::resumeVideos( )
+{
+    if (video_)
+    {
+        video_->resumeVideos( );
+    }
+}
+
+
 void Video::draw( )
 {
     Component::draw( );
@@ -126,6 +144,19 @@ void Video::draw( )
 }
 
 
+float Video::getIdleTimeout( )
+{
+    float timeout = Component::getIdleTimeout( );
+
+    if (video_)
+    {
+        timeout = earliestTimeout( timeout, video_->getIdleTimeout( ) );
+    }
+
+    return timeout;
+}
+
+
 bool Video::isPlaying( )
 {
     if (video_)
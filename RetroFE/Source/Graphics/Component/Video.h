@@ -28,8 +28,11 @@ public:
     void update(float dt);
     void freeGraphicsMemory( );
     void allocateGraphicsMemory( );
+    void suspendVideos( );
+    void resumeVideos( );
     void draw( );
     virtual bool isPlaying( );
+    float getIdleTimeout( );
 
 protected:
     Component  *video_;
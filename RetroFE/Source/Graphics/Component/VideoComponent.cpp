@@ -21,6 +21,8 @@
 #include "../../Video/GStreamerVideo.h"
 #include "../../SDL.h"
 
+float VideoComponent::startDelay_ = 0;
+
 VideoComponent::VideoComponent(IVideo *videoInst, Page &p, std::string videoFile, float scaleX, float scaleY)
     : Component(p)
     , videoFile_(videoFile)
@@ -28,6 +30,9 @@ VideoComponent::VideoComponent(IVideo *videoInst, Page &p, std::string videoFile
     , scaleX_(scaleX)
     , scaleY_(scaleY)
     , isPlaying_(false)
+    , isPaused_(false)
+    , startPending_(false)
+    , startElapsed_(0)
 {
 //   AllocateGraphicsMemory();
 }
@@ -42,14 +47,42 @@ VideoComponent::~VideoComponent()
     }
 }
 
+void VideoComponent::setStartDelay(float seconds)
+{
+    startDelay_ = seconds;
+}
+
 void VideoComponent::update(float dt)
 {
-    if (videoInst_)
+    bool scrolling = page.isMenuScrolling();
+
+    if(startPending_)
+    {
+        // the countdown restarts while the menu moves, so only a settled selection starts decoding
+        startElapsed_ = scrolling ? 0 : startElapsed_ + dt;
+        if(startElapsed_ >= startDelay_)
+        {
+            startPlayback();
+        }
+    }
+
+    if (videoInst_ && !startPending_)
     {
         isPlaying_ = ((GStreamerVideo *)(videoInst_))->isPlaying();
     }
     if(isPlaying_)
     {
+        // leave the CPU to the scroll animation and pick up where we left off afterwards
+        if(scrolling && !isPaused_)
+        {
+            isPaused_ = videoInst_->pause();
+        }
+        else if(!scrolling && isPaused_)
+        {
+            videoInst_->resume();
+            isPaused_ = false;
+        }
+
         videoInst_->update(dt);
 
         // video needs to run a frame to start getting size info
@@ -70,35 +103,81 @@ void VideoComponent::allocateGraphicsMemory()
 
     if(!isPlaying_)
     {
-        isPlaying_ = videoInst_->play(videoFile_);
+        if(startDelay_ > 0)
+        {
+            startPending_ = true;
+            startElapsed_ = 0;
+        }
+        else
+        {
+            startPlayback();
+        }
     }
 }
 
+void VideoComponent::startPlayback()
+{
+    startPending_ = false;
+    videoInst_->setDecodeLimits(page.getVideoMaxWidth(), page.getVideoMaxHeight(), page.getVideoMaxFrameRate());
+    isPlaying_ = videoInst_->play(videoFile_);
+}
+
 void VideoComponent::freeGraphicsMemory()
 {
     videoInst_->stop();
     isPlaying_ = false;
+    isPaused_ = false;
+    startPending_ = false;
 
     Component::freeGraphicsMemory();
 }
 
+void VideoComponent::suspendVideos()
+{
+    freeGraphicsMemory();
+}
+
+void VideoComponent::resumeVideos()
+{
+    allocateGraphicsMemory();
+}
+
 
 void VideoComponent::draw()
 {
     SDL_Rect rect;
 
-    rect.x = static_cast<int>(baseViewInfo.XRelativeToOrigin());
-    rect.y = static_cast<int>(baseViewInfo.YRelativeToOrigin());
-    rect.h = static_cast<int>(baseViewInfo.ScaledHeight());
-    rect.w = static_cast<int>(baseViewInfo.ScaledWidth());
+    float x, y, width, height;
+    baseViewInfo.Bounds(x, y, width, height);
+    rect.x = static_cast<int>(x);
+    rect.y = static_cast<int>(y);
+    rect.h = static_cast<int>(height);
+    rect.w = static_cast<int>(width);
 
-    videoInst_->draw();
-    /*SDL_Texture *texture = videoInst_->getTexture();
+    // the frame is converted at the size it is drawn, so renderCopy does not need to zoom it
+    SDL_Surface *texture = videoInst_->getTexture(rect.w, rect.h);
 
     if(texture)
     {
         SDL::renderCopy(texture, baseViewInfo.Alpha, NULL, &rect, baseViewInfo);
-    }*/
+    }
+}
+
+float VideoComponent::getIdleTimeout()
+{
+    float timeout = Component::getIdleTimeout();
+
+    if(isPlaying_)
+    {
+        timeout = 0;
+    }
+    else if(startPending_)
+    {
+        float start = startDelay_ - startElapsed_;
+        timeout = earliestTimeout(timeout, (start > 0) ? start : 0);
+    }
+
+    return timeout;
 }
 
 bool VideoComponent::isPlaying()
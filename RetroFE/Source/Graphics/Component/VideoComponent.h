@@ -31,13 +31,23 @@ public:
     void draw();
     void freeGraphicsMemory();
     void allocateGraphicsMemory();
+    void suspendVideos();
+    void resumeVideos();
     virtual bool isPlaying();
+    float getIdleTimeout();
+    static void setStartDelay(float seconds);
 
 private:
+    void startPlayback();
+
     std::string videoFile_;
     std::string name_;
     IVideo *videoInst_;
     float scaleX_;
     float scaleY_;
     bool isPlaying_;
+    bool isPaused_;
+    bool startPending_;
+    float startElapsed_;
+    static float startDelay_;
 };
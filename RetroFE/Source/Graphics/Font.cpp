@@ -15,12 +15,14 @@
  */
 #include "Font.h"
 #include "../SDL.h"
+#include "SurfaceSnapshot.h"
 #include "../Utility/Log.h"
 #include <SDL/SDL.h>
 #include <SDL/SDL_ttf.h>
 //#include <SDL/SDL_gfxBlitFunc.h>
 #include <cstdio>
 #include <cstring>
+#include <sstream>
 
 Font::Font(std::string fontPath, int fontSize, SDL_Color color)
     : texture(NULL)
@@ -33,6 +35,7 @@ Font::Font(std::string fontPath, int fontSize, SDL_Color color)
 Font::~Font()
 {
     deInitialize();
+    clearAtlas();
 }
 
 SDL_Surface *Font::getTexture()
@@ -66,6 +69,23 @@ bool Font::getRect(unsigned int charCode, GlyphInfo &glyph)
 
 bool Font::initialize()
 {
+    if(texture)
+    {
+        return true;
+    }
+
+    // the glyph metrics survive a launch snapshot, only the atlas is restored
+    if(!atlas.empty())
+    {
+        texture = SurfaceSnapshot::restore(snapshotKey());
+        if(texture)
+        {
+            account_.set(SurfaceBudget::CategoryText, SDL::surfaceBytes(texture));
+            return true;
+        }
+        clearAtlas();
+    }
+
     TTF_Font *font = TTF_OpenFont(fontPath_.c_str(), fontSize_);
 
     if (!font)
@@ -165,6 +185,7 @@ bool Font::initialize()
     SDL_UnlockMutex(SDL::getMutex());*/
 
     TTF_CloseFont(font);
+    account_.set(SurfaceBudget::CategoryText, SDL::surfaceBytes(texture));
 
     return true;
 }
@@ -176,12 +197,22 @@ void Font::deInitialize()
     if(texture)
     {
         SDL_LockMutex(SDL::getMutex());
+        SurfaceSnapshot::store(snapshotKey(), texture);
         //SDL_DestroyTexture(texture);
         SDL_FreeSurface(texture);
         texture = NULL;
+        account_.set(SurfaceBudget::CategoryText, 0);
         SDL_UnlockMutex(SDL::getMutex());
     }
 
+    if(!SurfaceSnapshot::isCapturing())
+    {
+        clearAtlas();
+    }
+}
+
+void Font::clearAtlas()
+{
     std::map<unsigned int, GlyphInfoBuild *>::iterator atlasIt = atlas.begin();
     while(atlasIt != atlas.end())
     {
@@ -189,7 +220,13 @@ void Font::deInitialize()
         atlas.erase(atlasIt);
         atlasIt = atlas.begin();
     }
+}
 
+std::string Font::snapshotKey()
+{
+    std::stringstream ss;
+    ss << fontPath_ << "\n" << fontSize_ << "\n" << static_cast<int>(color_.r) << "," << static_cast<int>(color_.g) << "," << static_cast<int>(color_.b);
+    return ss.str();
 }
 
 
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "../Utility/SurfaceBudget.h"
 #include <SDL/SDL.h>
 #include <map>
 #include <string>
@@ -43,6 +44,9 @@ public:
     int getAscent();
 
 private:
+    void clearAtlas();
+    std::string snapshotKey();
+
     struct GlyphInfoBuild
     {
         Font::GlyphInfo glyph;
@@ -51,6 +55,7 @@ private:
 
     //SDL_Texture *texture;
     SDL_Surface *texture;
+    SurfaceBudget::Account account_;
     int height;
     int ascent;
     std::map<unsigned int, GlyphInfoBuild *> atlas;
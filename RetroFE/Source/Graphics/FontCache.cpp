@@ -61,11 +61,46 @@ Font *FontCache::getFont(std::string fontPath, int fontSize, SDL_Color color)
     if(it != fontFaceMap_.end())
     {
         t = it->second;
+        usedFonts_.insert(it->first);
     }
 
     return t;
 }
 
+// Start tracking which fonts are handed out, e.g. before rebuilding pages.
+void FontCache::markUnused()
+{
+    usedFonts_.clear();
+}
+
+// Delete every font nobody asked for since the last markUnused(). Only call
+// this once all pages which could still hold the fonts have been destroyed.
+void FontCache::purgeUnused()
+{
+    unsigned int purged = 0;
+    std::map<std::string, Font *>::iterator it = fontFaceMap_.begin();
+    while(it != fontFaceMap_.end())
+    {
+        if(usedFonts_.find(it->first) == usedFonts_.end())
+        {
+            delete it->second;
+            fontFaceMap_.erase(it++);
+            purged++;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if(purged > 0)
+    {
+        std::stringstream ss;
+        ss << "Released " << purged << " unused fonts, " << fontFaceMap_.size() << " still loaded";
+        Logger::write(Logger::ZONE_DEBUG, "FontCache", ss.str());
+    }
+}
+
 std::string FontCache::buildFontKey(std::string font, int fontSize, SDL_Color color)
 {
     std::stringstream ss;
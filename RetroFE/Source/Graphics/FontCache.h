@@ -18,6 +18,7 @@
 #include "Font.h"
 #include <string>
 #include <map>
+#include <set>
 
 class FontCache
 {
@@ -27,10 +28,13 @@ public:
     void deInitialize();
     bool loadFont(std::string font, int fontSize, SDL_Color color);
     Font *getFont(std::string font, int fontSize, SDL_Color color);
+    void markUnused();
+    void purgeUnused();
 
     virtual ~FontCache();
 private:
     std::map<std::string, Font *> fontFaceMap_;
+    std::set<std::string> usedFonts_;
     std::string buildFontKey(std::string font, int fontSize, SDL_Color color);
 
 };
@@ -0,0 +1,155 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "FrameCapture.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <zlib.h>
+
+uint64_t FrameCapture::checksum(const Frame &frame)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    for(int y = 0; y < frame.height; ++y)
+    {
+        const uint32_t *row = reinterpret_cast<const uint32_t *>(frame.pixels + y * frame.pitch);
+        for(int x = 0; x < frame.width; ++x)
+        {
+            uint32_t pixel = row[x];
+            hash = (hash ^ ((pixel >> frame.rShift) & 0xff)) * 1099511628211ULL;
+            hash = (hash ^ ((pixel >> frame.gShift) & 0xff)) * 1099511628211ULL;
+            hash = (hash ^ ((pixel >> frame.bShift) & 0xff)) * 1099511628211ULL;
+        }
+    }
+
+    return hash;
+}
+
+
+std::string FrameCapture::checksumString(uint64_t checksum)
+{
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(checksum));
+    return buffer;
+}
+
+
+void FrameCapture::encodeRaw(const Frame &frame, std::vector<uint8_t> &out)
+{
+    out.resize(static_cast<size_t>(frame.width) * frame.height * 3);
+    uint8_t *dst = out.data();
+
+    for(int y = 0; y < frame.height; ++y)
+    {
+        const uint32_t *row = reinterpret_cast<const uint32_t *>(frame.pixels + y * frame.pitch);
+        for(int x = 0; x < frame.width; ++x)
+        {
+            uint32_t pixel = row[x];
+            *dst++ = static_cast<uint8_t>(pixel >> frame.rShift);
+            *dst++ = static_cast<uint8_t>(pixel >> frame.gShift);
+            *dst++ = static_cast<uint8_t>(pixel >> frame.bShift);
+        }
+    }
+}
+
+
+bool FrameCapture::encodePng(const Frame &frame, std::vector<uint8_t> &out)
+{
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+    // every scanline is prefixed with filter type 0 (none)
+    size_t stride = static_cast<size_t>(frame.width) * 3;
+    std::vector<uint8_t> rgb;
+    encodeRaw(frame, rgb);
+    std::vector<uint8_t> scanlines((stride + 1) * frame.height);
+    for(int y = 0; y < frame.height; ++y)
+    {
+        scanlines[y * (stride + 1)] = 0;
+        std::copy(rgb.begin() + y * stride, rgb.begin() + (y + 1) * stride, scanlines.begin() + y * (stride + 1) + 1);
+    }
+
+    uLongf compressedSize = compressBound(static_cast<uLong>(scanlines.size()));
+    std::vector<uint8_t> compressed(compressedSize);
+    if(compress2(compressed.data(), &compressedSize, scanlines.data(), static_cast<uLong>(scanlines.size()), Z_BEST_SPEED) != Z_OK)
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> header;
+    appendUint32(header, static_cast<uint32_t>(frame.width));
+    appendUint32(header, static_cast<uint32_t>(frame.height));
+    header.push_back(8);    // bit depth
+    header.push_back(2);    // colour type: truecolour
+    header.push_back(0);    // deflate
+    header.push_back(0);    // adaptive filtering
+    header.push_back(0);    // no interlace
+
+    out.assign(signature, signature + sizeof(signature));
+    appendChunk(out, "IHDR", header.data(), header.size());
+    appendChunk(out, "IDAT", compressed.data(), compressedSize);
+    appendChunk(out, "IEND", NULL, 0);
+    return true;
+}
+
+
+bool FrameCapture::write(const std::string &path, const Frame &frame, Format format)
+{
+    std::vector<uint8_t> data;
+
+    if(format == FormatPng)
+    {
+        if(!encodePng(frame, data))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        encodeRaw(frame, data);
+    }
+
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    if(!file.good())
+    {
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(data.data()), data.size());
+    return file.good();
+}
+
+
+void FrameCapture::appendChunk(std::vector<uint8_t> &out, const char *type, const uint8_t *data, size_t size)
+{
+    appendUint32(out, static_cast<uint32_t>(size));
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    if(size > 0)
+    {
+        out.insert(out.end(), data, data + size);
+    }
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, out.data() + start, static_cast<uInt>(out.size() - start));
+    appendUint32(out, static_cast<uint32_t>(crc));
+}
+
+
+void FrameCapture::appendUint32(std::vector<uint8_t> &out, uint32_t value)
+{
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
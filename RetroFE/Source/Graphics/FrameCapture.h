@@ -0,0 +1,59 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Encodes rendered frames for regression tests and benchmarks. A frame is a
+// 32bpp pixel buffer whose channel positions are given by shifts, so the
+// window's native format can be passed in without conversion. Checksums and
+// dumps are computed over the RGB bytes in that order, which makes them
+// independent of the pixel format and of row padding.
+class FrameCapture
+{
+public:
+    enum Format
+    {
+        FormatPng,
+        FormatRaw
+    };
+
+    struct Frame
+    {
+        const uint8_t *pixels;
+        int width;
+        int height;
+        int pitch;
+        int rShift;
+        int gShift;
+        int bShift;
+    };
+
+    // 64 bit FNV-1a hash of the frame's RGB bytes.
+    static uint64_t checksum(const Frame &frame);
+    static std::string checksumString(uint64_t checksum);
+
+    // Raw dumps are tightly packed 24 bit RGB rows, top to bottom.
+    static void encodeRaw(const Frame &frame, std::vector<uint8_t> &out);
+    static bool encodePng(const Frame &frame, std::vector<uint8_t> &out);
+    static bool write(const std::string &path, const Frame &frame, Format format);
+
+private:
+    static void appendChunk(std::vector<uint8_t> &out, const char *type, const uint8_t *data, size_t size);
+    static void appendUint32(std::vector<uint8_t> &out, uint32_t value);
+};
@@ -0,0 +1,239 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MipChain.h"
+#include <algorithm>
+
+std::deque<MipChain *> MipChain::queue_;
+MipChain *MipChain::current_ = NULL;
+std::mutex MipChain::mutex_;
+std::condition_variable MipChain::wakeup_;
+std::condition_variable MipChain::done_;
+std::thread MipChain::thread_;
+bool MipChain::stop_    = false;
+bool MipChain::enabled_ = true;
+const int MipChain::STRIP_ROWS;
+
+
+MipChain::MipChain()
+    : ready_(0)
+    , cancelled_(false)
+    , queued_(false)
+{
+    source_.pixels = NULL;
+    source_.pitch  = 0;
+    source_.width  = 0;
+    source_.height = 0;
+}
+
+
+MipChain::~MipChain()
+{
+    reset();
+}
+
+
+// Queues the levels of source down to minSize pixels. The source pixels
+// must stay valid until reset() (or the destructor) returns.
+void MipChain::build(const Resampler::Image &source, int minSize)
+{
+    reset();
+    if(!enabled_ || !source.pixels)
+    {
+        return;
+    }
+
+    // sizes are fixed up front so the worker never reallocates levels_
+    int width  = source.width / 2;
+    int height = source.height / 2;
+    while(width >= minSize && height >= minSize)
+    {
+        Level level;
+        level.width  = width;
+        level.height = height;
+        levels_.push_back(level);
+        width  /= 2;
+        height /= 2;
+    }
+    if(levels_.empty())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    source_ = source;
+    queued_ = true;
+    queue_.push_back(this);
+    if(!thread_.joinable())
+    {
+        stop_   = false;
+        thread_ = std::thread(worker);
+    }
+    wakeup_.notify_one();
+}
+
+
+// Drops the levels. A queued build is dequeued; one in progress is cancelled
+// and stops after the strip of rows it is filtering, so this never waits for
+// a whole level.
+void MipChain::reset()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if(queued_)
+        {
+            queue_.erase(std::remove(queue_.begin(), queue_.end(), this), queue_.end());
+            queued_ = false;
+        }
+        if(current_ == this)
+        {
+            cancelled_ = true;
+            done_.wait(lock, [this]() { return current_ != this; });
+            cancelled_ = false;
+        }
+    }
+
+    ready_ = 0;
+    levels_.clear();
+    source_.pixels = NULL;
+}
+
+
+// The smallest finished level still at least width x height, or the source.
+Resampler::Image MipChain::nearest(int width, int height)
+{
+    Resampler::Image image = source_;
+    int ready = ready_.load(std::memory_order_acquire);
+
+    for(int i = 0; i < ready; ++i)
+    {
+        if(levels_[i].width < width || levels_[i].height < height)
+        {
+            break;
+        }
+        image.pixels = &levels_[i].pixels[0];
+        image.pitch  = levels_[i].width * 4;
+        image.width  = levels_[i].width;
+        image.height = levels_[i].height;
+    }
+
+    return image;
+}
+
+
+int MipChain::levels() const
+{
+    return ready_.load(std::memory_order_acquire);
+}
+
+
+// Memory of all queued levels, finished or not.
+size_t MipChain::bytes() const
+{
+    size_t bytes = 0;
+    for(unsigned int i = 0; i < levels_.size(); ++i)
+    {
+        bytes += static_cast<size_t>(levels_[i].width) * levels_[i].height * 4;
+    }
+    return bytes;
+}
+
+
+void MipChain::setEnabled(bool enabled)
+{
+    enabled_ = enabled;
+}
+
+
+// Blocks until every queued chain has been built.
+void MipChain::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, []() { return queue_.empty() && current_ == NULL; });
+}
+
+
+void MipChain::shutdown()
+{
+    if(thread_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            for(std::deque<MipChain *>::iterator it = queue_.begin(); it != queue_.end(); ++it)
+            {
+                (*it)->queued_ = false;
+            }
+            queue_.clear();
+        }
+        wakeup_.notify_one();
+        thread_.join();
+    }
+}
+
+
+// Each level is filtered from the previous one, a strip of rows at a time
+// so that reset() can cancel the build quickly.
+void MipChain::generate()
+{
+    Resampler::Image previous = source_;
+
+    for(unsigned int i = 0; i < levels_.size(); ++i)
+    {
+        Level &level = levels_[i];
+        level.pixels.resize(level.width * level.height);
+        for(int y = 0; y < level.height; y += STRIP_ROWS)
+        {
+            if(cancelled_.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+            Resampler::scale(previous, level.width, level.height, &level.pixels[y * level.width], level.width * 4,
+                             0, y, level.width, std::min(STRIP_ROWS, level.height - y));
+        }
+        ready_.store(i + 1, std::memory_order_release);
+
+        previous.pixels = &level.pixels[0];
+        previous.pitch  = level.width * 4;
+        previous.width  = level.width;
+        previous.height = level.height;
+    }
+}
+
+
+void MipChain::worker()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(!stop_)
+    {
+        if(queue_.empty())
+        {
+            wakeup_.wait(lock);
+            continue;
+        }
+
+        current_ = queue_.front();
+        queue_.pop_front();
+        current_->queued_ = false;
+
+        lock.unlock();
+        current_->generate();
+        lock.lock();
+
+        current_ = NULL;
+        done_.notify_all();
+    }
+}
@@ -0,0 +1,75 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Resampler.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+// Half size copies of a 32bpp image, built on a background thread shared by
+// all chains. Drawing an image at a size that changes every frame (tweens)
+// resamples the nearest level instead of the full size source. Levels only
+// become visible once complete, so nearest() never waits.
+class MipChain
+{
+public:
+    struct Level
+    {
+        int                   width;
+        int                   height;
+        std::vector<uint32_t> pixels;
+    };
+
+    MipChain();
+    virtual ~MipChain();
+    void build(const Resampler::Image &source, int minSize = 32);
+    void reset();
+    Resampler::Image nearest(int width, int height);
+    int levels() const;
+    size_t bytes() const;
+    static void setEnabled(bool enabled);
+    static void wait();
+    static void shutdown();
+
+private:
+    MipChain(const MipChain &);
+    MipChain &operator=(const MipChain &);
+
+    void generate();
+    static void worker();
+
+    Resampler::Image   source_;
+    std::vector<Level> levels_;
+    std::atomic<int>   ready_;
+    std::atomic<bool>  cancelled_;
+    bool               queued_;
+
+    static const int STRIP_ROWS = 16;
+
+    static std::deque<MipChain *> queue_;
+    static MipChain *current_;
+    static std::mutex mutex_;
+    static std::condition_variable wakeup_;
+    static std::condition_variable done_;
+    static std::thread thread_;
+    static bool stop_;
+    static bool enabled_;
+};
@@ -40,6 +40,9 @@ Page::Page(Configuration &config)
     , highlightSoundChunk_(NULL)
     , selectSoundChunk_(NULL)
     , minShowTime_(0)
+    , videoMaxWidth_(0)
+    , videoMaxHeight_(0)
+    , videoMaxFrameRate_(0)
 {
 }
 
@@ -310,7 +313,7 @@ void Page::start()
         for(std::vector<ScrollingList *>::iterator it2 = menus_[std::distance(menus_.begin(), it)].begin(); it2 != menus_[std::distance(menus_.begin(), it)].end(); it2++)
         {
             ScrollingList *menu = *it2;
-            menu->triggerEvent( "enter" );
+            menu->triggerEvent( EVENT_ENTER );
             menu->triggerEnterEvent();
         }
     }
@@ -322,7 +325,7 @@ void Page::start()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( "enter" );
+        (*it)->triggerEvent( EVENT_ENTER );
     }
 }
 
@@ -334,7 +337,7 @@ void Page::stop()
         for(std::vector<ScrollingList *>::iterator it2 = menus_[std::distance(menus_.begin(), it)].begin(); it2 != menus_[std::distance(menus_.begin(), it)].end(); it2++)
         {
             ScrollingList *menu = *it2;
-            menu->triggerEvent( "exit" );
+            menu->triggerEvent( EVENT_EXIT );
             menu->triggerExitEvent();
         }
     }
@@ -346,7 +349,7 @@ void Page::stop()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( "exit" );
+        (*it)->triggerEvent( EVENT_EXIT );
     }
 }
 
@@ -421,6 +424,32 @@ float Page::getMinShowTime()
 }
 
 
+void Page::setVideoLimits(int maxWidth, int maxHeight, int maxFrameRate)
+{
+    videoMaxWidth_     = maxWidth;
+    videoMaxHeight_    = maxHeight;
+    videoMaxFrameRate_ = maxFrameRate;
+}
+
+
+int Page::getVideoMaxWidth()
+{
+    return videoMaxWidth_;
+}
+
+
+int Page::getVideoMaxHeight()
+{
+    return videoMaxHeight_;
+}
+
+
+int Page::getVideoMaxFrameRate()
+{
+    return videoMaxFrameRate_;
+}
+
+
 void Page::playlistChange()
 {
     for(std::vector<ScrollingList *>::iterator it = activeMenu_.begin(); it != activeMenu_.end(); it++)
@@ -444,9 +473,9 @@ void Page::menuScroll()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( scrollDirectionForward_?"menuScrollNext":"menuScrollPrev", menuDepth_ - 1 );
+        (*it)->triggerEvent( scrollDirectionForward_?EVENT_MENU_SCROLL_NEXT:EVENT_MENU_SCROLL_PREV, menuDepth_ - 1 );
         (*it)->update(0);
-        (*it)->triggerEvent( "menuScroll", menuDepth_ - 1 );
+        (*it)->triggerEvent( EVENT_MENU_SCROLL, menuDepth_ - 1 );
     }
 }
 
@@ -459,9 +488,9 @@ void Page::menuFastScroll()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( scrollDirectionForward_?"menuFastScrollNext":"menuFastScrollPrev", menuDepth_ - 1 );
+        (*it)->triggerEvent( scrollDirectionForward_?EVENT_MENU_FAST_SCROLL_NEXT:EVENT_MENU_FAST_SCROLL_PREV, menuDepth_ - 1 );
         (*it)->update(0);
-        (*it)->triggerEvent( "menuFastScroll", menuDepth_ - 1 );
+        (*it)->triggerEvent( EVENT_MENU_FAST_SCROLL, menuDepth_ - 1 );
     }
 }
 
@@ -479,12 +508,12 @@ void Page::highlightEnter()
             if(menuDepth_-1 == static_cast<unsigned int>(distance(menus_.begin(), it)))
             {
                 // Also trigger animations for index i for active menu
-                menu->triggerEvent( "highlightEnter", MENU_INDEX_HIGH + menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_HIGHLIGHT_ENTER, MENU_INDEX_HIGH + menuDepth_ - 1 );
                 menu->triggerHighlightEnterEvent( MENU_INDEX_HIGH + menuDepth_ - 1 );
             }
             else
             {
-                menu->triggerEvent( "highlightEnter", menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_HIGHLIGHT_ENTER, menuDepth_ - 1 );
                 menu->triggerHighlightEnterEvent( menuDepth_ - 1 );
             }
         }
@@ -492,7 +521,7 @@ void Page::highlightEnter()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( "highlightEnter", menuDepth_ - 1 );
+        (*it)->triggerEvent( EVENT_HIGHLIGHT_ENTER, menuDepth_ - 1 );
     }
 }
 
@@ -510,12 +539,12 @@ void Page::highlightExit()
             if(menuDepth_-1 == static_cast<unsigned int>(distance(menus_.begin(), it)))
             {
                 // Also trigger animations for index i for active menu
-                menu->triggerEvent( "highlightExit", MENU_INDEX_HIGH + menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_HIGHLIGHT_EXIT, MENU_INDEX_HIGH + menuDepth_ - 1 );
                 menu->triggerHighlightExitEvent( MENU_INDEX_HIGH + menuDepth_ - 1 );
             }
             else
             {
-                menu->triggerEvent( "highlightExit", menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_HIGHLIGHT_EXIT, menuDepth_ - 1 );
                 menu->triggerHighlightExitEvent( menuDepth_ - 1 );
             }
         }
@@ -523,7 +552,7 @@ void Page::highlightExit()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( "highlightExit", menuDepth_ - 1 );
+        (*it)->triggerEvent( EVENT_HIGHLIGHT_EXIT, menuDepth_ - 1 );
     }
 }
 
@@ -541,12 +570,12 @@ void Page::playlistEnter()
             if(menuDepth_-1 == static_cast<unsigned int>(distance(menus_.begin(), it)))
             {
                 // Also trigger animations for index i for active menu
-                menu->triggerEvent( "playlistEnter", MENU_INDEX_HIGH + menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_PLAYLIST_ENTER, MENU_INDEX_HIGH + menuDepth_ - 1 );
                 menu->triggerPlaylistEnterEvent( MENU_INDEX_HIGH + menuDepth_ - 1 );
             }
             else
             {
-                menu->triggerEvent( "playlistEnter", menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_PLAYLIST_ENTER, menuDepth_ - 1 );
                 menu->triggerPlaylistEnterEvent( menuDepth_ - 1 );
             }
         }
@@ -554,7 +583,7 @@ void Page::playlistEnter()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( "playlistEnter", menuDepth_ - 1 );
+        (*it)->triggerEvent( EVENT_PLAYLIST_ENTER, menuDepth_ - 1 );
     }
 }
 
@@ -572,12 +601,12 @@ void Page::playlistExit()
             if(menuDepth_-1 == static_cast<unsigned int>(distance(menus_.begin(), it)))
             {
                 // Also trigger animations for index i for active menu
-                menu->triggerEvent( "playlistExit", MENU_INDEX_HIGH + menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_PLAYLIST_EXIT, MENU_INDEX_HIGH + menuDepth_ - 1 );
                 menu->triggerPlaylistExitEvent( MENU_INDEX_HIGH + menuDepth_ - 1 );
             }
             else
             {
-                menu->triggerEvent( "playlistExit", menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_PLAYLIST_EXIT, menuDepth_ - 1 );
                 menu->triggerPlaylistExitEvent( menuDepth_ - 1 );
             }
         }
@@ -585,7 +614,7 @@ void Page::playlistExit()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( "playlistExit", menuDepth_ - 1 );
+        (*it)->triggerEvent( EVENT_PLAYLIST_EXIT, menuDepth_ - 1 );
     }
 }
 
@@ -603,12 +632,12 @@ void Page::menuJumpEnter()
             if(menuDepth_-1 == static_cast<unsigned int>(distance(menus_.begin(), it)))
             {
                 // Also trigger animations for index i for active menu
-                menu->triggerEvent( "menuJumpEnter", MENU_INDEX_HIGH + menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_MENU_JUMP_ENTER, MENU_INDEX_HIGH + menuDepth_ - 1 );
                 menu->triggerMenuJumpEnterEvent( MENU_INDEX_HIGH + menuDepth_ - 1 );
             }
             else
             {
-                menu->triggerEvent( "menuJumpEnter", menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_MENU_JUMP_ENTER, menuDepth_ - 1 );
                 menu->triggerMenuJumpEnterEvent( menuDepth_ - 1 );
             }
         }
@@ -616,7 +645,7 @@ void Page::menuJumpEnter()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( "menuJumpEnter", menuDepth_ - 1 );
+        (*it)->triggerEvent( EVENT_MENU_JUMP_ENTER, menuDepth_ - 1 );
     }
 }
 
@@ -634,12 +663,12 @@ void Page::menuJumpExit()
             if(menuDepth_-1 == static_cast<unsigned int>(distance(menus_.begin(), it)))
             {
                 // Also trigger animations for index i for active menu
-                menu->triggerEvent( "menuJumpExit", MENU_INDEX_HIGH + menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_MENU_JUMP_EXIT, MENU_INDEX_HIGH + menuDepth_ - 1 );
                 menu->triggerMenuJumpExitEvent( MENU_INDEX_HIGH + menuDepth_ - 1 );
             }
             else
             {
-                menu->triggerEvent( "menuJumpExit", menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_MENU_JUMP_EXIT, menuDepth_ - 1 );
                 menu->triggerMenuJumpExitEvent( menuDepth_ - 1 );
             }
         }
@@ -647,16 +676,18 @@ void Page::menuJumpExit()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( "menuJumpExit", menuDepth_ - 1 );
+        (*it)->triggerEvent( EVENT_MENU_JUMP_EXIT, menuDepth_ - 1 );
     }
 }
 
 
 void Page::triggerEvent( std::string action )
 {
+    int event = AnimationEvents::getEventId( action );
+
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( action );
+        (*it)->triggerEvent( event );
     }
 }
 
@@ -857,6 +888,20 @@ bool Page::popCollection()
 }
 
 
+// Hands the collection stack (bottom first) over to the caller instead of
+// deleting it with the page, so a page rebuilt for another layout can reuse it.
+void Page::detachCollections(std::vector<CollectionInfo *> &collections)
+{
+    cleanup();
+
+    for(CollectionVector_T::iterator it = collections_.begin(); it != collections_.end(); ++it)
+    {
+        collections.push_back(it->collection);
+    }
+    collections_.clear();
+}
+
+
 void Page::enterMenu()
 {
     for(MenuVector_T::iterator it = menus_.begin(); it != menus_.end(); it++)
@@ -867,12 +912,12 @@ void Page::enterMenu()
             if(menuDepth_-1 == static_cast<unsigned int>(distance(menus_.begin(), it)))
             {
                 // Also trigger animations for index i for active menu
-                menu->triggerEvent( "menuEnter", MENU_INDEX_HIGH + menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_MENU_ENTER, MENU_INDEX_HIGH + menuDepth_ - 1 );
                 menu->triggerMenuEnterEvent( MENU_INDEX_HIGH + menuDepth_ - 1 );
             }
             else
             {
-                menu->triggerEvent( "menuEnter", menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_MENU_ENTER, menuDepth_ - 1 );
                 menu->triggerMenuEnterEvent( menuDepth_ - 1 );
             }
         }
@@ -880,7 +925,7 @@ void Page::enterMenu()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( "menuEnter", menuDepth_ - 1 );
+        (*it)->triggerEvent( EVENT_MENU_ENTER, menuDepth_ - 1 );
     }
 
     return;
@@ -898,12 +943,12 @@ void Page::exitMenu()
             if(menuDepth_-1 == static_cast<unsigned int>(distance(menus_.begin(), it)))
             {
                 // Also trigger animations for index i for active menu
-                menu->triggerEvent( "menuExit", MENU_INDEX_HIGH + menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_MENU_EXIT, MENU_INDEX_HIGH + menuDepth_ - 1 );
                 menu->triggerMenuExitEvent( MENU_INDEX_HIGH + menuDepth_ - 1 );
             }
             else
             {
-                menu->triggerEvent( "menuExit", menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_MENU_EXIT, menuDepth_ - 1 );
                 menu->triggerMenuExitEvent( menuDepth_ - 1 );
             }
         }
@@ -911,7 +956,7 @@ void Page::exitMenu()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( "menuExit", menuDepth_ - 1 );
+        (*it)->triggerEvent( EVENT_MENU_EXIT, menuDepth_ - 1 );
     }
 
     return;
@@ -929,12 +974,12 @@ void Page::enterGame()
             if(menuDepth_-1 == static_cast<unsigned int>(distance(menus_.begin(), it)))
             {
                 // Also trigger animations for index i for active menu
-                menu->triggerEvent( "gameEnter", MENU_INDEX_HIGH + menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_GAME_ENTER, MENU_INDEX_HIGH + menuDepth_ - 1 );
                 menu->triggerGameEnterEvent( MENU_INDEX_HIGH + menuDepth_ - 1 );
             }
             else
             {
-                menu->triggerEvent( "gameEnter", menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_GAME_ENTER, menuDepth_ - 1 );
                 menu->triggerGameEnterEvent( menuDepth_ - 1 );
             }
         }
@@ -942,7 +987,7 @@ void Page::enterGame()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( "gameEnter", menuDepth_ - 1 );
+        (*it)->triggerEvent( EVENT_GAME_ENTER, menuDepth_ - 1 );
     }
 
     return;
@@ -960,12 +1005,12 @@ void Page::exitGame()
             if(menuDepth_-1 == static_cast<unsigned int>(distance(menus_.begin(), it)))
             {
                 // Also trigger animations for index i for active menu
-                menu->triggerEvent( "gameExit", MENU_INDEX_HIGH + menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_GAME_EXIT, MENU_INDEX_HIGH + menuDepth_ - 1 );
                 menu->triggerGameExitEvent( MENU_INDEX_HIGH + menuDepth_ - 1 );
             }
             else
             {
-                menu->triggerEvent( "gameExit", menuDepth_ - 1 );
+                menu->triggerEvent( EVENT_GAME_EXIT, menuDepth_ - 1 );
                 menu->triggerGameExitEvent( menuDepth_ - 1 );
             }
         }
@@ -973,7 +1018,7 @@ void Page::exitGame()
 
     for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
     {
-        (*it)->triggerEvent( "gameExit", menuDepth_ - 1 );
+        (*it)->triggerEvent( EVENT_GAME_EXIT, menuDepth_ - 1 );
     }
 
     return;
@@ -1085,6 +1130,9 @@ void Page::selectPlaylist(std::string playlist)
 
 void Page::update(float dt)
 {
+    // queue the tweens of every component and evaluate them in one pass
+    tweenBatch_.begin();
+
     for(MenuVector_T::iterator it = menus_.begin(); it != menus_.end(); it++)
     {
         for(std::vector<ScrollingList *>::iterator it2 = menus_[std::distance(menus_.begin(), it)].begin(); it2 != menus_[std::distance(menus_.begin(), it)].end(); it2++)
@@ -1106,6 +1154,35 @@ void Page::update(float dt)
         if(*it) (*it)->update(dt);
     }
 
+    tweenBatch_.end();
+}
+
+
+// Seconds until any component needs another update, 0 if one is animating
+// right now and negative if the page is completely static.
+float Page::getIdleTimeout()
+{
+    if(scrollActive_)
+    {
+        return 0;
+    }
+
+    float timeout = -1;
+
+    for(MenuVector_T::iterator it = menus_.begin(); it != menus_.end(); it++)
+    {
+        for(std::vector<ScrollingList *>::iterator it2 = it->begin(); it2 != it->end(); it2++)
+        {
+            timeout = Component::earliestTimeout(timeout, (*it2)->getIdleTimeout());
+        }
+    }
+
+    for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
+    {
+        if(*it) timeout = Component::earliestTimeout(timeout, (*it)->getIdleTimeout());
+    }
+
+    return timeout;
 }
 
 
@@ -1173,9 +1250,8 @@ void Page::removePlaylist()
     {
         items->erase(it);
         collection->sortPlaylists();
-        collection->saveRequest = true;
+        collection->favoriteChanged(selectedItem_, false);
     }
-    collection->Save();
 }
 
 
@@ -1191,9 +1267,8 @@ void Page::addPlaylist()
     {
         items->push_back(selectedItem_);
         collection->sortPlaylists();
-        collection->saveRequest = true;
+        collection->favoriteChanged(selectedItem_, true);
     }
-    collection->Save();
 }
 
 
@@ -1259,6 +1334,42 @@ void Page::allocateGraphicsMemory()
 }
 
 
+// Stops the videos of a cached page and frees their frames; the rest of
+// the page stays loaded
+void Page::suspendVideos()
+{
+    for(MenuVector_T::iterator it = menus_.begin(); it != menus_.end(); it++)
+    {
+        for(std::vector<ScrollingList *>::iterator it2 = it->begin(); it2 != it->end(); it2++)
+        {
+            (*it2)->suspendVideos();
+        }
+    }
+
+    for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
+    {
+        (*it)->suspendVideos();
+    }
+}
+
+
+void Page::resumeVideos()
+{
+    for(MenuVector_T::iterator it = menus_.begin(); it != menus_.end(); it++)
+    {
+        for(std::vector<ScrollingList *>::iterator it2 = it->begin(); it2 != it->end(); it2++)
+        {
+            (*it2)->resumeVideos();
+        }
+    }
+
+    for(std::vector<Component *>::iterator it = LayerComponents.begin(); it != LayerComponents.end(); ++it)
+    {
+        (*it)->resumeVideos();
+    }
+}
+
+
 void Page::deInitializeFonts()
 {
     for(MenuVector_T::iterator it = menus_.begin(); it != menus_.end(); it++)
@@ -1410,3 +1521,9 @@ void Page::scroll(bool forward)
     }
     return;
 }
+
+
+TweenBatch &Page::getTweenBatch()
+{
+    return tweenBatch_;
+}
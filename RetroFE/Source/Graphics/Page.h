@@ -16,6 +16,7 @@
 #pragma once
 
 #include "../Collection/CollectionInfo.h"
+#include "Animate/TweenBatch.h"
 
 #include <map>
 #include <string>
@@ -48,6 +49,7 @@ public:
     void highlightLoadArt();
     bool pushCollection(CollectionInfo *collection);
     bool popCollection();
+    void detachCollections(std::vector<CollectionInfo *> &collections);
     void enterMenu();
     void exitMenu();
     void enterGame();
@@ -87,10 +89,13 @@ public:
     bool isMenuIdle();
     void setStatusTextComponent(Text *t);
     void update(float dt);
+    float getIdleTimeout();
     void cleanup();
     void draw();
     void freeGraphicsMemory();
     void allocateGraphicsMemory();
+    void suspendVideos();
+    void resumeVideos();
     void deInitializeFonts( );
     void initializeFonts( );
     void playSelect();
@@ -98,6 +103,10 @@ public:
     std::string getCollectionName();
     void setMinShowTime(float value);
     float getMinShowTime();
+    void setVideoLimits(int maxWidth, int maxHeight, int maxFrameRate);
+    int getVideoMaxWidth();
+    int getVideoMaxHeight();
+    int getVideoMaxFrameRate();
     void menuScroll();
     void menuFastScroll();
     void highlightEnter();
@@ -118,6 +127,7 @@ public:
     float getScrollPeriod();
     void updateScrollPeriod();
     void scroll(bool forward);
+    TweenBatch &getTweenBatch();
 
 private:
     void playlistChange();
@@ -157,7 +167,11 @@ private:
     Sound *selectSoundChunk_;
     float minShowTime_;
     float elapsedTime_;
+    int videoMaxWidth_;
+    int videoMaxHeight_;
+    int videoMaxFrameRate_;
     CollectionInfo::Playlists_T::iterator playlist_;
+    TweenBatch tweenBatch_;
 
 
 };
@@ -34,6 +34,7 @@
 #include "../Utility/Log.h"
 #include "../Utility/Utils.h"
 #include <algorithm>
+#include <cctype>
 #include <cfloat>
 #include <fstream>
 #include <sstream>
@@ -160,6 +161,9 @@ Page *PageBuilder::buildPage( std::string collectionName )
             xml_attribute<> *fontColorXml = root->first_attribute("fontColor");
             xml_attribute<> *fontSizeXml = root->first_attribute("loadFontSize");
             xml_attribute<> *minShowTimeXml = root->first_attribute("minShowTime");
+            xml_attribute<> *videoMaxWidthXml = root->first_attribute("videoMaxWidth");
+            xml_attribute<> *videoMaxHeightXml = root->first_attribute("videoMaxHeight");
+            xml_attribute<> *videoMaxFrameRateXml = root->first_attribute("videoMaxFrameRate");
 
             int layoutHeight;
             int layoutWidth;
@@ -217,6 +221,10 @@ Page *PageBuilder::buildPage( std::string collectionName )
                 page->setMinShowTime(Utils::convertFloat(minShowTimeXml->value()));
             }
 
+            page->setVideoLimits(videoMaxWidthXml ? Utils::convertInt(videoMaxWidthXml->value()) : 0,
+                                 videoMaxHeightXml ? Utils::convertInt(videoMaxHeightXml->value()) : 0,
+                                 videoMaxFrameRateXml ? Utils::convertInt(videoMaxFrameRateXml->value()) : 0);
+
             // load sounds
             for(xml_node<> *sound = root->first_node("sound"); sound; sound = sound->next_sibling("sound"))
             {
@@ -938,36 +946,29 @@ AnimationEvents *PageBuilder::createTweenInstance(xml_node<> *componentXml)
 {
     AnimationEvents *tweens = new AnimationEvents();
 
-    buildTweenSet(tweens, componentXml, "onEnter",          "enter");
-    buildTweenSet(tweens, componentXml, "onExit",           "exit");
-    buildTweenSet(tweens, componentXml, "onIdle",           "idle");
-    buildTweenSet(tweens, componentXml, "onMenuIdle",       "menuIdle");
-    buildTweenSet(tweens, componentXml, "onMenuScroll",     "menuScroll");
-    buildTweenSet(tweens, componentXml, "onMenuScrollPrev",     "menuScrollPrev");
-    buildTweenSet(tweens, componentXml, "onMenuScrollNext",     "menuScrollNext");
-    buildTweenSet(tweens, componentXml, "onMenuFastScroll", "menuFastScroll");
-    buildTweenSet(tweens, componentXml, "onMenuFastScrollPrev", "menuFastScrollPrev");
-    buildTweenSet(tweens, componentXml, "onMenuFastScrollNext", "menuFastScrollNext");
-    buildTweenSet(tweens, componentXml, "onHighlightEnter", "highlightEnter");
-    buildTweenSet(tweens, componentXml, "onHighlightExit",  "highlightExit");
-    buildTweenSet(tweens, componentXml, "onMenuEnter",      "menuEnter");
-    buildTweenSet(tweens, componentXml, "onMenuExit",       "menuExit");
-    buildTweenSet(tweens, componentXml, "onGameEnter",      "gameEnter");
-    buildTweenSet(tweens, componentXml, "onGameExit",       "gameExit");
-    buildTweenSet(tweens, componentXml, "onPlaylistEnter",  "playlistEnter");
-    buildTweenSet(tweens, componentXml, "onPlaylistExit",   "playlistExit");
-    buildTweenSet(tweens, componentXml, "onMenuJumpEnter",  "menuJumpEnter");
-    buildTweenSet(tweens, componentXml, "onMenuJumpExit",   "menuJumpExit");
-
-    buildTweenSet(tweens, componentXml, "onMenuActionInputEnter",  "menuActionInputEnter");
-    buildTweenSet(tweens, componentXml, "onMenuActionInputExit",   "menuActionInputExit");
-    buildTweenSet(tweens, componentXml, "onMenuActionSelectEnter", "menuActionSelectEnter");
-    buildTweenSet(tweens, componentXml, "onMenuActionSelectExit",  "menuActionSelectExit");
+    // every on<Event> child is a tween set; the event name is interned so that
+    // triggering it later is an index lookup rather than a string compare
+    std::map<std::string, bool> builtTags;
+    for(xml_node<> *eventXml = componentXml->first_node(); eventXml; eventXml = eventXml->next_sibling())
+    {
+        std::string tagName = eventXml->name();
+
+        if(tagName.length() <= 2 || tagName.compare(0, 2, "on") != 0 || builtTags.find(tagName) != builtTags.end())
+        {
+            continue;
+        }
+        builtTags[tagName] = true;
+
+        std::string eventName = tagName.substr(2);
+        eventName[0] = static_cast<char>(tolower(eventName[0]));
+
+        buildTweenSet(tweens, componentXml, tagName, AnimationEvents::getEventId(eventName));
+    }
 
     return tweens;
 }
 
-void PageBuilder::buildTweenSet(AnimationEvents *tweens, xml_node<> *componentXml, std::string tagName, std::string tweenName)
+void PageBuilder::buildTweenSet(AnimationEvents *tweens, xml_node<> *componentXml, std::string tagName, int event)
 {
     for(componentXml = componentXml->first_node(tagName.c_str()); componentXml; componentXml = componentXml->next_sibling(tagName.c_str()))
     {
@@ -986,7 +987,7 @@ void PageBuilder::buildTweenSet(AnimationEvents *tweens, xml_node<> *componentXm
                     {
                         Animation *animation = new Animation();
                         getTweenSet(componentXml, animation);
-                        tweens->setAnimation(tweenName, i, animation);
+                        tweens->setAnimation(event, i, animation);
                     }
                 }
             }
@@ -1000,7 +1001,7 @@ void PageBuilder::buildTweenSet(AnimationEvents *tweens, xml_node<> *componentXm
                     {
                         Animation *animation = new Animation();
                         getTweenSet(componentXml, animation);
-                        tweens->setAnimation(tweenName, i, animation);
+                        tweens->setAnimation(event, i, animation);
                     }
                 }
             }
@@ -1014,7 +1015,7 @@ void PageBuilder::buildTweenSet(AnimationEvents *tweens, xml_node<> *componentXm
                     {
                         Animation *animation = new Animation();
                         getTweenSet(componentXml, animation);
-                        tweens->setAnimation(tweenName, i, animation);
+                        tweens->setAnimation(event, i, animation);
                     }
                 }
             }
@@ -1022,21 +1023,21 @@ void PageBuilder::buildTweenSet(AnimationEvents *tweens, xml_node<> *componentXm
             {
                 Animation *animation = new Animation();
                 getTweenSet(componentXml, animation);
-                tweens->setAnimation(tweenName, MENU_INDEX_HIGH, animation);
+                tweens->setAnimation(event, MENU_INDEX_HIGH, animation);
             }
             else
             {
                 int index = Utils::convertInt(indexXml->value());
                 Animation *animation = new Animation();
                 getTweenSet(componentXml, animation);
-                tweens->setAnimation(tweenName, index, animation);
+                tweens->setAnimation(event, index, animation);
             }
         }
         else
         {
             Animation *animation = new Animation();
             getTweenSet(componentXml, animation);
-            tweens->setAnimation(tweenName, -1, animation);
+            tweens->setAnimation(event, -1, animation);
         }
     }
 }
@@ -1144,15 +1145,15 @@ ScrollingList * PageBuilder::buildMenu(xml_node<> *menuXml, Page &page)
 
 void PageBuilder::buildCustomMenu(ScrollingList *menu, xml_node<> *menuXml, xml_node<> *itemDefaults)
 {
-    std::vector<ViewInfo *> *points = new std::vector<ViewInfo *>();
+    std::vector<ViewInfo> *points = new std::vector<ViewInfo>();
     std::vector<AnimationEvents *> *tweenPoints = new std::vector<AnimationEvents *>();
 
     int i = 0;
 
     for(xml_node<> *componentXml = menuXml->first_node("item"); componentXml; componentXml = componentXml->next_sibling("item"))
     {
-        ViewInfo *viewInfo = new ViewInfo();
-        buildViewInfo(componentXml, *viewInfo, itemDefaults);
+        ViewInfo viewInfo;
+        buildViewInfo(componentXml, viewInfo, itemDefaults);
 
         points->push_back(viewInfo);
         tweenPoints->push_back(createTweenInstance(componentXml));
@@ -1171,7 +1172,7 @@ void PageBuilder::buildCustomMenu(ScrollingList *menu, xml_node<> *menuXml, xml_
 
 void PageBuilder::buildVerticalMenu(ScrollingList *menu, xml_node<> *menuXml, xml_node<> *itemDefaults)
 {
-    std::vector<ViewInfo *> *points = new std::vector<ViewInfo *>();
+    std::vector<ViewInfo> *points = new std::vector<ViewInfo>();
     std::vector<AnimationEvents *> *tweenPoints = new std::vector<AnimationEvents *>();
 
     int selectedIndex = MENU_FIRST;
@@ -1209,17 +1210,17 @@ void PageBuilder::buildVerticalMenu(ScrollingList *menu, xml_node<> *menuXml, xm
     if(overrideItems.find(MENU_START) != overrideItems.end())
     {
         xml_node<> *component = overrideItems[MENU_START];
-        ViewInfo *viewInfo = createMenuItemInfo(component, itemDefaults, menu->baseViewInfo.Y + height);
+        ViewInfo viewInfo = createMenuItemInfo(component, itemDefaults, menu->baseViewInfo.Y + height);
         points->push_back(viewInfo);
         tweenPoints->push_back(createTweenInstance(component));
-        height += viewInfo->Height;
+        height += viewInfo.Height;
 
         // increment the selected index to account for the new "invisible" menu item
         selectedIndex++;
     }
     while(!end)
     {
-        ViewInfo *viewInfo = new ViewInfo();
+        ViewInfo viewInfo;
         xml_node<> *component = itemDefaults;
 
         // uss overridden item setting if specified by layout for the given index
@@ -1229,10 +1230,10 @@ void PageBuilder::buildVerticalMenu(ScrollingList *menu, xml_node<> *menuXml, xm
         }
 
         // calculate the total height of our menu items if we can load any additional items
-        buildViewInfo(component, *viewInfo, itemDefaults);
+        buildViewInfo(component, viewInfo, itemDefaults);
         xml_attribute<> *itemSpacingXml = component->first_attribute("spacing");
         int itemSpacing = itemSpacingXml ? Utils::convertInt(itemSpacingXml->value()) : 0;
-        float nextHeight = height + viewInfo->Height + itemSpacing;
+        float nextHeight = height + viewInfo.Height + itemSpacing;
 
         if(nextHeight >= menu->baseViewInfo.Height)
         {
@@ -1244,13 +1245,13 @@ void PageBuilder::buildVerticalMenu(ScrollingList *menu, xml_node<> *menuXml, xm
         {
             component = overrideItems[MENU_LAST];
 
-            buildViewInfo(component, *viewInfo, itemDefaults);
+            buildViewInfo(component, viewInfo, itemDefaults);
             xml_attribute<> *itemSpacingXml = component->first_attribute("spacing");
             int itemSpacing = itemSpacingXml ? Utils::convertInt(itemSpacingXml->value()) : 0;
-            nextHeight = height + viewInfo->Height + itemSpacing;
+            nextHeight = height + viewInfo.Height + itemSpacing;
         }
 
-        viewInfo->Y = menu->baseViewInfo.Y + (float)height;
+        viewInfo.Y = menu->baseViewInfo.Y + (float)height;
         points->push_back(viewInfo);
         tweenPoints->push_back(createTweenInstance(component));
         index++;
@@ -1261,7 +1262,7 @@ void PageBuilder::buildVerticalMenu(ScrollingList *menu, xml_node<> *menuXml, xm
     if(overrideItems.find(MENU_END) != overrideItems.end())
     {
         xml_node<> *component = overrideItems[MENU_END];
-        ViewInfo *viewInfo = createMenuItemInfo(component, itemDefaults, menu->baseViewInfo.Y + height);
+        ViewInfo viewInfo = createMenuItemInfo(component, itemDefaults, menu->baseViewInfo.Y + height);
         points->push_back(viewInfo);
         tweenPoints->push_back(createTweenInstance(component));
     }
@@ -1285,11 +1286,11 @@ void PageBuilder::buildVerticalMenu(ScrollingList *menu, xml_node<> *menuXml, xm
     menu->setPoints(points, tweenPoints);
 }
 
-ViewInfo *PageBuilder::createMenuItemInfo(xml_node<> *component, xml_node<> *defaults, float y)
+ViewInfo PageBuilder::createMenuItemInfo(xml_node<> *component, xml_node<> *defaults, float y)
 {
-    ViewInfo *viewInfo = new ViewInfo();
-    buildViewInfo(component, *viewInfo, defaults);
-    viewInfo->Y = y;
+    ViewInfo viewInfo;
+    buildViewInfo(component, viewInfo, defaults);
+    viewInfo.Y = y;
     return viewInfo;
 }
 
@@ -1393,7 +1394,7 @@ void PageBuilder::buildViewInfo(xml_node<> *componentXml, ViewInfo &info, xml_no
     info.Alpha              = alpha              ? Utils::convertFloat(alpha->value())                     : 1.f;
     info.Angle              = angle              ? Utils::convertFloat(angle->value())                     : 0.f;
     info.Layer              = layer              ? Utils::convertInt(layer->value())                       : 0;
-    info.Reflection         = reflection         ? reflection->value()                                     : "";
+    info.Reflection         = reflection         ? ViewInfo::parseReflection(reflection->value())          : ViewInfo::ReflectionNone;
     info.ReflectionDistance = reflectionDistance ? Utils::convertInt(reflectionDistance->value())          : 0;
     info.ReflectionScale    = reflectionScale    ? Utils::convertFloat(reflectionScale->value())           : 0.25f;
     info.ReflectionAlpha    = reflectionAlpha    ? Utils::convertFloat(reflectionAlpha->value())           : 1.f;
@@ -0,0 +1,113 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Reflector.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+// Size of the reflection of a width x height image, false when there is none
+bool Reflector::size(int width, int height, ViewInfo::ReflectionSide side, float scale, int &outWidth, int &outHeight)
+{
+    outWidth  = width;
+    outHeight = height;
+
+    switch(side)
+    {
+    case ViewInfo::ReflectionTop:
+    case ViewInfo::ReflectionBottom:
+        outHeight = static_cast<int>(height * scale + 0.5f);
+        break;
+    case ViewInfo::ReflectionLeft:
+    case ViewInfo::ReflectionRight:
+        outWidth = static_cast<int>(width * scale + 0.5f);
+        break;
+    default:
+        return false;
+    }
+
+    return outWidth > 0 && outHeight > 0;
+}
+
+
+bool Reflector::build(const Resampler::Image &src, ViewInfo::ReflectionSide side, float alpha, uint32_t opaqueMask,
+                      uint32_t *dst, int dstPitch, int dstWidth, int dstHeight)
+{
+    if(side == ViewInfo::ReflectionNone || dstWidth <= 0 || dstHeight <= 0 ||
+       !Resampler::scale(src, dstWidth, dstHeight, dst, dstPitch, 0, 0, dstWidth, dstHeight))
+    {
+        return false;
+    }
+
+    bool vertical = (side == ViewInfo::ReflectionTop || side == ViewInfo::ReflectionBottom);
+    int  lines    = vertical ? dstHeight : dstWidth;
+    alpha         = std::min(std::max(alpha, 0.0f), 1.0f);
+
+    // The ramp, indexed by the distance from the edge touching the image
+    std::vector<uint32_t> ramp(lines);
+    for(int d = 0; d < lines; ++d)
+    {
+        ramp[d] = static_cast<uint32_t>(std::floor(alpha * 255.0f * (lines - d) / lines + 0.5f));
+    }
+
+    for(int y = 0; y < dstHeight; ++y)
+    {
+        uint32_t *row = reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(dst) + y * dstPitch);
+
+        // mirror rows in pairs from the outside in
+        if(vertical && y < dstHeight / 2)
+        {
+            uint32_t *other = reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(dst) + (dstHeight - 1 - y) * dstPitch);
+            std::swap_ranges(row, row + dstWidth, other);
+        }
+        else if(!vertical)
+        {
+            std::reverse(row, row + dstWidth);
+        }
+    }
+
+    for(int y = 0; y < dstHeight; ++y)
+    {
+        uint32_t *row = reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(dst) + y * dstPitch);
+
+        if(vertical)
+        {
+            uint32_t weight = ramp[side == ViewInfo::ReflectionTop ? dstHeight - 1 - y : y];
+            for(int x = 0; x < dstWidth; ++x)
+            {
+                row[x] = fade(row[x] | opaqueMask, weight);
+            }
+        }
+        else
+        {
+            for(int x = 0; x < dstWidth; ++x)
+            {
+                row[x] = fade(row[x] | opaqueMask, ramp[side == ViewInfo::ReflectionLeft ? dstWidth - 1 - x : x]);
+            }
+        }
+    }
+
+    return true;
+}
+
+
+// The pixel with its alpha scaled by weight / 255
+uint32_t Reflector::fade(uint32_t pixel, uint32_t weight)
+{
+    uint32_t a = pixel >> 24;
+    a = (a * weight + 127) / 255;
+    return (pixel & 0x00ffffff) | (a << 24);
+}
@@ -0,0 +1,36 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Resampler.h"
+#include "ViewInfo.h"
+#include <stdint.h>
+
+// Reflection of a 32bpp image, made once and drawn with a single blit:
+// the image squashed by scale towards the side it is reflected on,
+// mirrored, and faded out by a linear alpha ramp that starts at alpha on
+// the edge touching the image. Pixels carry their alpha in the top byte;
+// opaqueMask is ORed into every source pixel, as in Rotator.
+class Reflector
+{
+public:
+    static bool size(int width, int height, ViewInfo::ReflectionSide side, float scale, int &outWidth, int &outHeight);
+    static bool build(const Resampler::Image &src, ViewInfo::ReflectionSide side, float alpha, uint32_t opaqueMask,
+                      uint32_t *dst, int dstPitch, int dstWidth, int dstHeight);
+
+private:
+    static uint32_t fade(uint32_t pixel, uint32_t weight);
+};
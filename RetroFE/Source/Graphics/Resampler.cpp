@@ -0,0 +1,257 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Resampler.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RESAMPLER_NEON
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RESAMPLER_SSE2
+#endif
+
+const int Resampler::WEIGHT_BITS;
+
+
+bool Resampler::scale(const Image &src, int dstWidth, int dstHeight,
+                      uint32_t *dst, int dstPitch, int cropX, int cropY, int outWidth, int outHeight)
+{
+    return run(src, dstWidth, dstHeight, dst, dstPitch, cropX, cropY, outWidth, outHeight, true);
+}
+
+
+bool Resampler::scaleScalar(const Image &src, int dstWidth, int dstHeight,
+                            uint32_t *dst, int dstPitch, int cropX, int cropY, int outWidth, int outHeight)
+{
+    return run(src, dstWidth, dstHeight, dst, dstPitch, cropX, cropY, outWidth, outHeight, false);
+}
+
+
+// Contributions of the source pixels to the output pixels [from, to), as
+// fixed point weights summing to 1 << WEIGHT_BITS for every output pixel.
+void Resampler::buildTaps(int srcSize, int dstSize, int from, int to, Taps &taps)
+{
+    double ratio = static_cast<double>(srcSize) / dstSize;
+    int    count = (ratio > 1.0) ? static_cast<int>(std::ceil(ratio)) + 1 : 2;
+
+    taps.count = count;
+    taps.first.assign(to - from, 0);
+    taps.weights.assign((to - from) * count, 0);
+
+    std::vector<double> weights(count);
+    for(int o = from; o < to; ++o)
+    {
+        int first;
+        std::fill(weights.begin(), weights.end(), 0.0);
+
+        if(ratio > 1.0)
+        {
+            // box: each source pixel weighs what it overlaps of the output pixel
+            double start = o * ratio;
+            double end   = start + ratio;
+            first = static_cast<int>(std::floor(start));
+            for(int k = 0; k < count && first + k < srcSize; ++k)
+            {
+                double overlap = std::min(end, first + k + 1.0) - std::max(start, static_cast<double>(first + k));
+                weights[k] = std::max(overlap, 0.0) / ratio;
+            }
+        }
+        else
+        {
+            // bilinear between the two nearest source pixels
+            double center = (o + 0.5) * ratio - 0.5;
+            first = static_cast<int>(std::floor(center));
+            double fraction = center - first;
+            weights[0] = 1.0 - fraction;
+            weights[1] = fraction;
+            if(first < 0)
+            {
+                first = 0;
+                weights[0] = 1.0;
+                weights[1] = 0.0;
+            }
+            if(first + 1 >= srcSize)
+            {
+                first = srcSize - 1;
+                weights[0] = 1.0;
+                weights[1] = 0.0;
+            }
+        }
+
+        int *fixed   = &taps.weights[(o - from) * count];
+        int total    = 0;
+        int heaviest = 0;
+        for(int k = 0; k < count; ++k)
+        {
+            fixed[k] = static_cast<int>(weights[k] * (1 << WEIGHT_BITS) + 0.5);
+            total   += fixed[k];
+            if(fixed[k] > fixed[heaviest]) heaviest = k;
+        }
+        fixed[heaviest] += (1 << WEIGHT_BITS) - total;
+        taps.first[o - from] = first;
+    }
+}
+
+
+bool Resampler::run(const Image &src, int dstWidth, int dstHeight,
+                    uint32_t *dst, int dstPitch, int cropX, int cropY, int outWidth, int outHeight, bool vectorized)
+{
+    if(!src.pixels || !dst || src.width <= 0 || src.height <= 0 || dstWidth <= 0 || dstHeight <= 0)
+    {
+        return false;
+    }
+
+    cropX     = std::max(cropX, 0);
+    cropY     = std::max(cropY, 0);
+    outWidth  = std::min(outWidth, dstWidth - cropX);
+    outHeight = std::min(outHeight, dstHeight - cropY);
+    if(outWidth <= 0 || outHeight <= 0)
+    {
+        return false;
+    }
+
+    Taps columns;
+    Taps rows;
+    buildTaps(src.width, dstWidth, cropX, cropX + outWidth, columns);
+    buildTaps(src.height, dstHeight, cropY, cropY + outHeight, rows);
+
+    // only the source columns the cropped output reads are filtered
+    int firstColumn = columns.first.front();
+    int lastColumn  = std::min(columns.first.back() + columns.count, src.width);
+    int channels    = (lastColumn - firstColumn) * 4;
+
+    std::vector<uint32_t> acc(channels);
+    std::vector<uint16_t> filtered(channels);
+
+    for(int y = 0; y < outHeight; ++y)
+    {
+        // vertical pass into acc, 14 fractional bits
+        std::fill(acc.begin(), acc.end(), 0);
+        const int *weights = &rows.weights[y * rows.count];
+        for(int k = 0; k < rows.count; ++k)
+        {
+            int row = rows.first[y] + k;
+            if(weights[k] == 0 || row >= src.height)
+            {
+                continue;
+            }
+
+            const uint8_t *line = reinterpret_cast<const uint8_t *>(src.pixels) + row * src.pitch + firstColumn * 4;
+            int done = vectorized ? accumulateRowVector(line, weights[k], &acc[0], channels) : 0;
+            accumulateRowScalar(line + done, weights[k], &acc[done], channels - done);
+        }
+        for(int c = 0; c < channels; ++c)
+        {
+            filtered[c] = static_cast<uint16_t>((acc[c] + 32) >> (WEIGHT_BITS - 8));
+        }
+
+        // horizontal pass, 8 + 14 fractional bits
+        uint8_t *out = reinterpret_cast<uint8_t *>(dst) + y * dstPitch;
+        for(int x = 0; x < outWidth; ++x)
+        {
+            const int *columnWeights = &columns.weights[x * columns.count];
+            int first = columns.first[x] - firstColumn;
+            uint32_t sum[4] = { 0, 0, 0, 0 };
+
+            for(int k = 0; k < columns.count && columns.first[x] + k < src.width; ++k)
+            {
+                const uint16_t *pixel = &filtered[(first + k) * 4];
+                uint32_t weight = columnWeights[k];
+                sum[0] += pixel[0] * weight;
+                sum[1] += pixel[1] * weight;
+                sum[2] += pixel[2] * weight;
+                sum[3] += pixel[3] * weight;
+            }
+            for(int c = 0; c < 4; ++c)
+            {
+                uint32_t value = (sum[c] + (1 << (WEIGHT_BITS + 7))) >> (WEIGHT_BITS + 8);
+                out[x * 4 + c] = static_cast<uint8_t>(std::min<uint32_t>(value, 255));
+            }
+        }
+    }
+
+    return true;
+}
+
+
+void Resampler::accumulateRowScalar(const uint8_t *row, int weight, uint32_t *acc, int channels)
+{
+    for(int c = 0; c < channels; ++c)
+    {
+        acc[c] += row[c] * weight;
+    }
+}
+
+
+// Accumulates whole vectors of the row and returns how many channels it
+// handled; the scalar loop finishes the tail.
+#if defined(RESAMPLER_NEON)
+
+int Resampler::accumulateRowVector(const uint8_t *row, int weight, uint32_t *acc, int channels)
+{
+    const uint16_t w = static_cast<uint16_t>(weight);
+    int c = 0;
+
+    for(; c + 16 <= channels; c += 16)
+    {
+        uint8x16_t v  = vld1q_u8(row + c);
+        uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+        uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+
+        vst1q_u32(acc + c,      vmlal_n_u16(vld1q_u32(acc + c),      vget_low_u16(lo),  w));
+        vst1q_u32(acc + c + 4,  vmlal_n_u16(vld1q_u32(acc + c + 4),  vget_high_u16(lo), w));
+        vst1q_u32(acc + c + 8,  vmlal_n_u16(vld1q_u32(acc + c + 8),  vget_low_u16(hi),  w));
+        vst1q_u32(acc + c + 12, vmlal_n_u16(vld1q_u32(acc + c + 12), vget_high_u16(hi), w));
+    }
+
+    return c;
+}
+
+#elif defined(RESAMPLER_SSE2)
+
+int Resampler::accumulateRowVector(const uint8_t *row, int weight, uint32_t *acc, int channels)
+{
+    // madd multiplies (channel, 0) pairs by (weight, 0): one 32 bit product per channel
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i w    = _mm_set1_epi32(weight);
+    int c = 0;
+
+    for(; c + 16 <= channels; c += 16)
+    {
+        __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + c));
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        __m128i *out = reinterpret_cast<__m128i *>(acc + c);
+
+        _mm_storeu_si128(out,     _mm_add_epi32(_mm_loadu_si128(out),     _mm_madd_epi16(_mm_unpacklo_epi16(lo, zero), w)));
+        _mm_storeu_si128(out + 1, _mm_add_epi32(_mm_loadu_si128(out + 1), _mm_madd_epi16(_mm_unpackhi_epi16(lo, zero), w)));
+        _mm_storeu_si128(out + 2, _mm_add_epi32(_mm_loadu_si128(out + 2), _mm_madd_epi16(_mm_unpacklo_epi16(hi, zero), w)));
+        _mm_storeu_si128(out + 3, _mm_add_epi32(_mm_loadu_si128(out + 3), _mm_madd_epi16(_mm_unpackhi_epi16(hi, zero), w)));
+    }
+
+    return c;
+}
+
+#else
+
+int Resampler::accumulateRowVector(const uint8_t *, int, uint32_t *, int)
+{
+    return 0;
+}
+
+#endif
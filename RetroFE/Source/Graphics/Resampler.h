@@ -0,0 +1,61 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+// Separable resampler for 32bpp images: a box (area average) filter when
+// shrinking, bilinear when enlarging. The four bytes of a pixel are filtered
+// independently, so any channel order works. The result is written into a
+// caller supplied buffer and can be cropped on the fly: only the window
+// [cropX, cropX + outWidth) x [cropY, cropY + outHeight) of the virtual
+// dstWidth x dstHeight image is computed.
+//
+// scale() runs its vertical pass with NEON or SSE2 when available;
+// scaleScalar() is the reference it must match bit for bit.
+class Resampler
+{
+public:
+    struct Image
+    {
+        const uint32_t *pixels;
+        int             pitch;
+        int             width;
+        int             height;
+    };
+
+    static bool scale(const Image &src, int dstWidth, int dstHeight,
+                      uint32_t *dst, int dstPitch, int cropX, int cropY, int outWidth, int outHeight);
+    static bool scaleScalar(const Image &src, int dstWidth, int dstHeight,
+                            uint32_t *dst, int dstPitch, int cropX, int cropY, int outWidth, int outHeight);
+
+private:
+    struct Taps
+    {
+        std::vector<int> first;
+        std::vector<int> weights;
+        int              count;
+    };
+
+    static const int WEIGHT_BITS = 14;
+
+    static void buildTaps(int srcSize, int dstSize, int from, int to, Taps &taps);
+    static bool run(const Image &src, int dstWidth, int dstHeight,
+                    uint32_t *dst, int dstPitch, int cropX, int cropY, int outWidth, int outHeight, bool vectorized);
+    static void accumulateRowScalar(const uint8_t *row, int weight, uint32_t *acc, int channels);
+    static int accumulateRowVector(const uint8_t *row, int weight, uint32_t *acc, int channels);
+};
@@ -0,0 +1,193 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Rotator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+const int Rotator::FRACTION_BITS;
+
+static const double PI = 3.14159265358979323846;
+
+
+// Size of the axis aligned box holding a width x height image rotated by angle
+void Rotator::boundingBox(int width, int height, float angle, int &outWidth, int &outHeight)
+{
+    double radians = angle * PI / 180.0;
+    double c       = std::fabs(std::cos(radians));
+    double s       = std::fabs(std::sin(radians));
+
+    // round away the error of the trigonometry so right angles stay exact
+    outWidth  = static_cast<int>(std::ceil(width * c + height * s - 1e-4));
+    outHeight = static_cast<int>(std::ceil(width * s + height * c - 1e-4));
+    outWidth  = std::max(outWidth, 1);
+    outHeight = std::max(outHeight, 1);
+}
+
+
+// The angle rounded to a multiple of step and folded into [0, 360), so
+// slowly tweened angles map onto a bounded set of cached results
+float Rotator::quantize(float angle, float step)
+{
+    double folded = std::fmod(static_cast<double>(angle), 360.0);
+    if(folded < 0)
+    {
+        folded += 360.0;
+    }
+    if(step > 0)
+    {
+        folded = std::floor(folded / step + 0.5) * step;
+    }
+    if(folded >= 360.0 - 1e-3)
+    {
+        folded = 0;
+    }
+    return static_cast<float>(folded);
+}
+
+
+bool Rotator::rotate(const Resampler::Image &src, float angle, uint32_t opaqueMask,
+                     uint32_t *dst, int dstPitch, int dstWidth, int dstHeight)
+{
+    if(!src.pixels || !dst || src.width <= 0 || src.height <= 0 || dstWidth <= 0 || dstHeight <= 0)
+    {
+        return false;
+    }
+
+    double radians = angle * PI / 180.0;
+    double c       = std::cos(radians);
+    double s       = std::sin(radians);
+
+    // Inverse mapping: the source position of output pixel (x, y) is
+    // origin + x * (c, -s) + y * (s, c), with integers on pixel centres
+    double originX = src.width  / 2.0 - 0.5 - c * (dstWidth / 2.0 - 0.5) - s * (dstHeight / 2.0 - 0.5);
+    double originY = src.height / 2.0 - 0.5 + s * (dstWidth / 2.0 - 0.5) - c * (dstHeight / 2.0 - 0.5);
+
+    const double one = static_cast<double>(1 << FRACTION_BITS);
+    int stepX = static_cast<int>(std::floor(c * one + 0.5));
+    int stepY = static_cast<int>(std::floor(-s * one + 0.5));
+    int lastX = src.width - 1;
+    int lastY = src.height - 1;
+
+    for(int y = 0; y < dstHeight; ++y)
+    {
+        uint32_t *row = reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(dst) + y * dstPitch);
+        double rowX = originX + s * y;
+        double rowY = originY + c * y;
+
+        // Pixels whose filter footprint touches the source
+        int fromX, toX, fromY, toY;
+        span(static_cast<float>(rowX), static_cast<float>(c), src.width, dstWidth, fromX, toX);
+        span(static_cast<float>(rowY), static_cast<float>(-s), src.height, dstWidth, fromY, toY);
+        int from = std::max(fromX, fromY);
+        int to   = std::min(toX, toY);
+        if(to <= from)
+        {
+            memset(row, 0, dstWidth * 4);
+            continue;
+        }
+        memset(row, 0, from * 4);
+        memset(row + to, 0, (dstWidth - to) * 4);
+
+        int sx = static_cast<int>(std::floor((rowX + c * from) * one + 0.5));
+        int sy = static_cast<int>(std::floor((rowY - s * from) * one + 0.5));
+        for(int x = from; x < to; ++x, sx += stepX, sy += stepY)
+        {
+            // arithmetic shifts floor the negative positions left of the source
+            int      x0 = sx >> FRACTION_BITS;
+            int      y0 = sy >> FRACTION_BITS;
+            uint32_t fx = (sx >> (FRACTION_BITS - 8)) & 0xff;
+            uint32_t fy = (sy >> (FRACTION_BITS - 8)) & 0xff;
+            uint32_t p00, p01, p10, p11;
+
+            if(x0 >= 0 && y0 >= 0 && x0 < lastX && y0 < lastY)
+            {
+                const uint32_t *tap = reinterpret_cast<const uint32_t *>(reinterpret_cast<const uint8_t *>(src.pixels) + y0 * src.pitch) + x0;
+                const uint32_t *below = reinterpret_cast<const uint32_t *>(reinterpret_cast<const uint8_t *>(tap) + src.pitch);
+                p00 = tap[0] | opaqueMask;
+                p01 = tap[1] | opaqueMask;
+                p10 = below[0] | opaqueMask;
+                p11 = below[1] | opaqueMask;
+            }
+            else if(x0 < -1 || y0 < -1 || x0 > lastX || y0 > lastY)
+            {
+                row[x] = 0;
+                continue;
+            }
+            else
+            {
+                p00 = fetch(src, x0, y0, opaqueMask);
+                p01 = fetch(src, x0 + 1, y0, opaqueMask);
+                p10 = fetch(src, x0, y0 + 1, opaqueMask);
+                p11 = fetch(src, x0 + 1, y0 + 1, opaqueMask);
+            }
+
+            row[x] = lerp(lerp(p00, p01, fx), lerp(p10, p11, fx), fy);
+        }
+    }
+
+    return true;
+}
+
+
+// Range [from, to) of x in [0, width) for which start + x * step lies in
+// (-1, limit), widened by a pixel to absorb rounding; rotate() checks the
+// pixels at the ends anyway.
+void Rotator::span(float start, float step, int limit, int width, int &from, int &to)
+{
+    if(std::fabs(step) < 1e-6f)
+    {
+        bool inside = start > -1.0f && start < limit;
+        from = 0;
+        to   = inside ? width : 0;
+        return;
+    }
+
+    float a = (-1.0f - start) / step;
+    float b = (limit - start) / step;
+    if(a > b)
+    {
+        std::swap(a, b);
+    }
+
+    from = static_cast<int>(std::max(std::floor(a), -1.0f));
+    to   = static_cast<int>(std::min(std::ceil(b) + 1.0f, static_cast<float>(width)));
+    from = std::min(std::max(from, 0), width);
+    to   = std::max(to, from);
+}
+
+
+// Per channel a + (b - a) * weight / 256, two channels at a time
+uint32_t Rotator::lerp(uint32_t a, uint32_t b, uint32_t weight)
+{
+    uint32_t inverse = 256 - weight;
+    uint32_t rb = (((a & 0x00ff00ff) * inverse + (b & 0x00ff00ff) * weight) >> 8) & 0x00ff00ff;
+    uint32_t ag = (((a >> 8) & 0x00ff00ff) * inverse + ((b >> 8) & 0x00ff00ff) * weight) & 0xff00ff00;
+    return rb | ag;
+}
+
+
+// A tap on or past the edge: the nearest edge pixel made transparent, so the
+// fade out keeps the colour of the edge instead of darkening towards black
+uint32_t Rotator::fetch(const Resampler::Image &src, int x, int y, uint32_t opaqueMask)
+{
+    bool outside = x < 0 || y < 0 || x >= src.width || y >= src.height;
+    x = std::min(std::max(x, 0), src.width - 1);
+    y = std::min(std::max(y, 0), src.height - 1);
+
+    uint32_t pixel = reinterpret_cast<const uint32_t *>(reinterpret_cast<const uint8_t *>(src.pixels) + y * src.pitch)[x] | opaqueMask;
+    return outside ? (pixel & 0x00ffffff) : pixel;
+}
@@ -0,0 +1,44 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Resampler.h"
+#include <stdint.h>
+
+// Rotation of a 32bpp image about its centre, bilinear filtered, into a
+// caller supplied buffer sized by boundingBox(). Angles are in degrees,
+// clockwise on screen. Pixels carry their alpha in the top byte; the
+// corners outside the rotated image are left transparent (0) and the edges
+// fade out instead of stair-stepping. opaqueMask is ORed into every source
+// pixel, so images without an alpha channel can pass 0xff000000.
+//
+// Each output row only walks the span that maps inside the source, and only
+// the pixels on its border pay for bounds checks.
+class Rotator
+{
+public:
+    static void boundingBox(int width, int height, float angle, int &outWidth, int &outHeight);
+    static bool rotate(const Resampler::Image &src, float angle, uint32_t opaqueMask,
+                       uint32_t *dst, int dstPitch, int dstWidth, int dstHeight);
+    static float quantize(float angle, float step);
+
+private:
+    static const int FRACTION_BITS = 16;
+
+    static void span(float start, float step, int limit, int width, int &from, int &to);
+    static uint32_t lerp(uint32_t a, uint32_t b, uint32_t weight);
+    static uint32_t fetch(const Resampler::Image &src, int x, int y, uint32_t opaqueMask);
+};
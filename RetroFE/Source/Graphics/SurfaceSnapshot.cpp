@@ -0,0 +1,230 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SurfaceSnapshot.h"
+#include "../Utility/Log.h"
+#include "../Utility/Lz4.h"
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+std::map<std::string, SurfaceSnapshot::Entry> SurfaceSnapshot::entries_;
+std::vector<unsigned char> SurfaceSnapshot::blob_;
+std::vector<unsigned char> SurfaceSnapshot::scratch_;
+std::string SurfaceSnapshot::file_;
+size_t SurfaceSnapshot::maxBytes_ = 0;
+size_t SurfaceSnapshot::rawBytes_ = 0;
+bool SurfaceSnapshot::capturing_ = false;
+
+void SurfaceSnapshot::begin(size_t maxBytes)
+{
+    end();
+    maxBytes_ = maxBytes;
+    capturing_ = true;
+}
+
+bool SurfaceSnapshot::isCapturing()
+{
+    return capturing_;
+}
+
+void SurfaceSnapshot::store(const std::string &key, SDL_Surface *surface)
+{
+    if(!capturing_ || maxBytes_ == 0 || !surface || entries_.find(key) != entries_.end())
+    {
+        return;
+    }
+
+    int rowBytes = surface->w * surface->format->BytesPerPixel;
+    size_t size = static_cast<size_t>(rowBytes) * surface->h;
+
+    // compress rows without the pitch padding
+    scratch_.resize(size);
+    if(SDL_MUSTLOCK(surface)) SDL_LockSurface(surface);
+    for(int y = 0; y < surface->h; y++)
+    {
+        memcpy(&scratch_[y * rowBytes], static_cast<unsigned char *>(surface->pixels) + y * surface->pitch, rowBytes);
+    }
+    if(SDL_MUSTLOCK(surface)) SDL_UnlockSurface(surface);
+
+    size_t offset = blob_.size();
+    blob_.resize(offset + Lz4::compressBound(size));
+    size_t length = Lz4::compress(scratch_.data(), size, blob_.data() + offset);
+    blob_.resize(offset + length);
+
+    if(blob_.size() > maxBytes_)
+    {
+        abandon("snapshot is over its size cap");
+        return;
+    }
+
+    Entry entry;
+    entry.width        = surface->w;
+    entry.height       = surface->h;
+    entry.bitsPerPixel = surface->format->BitsPerPixel;
+    entry.rMask        = surface->format->Rmask;
+    entry.gMask        = surface->format->Gmask;
+    entry.bMask        = surface->format->Bmask;
+    entry.aMask        = surface->format->Amask;
+    entry.flags        = surface->flags;
+    entry.colorKey     = surface->format->colorkey;
+    entry.alpha        = surface->format->alpha;
+    entry.offset       = offset;
+    entry.length       = length;
+    entries_[key]      = entry;
+
+    rawBytes_ += size;
+}
+
+void SurfaceSnapshot::seal(const std::string &file)
+{
+    capturing_ = false;
+
+    std::stringstream ss;
+    ss << "Kept " << entries_.size() << " surfaces, " << rawBytes_ / 1024 << " KB in " << blob_.size() / 1024 << " KB";
+    Logger::write(Logger::ZONE_INFO, "SurfaceSnapshot", ss.str());
+
+    if(file.empty() || blob_.empty())
+    {
+        return;
+    }
+
+    FILE *fp = fopen(file.c_str(), "wb");
+    if(!fp || fwrite(blob_.data(), 1, blob_.size(), fp) != blob_.size())
+    {
+        Logger::write(Logger::ZONE_WARNING, "SurfaceSnapshot", "Could not write " + file + ", keeping the snapshot in memory");
+        if(fp)
+        {
+            fclose(fp);
+            remove(file.c_str());
+        }
+        return;
+    }
+    fclose(fp);
+
+    // the game gets the memory back while it runs
+    std::vector<unsigned char>().swap(blob_);
+    std::vector<unsigned char>().swap(scratch_);
+    file_ = file;
+}
+
+void SurfaceSnapshot::resume()
+{
+    if(file_.empty())
+    {
+        return;
+    }
+
+    size_t size = 0;
+    for(std::map<std::string, Entry>::iterator it = entries_.begin(); it != entries_.end(); ++it)
+    {
+        size_t last = it->second.offset + it->second.length;
+        size = (last > size) ? last : size;
+    }
+
+    blob_.resize(size);
+    FILE *fp = fopen(file_.c_str(), "rb");
+    if(!fp || fread(blob_.data(), 1, size, fp) != size)
+    {
+        abandon("could not read " + file_);
+    }
+    if(fp)
+    {
+        fclose(fp);
+    }
+    remove(file_.c_str());
+    file_ = "";
+}
+
+// Returns a new surface for key, or NULL if it is not in the snapshot.
+SDL_Surface *SurfaceSnapshot::restore(const std::string &key)
+{
+    std::map<std::string, Entry>::iterator it = entries_.find(key);
+
+    if(capturing_ || it == entries_.end())
+    {
+        return NULL;
+    }
+
+    Entry &entry = it->second;
+    SDL_Surface *surface = SDL_CreateRGBSurface(SDL_SWSURFACE, entry.width, entry.height, entry.bitsPerPixel,
+                                                entry.rMask, entry.gMask, entry.bMask, entry.aMask);
+    if(!surface)
+    {
+        return NULL;
+    }
+
+    int rowBytes = entry.width * surface->format->BytesPerPixel;
+    size_t size = static_cast<size_t>(rowBytes) * entry.height;
+    bool packed = (surface->pitch == rowBytes);
+    if(!packed)
+    {
+        scratch_.resize(size);
+    }
+
+    if(SDL_MUSTLOCK(surface)) SDL_LockSurface(surface);
+    unsigned char *pixels = static_cast<unsigned char *>(surface->pixels);
+    bool ok = Lz4::decompress(&blob_[entry.offset], entry.length, packed ? pixels : scratch_.data(), size);
+    if(ok && !packed)
+    {
+        for(int y = 0; y < entry.height; y++)
+        {
+            memcpy(pixels + y * surface->pitch, &scratch_[y * rowBytes], rowBytes);
+        }
+    }
+    if(SDL_MUSTLOCK(surface)) SDL_UnlockSurface(surface);
+
+    if(!ok)
+    {
+        Logger::write(Logger::ZONE_WARNING, "SurfaceSnapshot", "Corrupt snapshot entry, reloading " + key);
+        SDL_FreeSurface(surface);
+        return NULL;
+    }
+
+    SDL_SetAlpha(surface, entry.flags & SDL_SRCALPHA, entry.alpha);
+    if(entry.flags & SDL_SRCCOLORKEY)
+    {
+        SDL_SetColorKey(surface, SDL_SRCCOLORKEY, entry.colorKey);
+    }
+
+    return surface;
+}
+
+void SurfaceSnapshot::end()
+{
+    if(!file_.empty())
+    {
+        remove(file_.c_str());
+        file_ = "";
+    }
+
+    entries_.clear();
+    std::vector<unsigned char>().swap(blob_);
+    std::vector<unsigned char>().swap(scratch_);
+    rawBytes_ = 0;
+    capturing_ = false;
+}
+
+void SurfaceSnapshot::abandon(const std::string &reason)
+{
+    Logger::write(Logger::ZONE_WARNING, "SurfaceSnapshot", "Falling back to reloading from disk: " + reason);
+
+    bool capturing = capturing_;
+    end();
+
+    // stay armed so later surfaces are not captured into a fresh, partial blob
+    capturing_ = capturing;
+    maxBytes_ = 0;
+}
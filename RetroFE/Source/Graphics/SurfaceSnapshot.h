@@ -0,0 +1,70 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <SDL/SDL.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// Keeps the decoded surfaces of the current page, LZ4 compressed, across a
+// game launch so that coming back does not decode every image and render
+// every font atlas again.
+//
+// begin() arms the snapshot; while armed, components hand their surfaces to
+// store() as they free them. seal() optionally moves the blob to a file (e.g.
+// on tmpfs) while the game runs, resume() brings it back and restore() hands
+// out fresh copies as components reallocate. end() drops everything. If the
+// compressed size exceeds the cap the snapshot is abandoned and components
+// fall back to loading from disk.
+class SurfaceSnapshot
+{
+public:
+    static void begin(size_t maxBytes);
+    static void store(const std::string &key, SDL_Surface *surface);
+    static void seal(const std::string &file);
+    static void resume();
+    static SDL_Surface *restore(const std::string &key);
+    static void end();
+    static bool isCapturing();
+
+private:
+    struct Entry
+    {
+        int    width;
+        int    height;
+        int    bitsPerPixel;
+        Uint32 rMask;
+        Uint32 gMask;
+        Uint32 bMask;
+        Uint32 aMask;
+        Uint32 flags;
+        Uint32 colorKey;
+        Uint8  alpha;
+        size_t offset;
+        size_t length;
+    };
+
+    static void abandon(const std::string &reason);
+
+    static std::map<std::string, Entry> entries_;
+    static std::vector<unsigned char>   blob_;
+    static std::vector<unsigned char>   scratch_;
+    static std::string                  file_;
+    static size_t                       maxBytes_;
+    static size_t                       rawBytes_;
+    static bool                         capturing_;
+};
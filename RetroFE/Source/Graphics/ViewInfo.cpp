@@ -43,7 +43,7 @@ ViewInfo::ViewInfo()
     , BackgroundGreen(0)
     , BackgroundBlue(0)
     , BackgroundAlpha(0)
-    , Reflection("")
+    , Reflection(ReflectionNone)
     , ReflectionDistance(0)
     , ReflectionScale(.25)
     , ReflectionAlpha(1)
@@ -54,9 +54,13 @@ ViewInfo::ViewInfo()
 {
 }
 
-
-ViewInfo::~ViewInfo()
+ViewInfo::ReflectionSide ViewInfo::parseReflection(const std::string &side)
 {
+    if(side == "top")    return ReflectionTop;
+    if(side == "bottom") return ReflectionBottom;
+    if(side == "left")   return ReflectionLeft;
+    if(side == "right")  return ReflectionRight;
+    return ReflectionNone;
 }
 
 float ViewInfo::XRelativeToOrigin() const
@@ -69,6 +73,14 @@ float ViewInfo::YRelativeToOrigin() const
     return Y + YOffset - YOrigin*ScaledHeight();
 }
 
+void ViewInfo::Bounds(float &x, float &y, float &width, float &height) const
+{
+    width  = ScaledWidth();
+    height = ScaledHeight();
+    x      = X + XOffset - XOrigin*width;
+    y      = Y + YOffset - YOrigin*height;
+}
+
 float ViewInfo::ScaledHeight() const
 {
     float height = AbsoluteHeight();
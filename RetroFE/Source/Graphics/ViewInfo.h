@@ -18,15 +18,18 @@
 #include "Animate/TweenTypes.h"
 #include <string>
 #include <map>
+#include <type_traits>
 
 class Font;
 
+// Plain per-component layout state. It is copied on every tween and scroll
+// step, so it must stay trivially copyable: numbers, enums and non-owning
+// pointers only.
 class ViewInfo
 {
 public:
 
     ViewInfo();
-    virtual ~ViewInfo();
 
     float XRelativeToOrigin() const;
     float YRelativeToOrigin() const;
@@ -34,12 +37,28 @@ public:
     float ScaledHeight() const;
     float ScaledWidth() const;
 
+    // Top left corner and scaled size in one pass, for the draw paths which
+    // need all four every frame.
+    void Bounds(float &x, float &y, float &width, float &height) const;
+
     static const int AlignCenter = -1;
     static const int AlignLeft = -2;
     static const int AlignTop = -3;
     static const int AlignRight = -4;
     static const int AlignBottom = -5;
 
+    // Side of the image its reflection is drawn on
+    enum ReflectionSide
+    {
+        ReflectionNone,
+        ReflectionTop,
+        ReflectionBottom,
+        ReflectionLeft,
+        ReflectionRight
+    };
+
+    static ReflectionSide parseReflection(const std::string &side);
+
     float        X;
     float        Y;
     float        XOrigin;
@@ -65,7 +84,7 @@ public:
     float        BackgroundGreen;
     float        BackgroundBlue;
     float        BackgroundAlpha;
-    std::string  Reflection;
+    ReflectionSide Reflection;
     unsigned int ReflectionDistance;
     float        ReflectionScale;
     float        ReflectionAlpha;
@@ -78,3 +97,5 @@ private:
     float AbsoluteHeight() const;
     float AbsoluteWidth() const;
 };
+
+static_assert(std::is_trivially_copyable<ViewInfo>::value, "ViewInfo must stay trivially copyable");
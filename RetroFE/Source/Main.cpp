@@ -22,18 +22,34 @@
 #include "RetroFE.h"
 #include "Version.h"
 #include "SDL.h"
+#include <cctype>
 #include <cstdlib>
 #include <fstream>
 #include <dirent.h>
 #include <time.h>
 #include <locale>
+#include <map>
 
 static bool ImportConfiguration(Configuration *c);
 static bool StartLogging();
+static bool ParseOptions(int argc, char **argv, std::map<std::string, std::string> &options);
+
+// Flushes the log and joins its writer thread on every return from main;
+// a joinable std::thread left behind at exit calls std::terminate
+struct LoggerGuard
+{
+    ~LoggerGuard()
+    {
+        Logger::deInitialize();
+    }
+};
 
 int main(int argc, char **argv)
 {
 
+    // settings given on the command line, applied over settings.conf
+    std::map<std::string, std::string> options;
+
     // check to see if version or help was requested
     if(argc > 1)
     {
@@ -44,6 +60,10 @@ int main(int argc, char **argv)
         {
             // Do nothing; we handle that later
         }
+        else if(ParseOptions(argc, argv, options))
+        {
+            // Do nothing; we apply them once the configuration is read
+        }
         else if(param == "-version"  ||
                 param == "--version" ||
                 param == "-v")
@@ -57,6 +77,9 @@ int main(int argc, char **argv)
             std::cout << program  << "                                           Run RetroFE"                              << std::endl;
             std::cout << program  << " --version                                 Print the version of RetroFE."            << std::endl;
             std::cout << program  << " -createcollection <collection name>       Create a collection directory structure." << std::endl;
+            std::cout << program  << " --headless [frames]                       Render without a display (see headless in settings.conf)." << std::endl;
+            std::cout << program  << " --record <file>                           Record key input to a script."            << std::endl;
+            std::cout << program  << " --replay <file>                           Replay a key input script and report frame times." << std::endl;
             return 0;
         }
     }
@@ -71,13 +94,15 @@ int main(int argc, char **argv)
 
     Configuration config;
 
+    LoggerGuard loggerGuard;
+
     if(!StartLogging())
     {
         return -1;
     }
 
     // check to see if createcollection was requested
-    if(argc == 3)
+    if(argc == 3 && options.empty())
     {
         std::string param = argv[1];
         std::string value = argv[2];
@@ -99,15 +124,46 @@ int main(int argc, char **argv)
         return -1;
     }
 
+    for(std::map<std::string, std::string>::iterator it = options.begin(); it != options.end(); ++it)
+    {
+        config.setProperty(it->first, it->second);
+    }
+
     RetroFE p(config);
 
     p.run();
 
-    Logger::deInitialize();
-
     return 0;
 }
 
+bool ParseOptions(int argc, char **argv, std::map<std::string, std::string> &options)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string param = argv[i];
+
+        if(param == "-headless" || param == "--headless")
+        {
+            options["headless"] = "yes";
+            if(i + 1 < argc && isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+            {
+                options["headlessFrames"] = argv[++i];
+            }
+        }
+        else if((param == "--record" || param == "--replay") && i + 1 < argc)
+        {
+            options[(param == "--record") ? "inputRecord" : "inputReplay"] = argv[++i];
+        }
+        else
+        {
+            options.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool ImportConfiguration(Configuration *c)
 {
     std::string configPath =  Configuration::absolutePath;
@@ -130,6 +186,13 @@ bool ImportConfiguration(Configuration *c)
         return false;
     }
     
+    /* Zones written to the log, e.g. "INFO,NOTICE,WARNING,ERROR" */
+    std::string logZones;
+    if(c->getProperty("logZones", logZones))
+    {
+        Logger::setZones(logZones);
+    }
+
     /* Read layouts in absolute path */
     std::string layoutDefaultPath =  Utils::combinePath(Configuration::absolutePath, "layouts");
     std::string layoutListDefaultPath = Utils::combinePath(layoutDefaultPath, "layouts.list");
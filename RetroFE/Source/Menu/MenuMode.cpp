@@ -1,6 +1,10 @@
 #include "MenuMode.h"
 #include "../Utility/Utils.h"
+#include "../Utility/SystemState.h"
+#include "../Utility/Log.h"
+#include "../Utility/LruCache.h"
 #include <iostream>
+#include <sstream>
 #include "../SDL.h"
 #include "../Utility/Utils.h"
 
@@ -41,6 +45,7 @@
 #define MENU_FONT_SIZE_INFO         16
 #define MENU_FONT_NAME_SMALL_INFO   "/usr/games/menu_resources/OpenSans-Regular.ttf"
 #define MENU_FONT_SIZE_SMALL_INFO   13
+#define MENU_TEXT_CACHE_SIZE        32
 #define MENU_PNG_BG_PATH            "/usr/games/menu_resources/zone_bg.png"
 #define MENU_PNG_ARROW_TOP_PATH     "/usr/games/menu_resources/arrow_top.png"
 #define MENU_PNG_ARROW_BOTTOM_PATH  "/usr/games/menu_resources/arrow_bottom.png"
@@ -67,6 +72,8 @@ TTF_Font *MenuMode::menu_small_info_font = NULL;
 SDL_Surface *img_arrow_top = NULL;
 SDL_Surface *img_arrow_bottom = NULL;
 SDL_Surface ** MenuMode::menu_zone_surfaces = NULL;
+std::vector<SDL_Surface *> MenuMode::menu_zone_composed;
+std::vector<std::string> MenuMode::menu_zone_composed_state;
 int *MenuMode::idx_menus = NULL;
 int MenuMode::nb_menu_zones = 0;
 int MenuMode::menuItem=0;
@@ -95,6 +102,11 @@ Configuration *MenuMode::config = NULL;
 int MenuMode::savestate_slot = 0;
 int MenuMode::indexChooseLayout = 0;
 
+/// Rendered text lines, by font and string
+typedef std::pair<TTF_Font *, std::string> TextCacheKey;
+static LruCache<TextCacheKey, SDL_Surface *> text_cache(MENU_TEXT_CACHE_SIZE,
+		[](const TextCacheKey &, SDL_Surface *&surface){ SDL_FreeSurface(surface); });
+
 /// USB stuff
 int usb_data_connected = 0;
 int usb_sharing = 0;
@@ -149,6 +161,9 @@ void MenuMode::init(Configuration &c)
 void MenuMode::end( )
 {
 	MENU_DEBUG_PRINTF("End MenuMode \n");
+
+	/// ------ Drop cached text before its fonts go away -------
+	text_cache.clear();
 	/// ------ Close font -------
 	TTF_CloseFont(menu_title_font);
 	TTF_CloseFont(menu_info_font);
@@ -159,7 +174,12 @@ void MenuMode::end( )
 		if(menu_zone_surfaces[i] != NULL){
 			SDL_FreeSurface(menu_zone_surfaces[i]);
 		}
+		if(menu_zone_composed[i] != NULL){
+			SDL_FreeSurface(menu_zone_composed[i]);
+		}
 	}
+	menu_zone_composed.clear();
+	menu_zone_composed_state.clear();
 	if(backup_hw_screen != NULL){
 		SDL_FreeSurface(backup_hw_screen);
 	}
@@ -246,6 +266,8 @@ void MenuMode::add_menu_zone(ENUM_MENU_TYPE menu_type){
 		menu_zone_surfaces = (SDL_Surface**) realloc(menu_zone_surfaces, nb_menu_zones*sizeof(SDL_Surface*));
 	}
 	idx_menus[nb_menu_zones-1] = menu_type;
+	menu_zone_composed.push_back(NULL);
+	menu_zone_composed_state.push_back("");
 
 	/// ------ Reinit menu surface with height increased -------
 	menu_zone_surfaces[nb_menu_zones-1] = IMG_Load(MENU_PNG_BG_PATH);
@@ -389,50 +411,10 @@ void MenuMode::init_menu_zones(){
 
 
 void MenuMode::init_menu_system_values(){
-	FILE *fp;
-	char res[100];
-
-	/// ------- Get system volume percentage --------
-	fp = popen(SHELL_CMD_VOLUME_GET, "r");
-	if (fp == NULL) {
-		MENU_ERROR_PRINTF("Failed to run command %s\n", SHELL_CMD_VOLUME_GET );
-		volume_percentage = 50; ///wrong value: setting default to 50
-	}
-	else{
-		fgets(res, sizeof(res)-1, fp);
-		pclose(fp);
-
-		/// Check if Volume is a number (at least the first char)
-		if(res[0] < '0' || res[0] > '9'){
-			MENU_ERROR_PRINTF("Wrong return value: %s for volume cmd: %s\n",res, SHELL_CMD_VOLUME_GET);
-			volume_percentage = 50; ///wrong value: setting default to 50
-		}
-		else{
-			volume_percentage = atoi(res);
-			MENU_DEBUG_PRINTF("System volume = %d%%\n", volume_percentage);
-		}
-	}
-
-	/// ------- Get system brightness percentage -------
-	fp = popen(SHELL_CMD_BRIGHTNESS_GET, "r");
-	if (fp == NULL) {
-		MENU_ERROR_PRINTF("Failed to run command %s\n", SHELL_CMD_BRIGHTNESS_GET );
-		brightness_percentage = 50; ///wrong value: setting default to 50
-	}
-	else{
-		fgets(res, sizeof(res)-1, fp);
-		pclose(fp);
-
-		/// Check if brightness is a number (at least the first char)
-		if(res[0] < '0' || res[0] > '9'){
-			MENU_ERROR_PRINTF("Wrong return value: %s for volume cmd: %s\n",res, SHELL_CMD_BRIGHTNESS_GET);
-			brightness_percentage = 50; ///wrong value: setting default to 50
-		}
-		else{
-			brightness_percentage = atoi(res);
-			MENU_DEBUG_PRINTF("System brightness = %d%%\n", brightness_percentage);
-		}
-	}
+	/// ------- Volume and brightness are cached by the system state service --------
+	volume_percentage = SystemState::getVolume();
+	brightness_percentage = SystemState::getBrightness();
+	MENU_DEBUG_PRINTF("System volume = %d%%, brightness = %d%%\n", volume_percentage, brightness_percentage);
 
 	/// ------- Get USB Value -------
 	usb_data_connected = Utils::executeRawPath(SHELL_CMD_SHARE_IS_USB_DATA_CONNECTED);
@@ -461,10 +443,180 @@ void MenuMode::init_menu_system_values(){
 	}
 }
 
+SDL_Surface * MenuMode::render_text(TTF_Font *font, const char *text){
+	/// ------ Rendered lines stay owned by the cache, never free them ------
+	TextCacheKey key(font, text);
+	SDL_Surface **cached = text_cache.find(key);
+	if(cached){
+		return *cached;
+	}
+
+	SDL_Surface *text_surface = TTF_RenderText_Blended(font, text, text_color);
+	if(!text_surface){
+		MENU_ERROR_PRINTF("ERROR Could not render text \"%s\": %s\n", text, TTF_GetError());
+		return NULL;
+	}
+	return text_cache.insert(key, text_surface);
+}
+
+void MenuMode::blit_text_centered(SDL_Surface * surface, TTF_Font *font, const char *text, int offset_y){
+	SDL_Surface *text_surface = render_text(font, text);
+	if(!text_surface){
+		return;
+	}
+
+	SDL_Rect text_pos;
+	text_pos.x = (surface->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
+	text_pos.y = surface->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + offset_y;
+	SDL_BlitSurface(text_surface, NULL, surface, &text_pos);
+}
+
+SDL_Surface * MenuMode::compose_menu_zone(int item, uint8_t menu_confirmation, uint8_t menu_action){
+	SDL_Surface *base = menu_zone_surfaces[item];
+	if(!base){
+		return NULL;
+	}
+
+	/// --------- Only recompose when a displayed value changed ---------
+	char state[64];
+	snprintf(state, sizeof(state), "%d %d %d %d %d %d %d %d", menu_confirmation, menu_action,
+			volume_percentage, brightness_percentage, savestate_slot, aspect_ratio, usb_sharing, indexChooseLayout);
+	SDL_Surface *&composed = menu_zone_composed[item];
+	if(composed && menu_zone_composed_state[item] == state){
+		return composed;
+	}
+	menu_zone_composed_state[item] = state;
+
+	/// --------- Restart from the static zone (title, empty bars) ---------
+	if(!composed){
+		composed = SDL_ConvertSurface(base, base->format, base->flags);
+		if(!composed){
+			MENU_ERROR_PRINTF("ERROR Could not create composed menu zone: %s\n", SDL_GetError());
+			return base;
+		}
+	}
+	else{
+		SDL_LockSurface(base);
+		SDL_LockSurface(composed);
+		int row_bytes = MIN(base->pitch, composed->pitch);
+		for(int y = 0; y < base->h; y++){
+			memcpy((uint8_t*)composed->pixels + y*composed->pitch, (uint8_t*)base->pixels + y*base->pitch, row_bytes);
+		}
+		SDL_UnlockSurface(composed);
+		SDL_UnlockSurface(base);
+	}
+
+	/// --------- Blit menu-specific info ---------
+	char text_tmp[100];
+	std::string curLayoutName;
+	unsigned int max_chars = 15;
+
+	switch(idx_menus[item]){
+	case MENU_TYPE_VOLUME:
+		draw_progress_bar(composed, x_volume_bar, y_volume_bar,
+				width_progress_bar, height_progress_bar, volume_percentage, 100/STEP_CHANGE_VOLUME);
+		break;
+
+	case MENU_TYPE_BRIGHTNESS:
+		draw_progress_bar(composed, x_brightness_bar, y_brightness_bar,
+				width_progress_bar, height_progress_bar, brightness_percentage, 100/STEP_CHANGE_BRIGHTNESS);
+		break;
+
+	case MENU_TYPE_SAVE:
+		/// ---- Write slot -----
+		sprintf(text_tmp, "IN SLOT   < %d >", savestate_slot+1);
+		blit_text_centered(composed, menu_info_font, text_tmp, 0);
+
+		if(menu_action){
+			blit_text_centered(composed, menu_info_font, "Saving...", 2*padding_y_from_center_menu_zone);
+		}
+		else if(menu_confirmation){
+			blit_text_centered(composed, menu_info_font, "Are you sure ?", 2*padding_y_from_center_menu_zone);
+		}
+		break;
+
+	case MENU_TYPE_LOAD:
+		/// ---- Write slot -----
+		sprintf(text_tmp, "FROM SLOT   < %d >", savestate_slot+1);
+		blit_text_centered(composed, menu_info_font, text_tmp, 0);
+
+		if(menu_action){
+			blit_text_centered(composed, menu_info_font, "Loading...", 2*padding_y_from_center_menu_zone);
+		}
+		else if(menu_confirmation){
+			blit_text_centered(composed, menu_info_font, "Are you sure ?", 2*padding_y_from_center_menu_zone);
+		}
+		break;
+
+	case MENU_TYPE_ASPECT_RATIO:
+		sprintf(text_tmp, "<   %s   >", aspect_ratio_name[aspect_ratio]);
+		blit_text_centered(composed, menu_info_font, text_tmp, padding_y_from_center_menu_zone);
+		break;
+
+	case MENU_TYPE_USB:
+		sprintf(text_tmp, "%s USB", usb_sharing?"EJECT":"MOUNT");
+		blit_text_centered(composed, menu_title_font, text_tmp, 0);
+
+		if(menu_action){
+			blit_text_centered(composed, menu_info_font, "in progress ...", 2*padding_y_from_center_menu_zone);
+		}
+		else if(menu_confirmation){
+			blit_text_centered(composed, menu_info_font, "Are you sure ?", 2*padding_y_from_center_menu_zone);
+		}
+		break;
+
+	case MENU_TYPE_THEME:
+		/// ---- Write current chosen theme -----
+		curLayoutName = Utils::getFileName( (config->layouts_.at(indexChooseLayout)).first );
+
+		// no more than max_chars chars in name to fit screen
+		if(curLayoutName.length() > max_chars){
+			curLayoutName = curLayoutName.substr(0, max_chars-2) + "...";
+		}
+		snprintf(text_tmp, sizeof(text_tmp), "< %s >", curLayoutName.c_str());
+		blit_text_centered(composed, menu_info_font, text_tmp, 0);
+
+		if(menu_action){
+			blit_text_centered(composed, menu_info_font, "In progress...", 2*padding_y_from_center_menu_zone);
+		}
+		else if(menu_confirmation){
+			blit_text_centered(composed, menu_info_font, "Are you sure ?", 2*padding_y_from_center_menu_zone);
+		}
+		break;
+
+	case MENU_TYPE_LAUNCHER:
+		if(menu_action){
+			blit_text_centered(composed, menu_info_font, "In progress...", 2*padding_y_from_center_menu_zone);
+		}
+		else if(menu_confirmation){
+			blit_text_centered(composed, menu_info_font, "Are you sure ?", 2*padding_y_from_center_menu_zone);
+		}
+		break;
+
+	case MENU_TYPE_EXIT:
+	case MENU_TYPE_POWERDOWN:
+		if(menu_action){
+			blit_text_centered(composed, menu_info_font, "Shutting down...", 2*padding_y_from_center_menu_zone);
+		}
+		else if(menu_confirmation){
+			blit_text_centered(composed, menu_info_font, "Are you sure ?", 2*padding_y_from_center_menu_zone);
+		}
+		break;
+	default:
+		break;
+	}
+
+	return composed;
+}
+
 void MenuMode::menu_screen_refresh(int menuItem, int prevItem, int scroll, uint8_t menu_confirmation, uint8_t menu_action){
 	/// --------- Vars ---------
 	int print_arrows = (scroll || usb_sharing)?0:1;
 
+	/// --------- Zones are pre-composed, scrolling only moves them ---------
+	SDL_Surface *prev_zone = compose_menu_zone(prevItem, scroll?0:menu_confirmation, scroll?0:menu_action);
+	SDL_Surface *new_zone = scroll?compose_menu_zone(menuItem, 0, 0):NULL;
+
 	/// --------- Clear HW screen ----------
 	SDL_Surface * virtual_hw_screen = SDL::getWindow();
 	if(SDL_BlitSurface(backup_hw_screen, NULL, virtual_hw_screen, NULL)){
@@ -479,7 +631,7 @@ void MenuMode::menu_screen_refresh(int menuItem, int prevItem, int scroll, uint8
 	/// --------- Blit prev menu Zone going away ----------
 	menu_blit_window.y = scroll;
 	menu_blit_window.h = SCREEN_VERTICAL_SIZE;
-	if(SDL_BlitSurface(menu_zone_surfaces[prevItem], &menu_blit_window, virtual_hw_screen, NULL)){
+	if(SDL_BlitSurface(prev_zone, &menu_blit_window, virtual_hw_screen, NULL)){
 		MENU_ERROR_PRINTF("ERROR Could not Blit surface on virtual_hw_screen: %s\n", SDL_GetError());
 	}
 
@@ -487,202 +639,17 @@ void MenuMode::menu_screen_refresh(int menuItem, int prevItem, int scroll, uint8
 	if(scroll>0){
 		menu_blit_window.y = SCREEN_VERTICAL_SIZE-scroll;
 		menu_blit_window.h = SCREEN_VERTICAL_SIZE;
-		if(SDL_BlitSurface(menu_zone_surfaces[menuItem], NULL, virtual_hw_screen, &menu_blit_window)){
+		if(SDL_BlitSurface(new_zone, NULL, virtual_hw_screen, &menu_blit_window)){
 			MENU_ERROR_PRINTF("ERROR Could not Blit surface on virtual_hw_screen: %s\n", SDL_GetError());
 		}
 	}
 	else if(scroll<0){
 		menu_blit_window.y = SCREEN_VERTICAL_SIZE+scroll;
 		menu_blit_window.h = SCREEN_VERTICAL_SIZE;
-		if(SDL_BlitSurface(menu_zone_surfaces[menuItem], &menu_blit_window, virtual_hw_screen, NULL)){
+		if(SDL_BlitSurface(new_zone, &menu_blit_window, virtual_hw_screen, NULL)){
 			MENU_ERROR_PRINTF("ERROR Could not Blit surface on virtual_hw_screen: %s\n", SDL_GetError());
 		}
 	}
-	/// --------- No Scroll ? Blitting menu-specific info
-	else{
-		SDL_Surface * text_surface = NULL;
-		char text_tmp[100];
-		SDL_Rect text_pos;
-		char fname[MAXPATHLEN];
-		memset(fname, 0, MAXPATHLEN);
-		char *curLayoutName;
-		bool dots=false;
-		int max_chars = 15;
-
-		switch(idx_menus[menuItem]){
-		case MENU_TYPE_VOLUME:
-			draw_progress_bar(virtual_hw_screen, x_volume_bar, y_volume_bar,
-					width_progress_bar, height_progress_bar, volume_percentage, 100/STEP_CHANGE_VOLUME);
-			break;
-
-		case MENU_TYPE_BRIGHTNESS:
-			draw_progress_bar(virtual_hw_screen, x_volume_bar, y_volume_bar,
-					width_progress_bar, height_progress_bar, brightness_percentage, 100/STEP_CHANGE_BRIGHTNESS);
-			break;
-
-		case MENU_TYPE_SAVE:
-			/// ---- Write slot -----
-			sprintf(text_tmp, "IN SLOT   < %d >", savestate_slot+1);
-			text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-			text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-			text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2;
-			SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-
-			if(menu_action){
-				sprintf(text_tmp, "Saving...");
-				text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-			}
-			else{
-				if(menu_confirmation){
-					sprintf(text_tmp, "Are you sure ?");
-					text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-				}
-				else{
-					/// ---- Write current Save state ----
-				}
-			}
-			text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-			text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
-			SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-			break;
-
-		case MENU_TYPE_LOAD:
-			/// ---- Write slot -----
-			sprintf(text_tmp, "FROM SLOT   < %d >", savestate_slot+1);
-			text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-			text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-			text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2;
-			SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-
-			if(menu_action){
-				sprintf(text_tmp, "Loading...");
-				text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-			}
-			else{
-				if(menu_confirmation){
-					sprintf(text_tmp, "Are you sure ?");
-					text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-				}
-				else{
-					/// ---- Write current Load state ----
-				}
-			}
-			text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-			text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
-			SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-			break;
-
-		case MENU_TYPE_ASPECT_RATIO:
-			sprintf(text_tmp, "<   %s   >", aspect_ratio_name[aspect_ratio]);
-			text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-			text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-			text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + padding_y_from_center_menu_zone;
-			SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-			break;
-
-		case MENU_TYPE_USB:
-			/// ---- Write slot -----
-			sprintf(text_tmp, "%s USB", usb_sharing?"EJECT":"MOUNT");
-			text_surface = TTF_RenderText_Blended(menu_title_font, text_tmp, text_color);
-			text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-			text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2;
-			SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-
-			if(menu_action){
-				sprintf(text_tmp, "in progress ...");
-				text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-				text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-				text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
-				SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-			}
-			else if(menu_confirmation){
-				sprintf(text_tmp, "Are you sure ?");
-				text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-				text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-				text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
-				SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-			}
-			else{
-					///Nothing
-			}
-			break;
-
-		case MENU_TYPE_THEME:
-			/// ---- Write current chosen theme -----
-			curLayoutName = (char*)Utils::getFileName( (config->layouts_.at(indexChooseLayout)).first ).c_str();
-
-			// no more than max_chars chars in name to fit screen
-			if(strlen(curLayoutName) > max_chars){
-				curLayoutName[max_chars-2] = 0;
-				dots = true;
-			}
-			sprintf(text_tmp, "< %s%s >", curLayoutName, dots?"...":"" );
-
-			text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-			text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-			text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2;
-			SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-
-			if(menu_action){
-				sprintf(text_tmp, "In progress...");
-				text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-				text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-				text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
-				SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-			}
-			else if(menu_confirmation){
-				sprintf(text_tmp, "Are you sure ?");
-				text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-				text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-				text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
-				SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-			}
-			break;
-
-		case MENU_TYPE_LAUNCHER:
-			if(menu_action){
-				sprintf(text_tmp, "In progress...");
-				text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-				text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-				text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
-				SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-			}
-			else if(menu_confirmation){
-				sprintf(text_tmp, "Are you sure ?");
-				text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-				text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-				text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
-				SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-			}
-			break;
-
-		case MENU_TYPE_EXIT:
-		case MENU_TYPE_POWERDOWN:
-			if(menu_action){
-				sprintf(text_tmp, "Shutting down...");
-				text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-				text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-				text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
-				SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-			}
-			else{
-				if(menu_confirmation){
-					sprintf(text_tmp, "Are you sure ?");
-					text_surface = TTF_RenderText_Blended(menu_info_font, text_tmp, text_color);
-					text_pos.x = (virtual_hw_screen->w - MENU_ZONE_WIDTH)/2 + (MENU_ZONE_WIDTH - text_surface->w)/2;
-					text_pos.y = virtual_hw_screen->h - MENU_ZONE_HEIGHT/2 - text_surface->h/2 + 2*padding_y_from_center_menu_zone;
-					SDL_BlitSurface(text_surface, NULL, virtual_hw_screen, &text_pos);
-				}
-			}
-			break;
-		default:
-			break;
-		}
-
-		/// ------ Free Surfaces -------
-		if(text_surface)
-			SDL_FreeSurface(text_surface);
-	}
 
 	/// --------- Print arrows --------
 	if(print_arrows){
@@ -711,6 +678,9 @@ int MenuMode::launch( )
 	MENU_DEBUG_PRINTF("Launch MenuMode\n");
 
 	SDL_Event event;
+	uint32_t open_ms = SDL_GetTicks();
+	uint32_t refresh_ms = 0;
+	int nb_refresh = 0;
 	uint32_t prev_ms = SDL_GetTicks();
 	uint32_t cur_ms = SDL_GetTicks();
 	int scroll=0;
@@ -724,6 +694,9 @@ int MenuMode::launch( )
 	int returnCode = MENU_RETURN_OK;
 
 	/// ------ Get System values -------
+	/// The service thread reads the levels again in the background, in case a
+	/// game changed them; the loop below picks them up when they are in
+	SystemState::reloadLevels();
 	init_menu_system_values();
 	int prevItem=menuItem;
 
@@ -842,9 +815,8 @@ int MenuMode::launch( )
 							volume_percentage = (volume_percentage < STEP_CHANGE_VOLUME)?
 									0:(volume_percentage-STEP_CHANGE_VOLUME);
 
-							/// ----- Shell cmd ----
-							sprintf(shell_cmd, "%s %d", SHELL_CMD_VOLUME_SET, volume_percentage);
-							system(shell_cmd);
+							/// ----- Applied in the background, key repeats coalesce ----
+							SystemState::setVolume(volume_percentage);
 
 							/// ------ Refresh screen ------
 							screen_refresh = 1;
@@ -855,9 +827,8 @@ int MenuMode::launch( )
 							brightness_percentage = (brightness_percentage < STEP_CHANGE_BRIGHTNESS)?
 									0:(brightness_percentage-STEP_CHANGE_BRIGHTNESS);
 
-							/// ----- Shell cmd ----
-							sprintf(shell_cmd, "%s %d", SHELL_CMD_BRIGHTNESS_SET, brightness_percentage);
-							system(shell_cmd);
+							/// ----- Applied in the background, key repeats coalesce ----
+							SystemState::setBrightness(brightness_percentage);
 
 							/// ------ Refresh screen ------
 							screen_refresh = 1;
@@ -898,9 +869,8 @@ int MenuMode::launch( )
 							volume_percentage = (volume_percentage > 100 - STEP_CHANGE_VOLUME)?
 									100:(volume_percentage+STEP_CHANGE_VOLUME);
 
-							/// ----- Shell cmd ----
-							sprintf(shell_cmd, "%s %d", SHELL_CMD_VOLUME_SET, volume_percentage);
-							system(shell_cmd);
+							/// ----- Applied in the background, key repeats coalesce ----
+							SystemState::setVolume(volume_percentage);
 
 							/// ------ Refresh screen ------
 							screen_refresh = 1;
@@ -911,9 +881,8 @@ int MenuMode::launch( )
 							brightness_percentage = (brightness_percentage > 100 - STEP_CHANGE_BRIGHTNESS)?
 									100:(brightness_percentage+STEP_CHANGE_BRIGHTNESS);
 
-							/// ----- Shell cmd ----
-							sprintf(shell_cmd, "%s %d", SHELL_CMD_BRIGHTNESS_SET, brightness_percentage);
-							system(shell_cmd);
+							/// ----- Applied in the background, key repeats coalesce ----
+							SystemState::setBrightness(brightness_percentage);
 
 							/// ------ Refresh screen ------
 							screen_refresh = 1;
@@ -1014,11 +983,12 @@ int MenuMode::launch( )
 								/// ------ Refresh Screen -------
 								menu_screen_refresh(menuItem, prevItem, scroll, menu_confirmation, 1);
 
-								/// ----- Write new theme and restart RetroFe ----
+								/// ----- Write new theme and let RetroFE rebuild its pages ----
 								config->exportCurrentLayout(Utils::combinePath(Configuration::absolutePath, "layout.conf"),
 										Utils::getFileName( (config->layouts_.at(indexChooseLayout)).first ));
+								config->setCurrentLayout(indexChooseLayout);
 								stop_menu_loop = 1;
-								returnCode = MENU_RETURN_EXIT;
+								returnCode = MENU_RETURN_RELOAD_LAYOUT;
 							}
 							else{
 								MENU_DEBUG_PRINTF("Theme change - asking confirmation\n");
@@ -1111,6 +1081,14 @@ int MenuMode::launch( )
 			screen_refresh = 1;
 		}
 
+		/// --------- Pick up reloaded system levels ---------
+		if(volume_percentage != SystemState::getVolume() ||
+				brightness_percentage != SystemState::getBrightness()){
+			volume_percentage = SystemState::getVolume();
+			brightness_percentage = SystemState::getBrightness();
+			screen_refresh = 1;
+		}
+
 		/// --------- Handle FPS ---------
 		cur_ms = SDL_GetTicks();
 		if(cur_ms-prev_ms < 1000/FPS_MENU){
@@ -1121,7 +1099,14 @@ int MenuMode::launch( )
 
 		/// --------- Refresh screen
 		if(screen_refresh){
+			uint32_t refresh_start_ms = SDL_GetTicks();
 			menu_screen_refresh(menuItem, prevItem, scroll, menu_confirmation, 0);
+			refresh_ms += SDL_GetTicks() - refresh_start_ms;
+			if(nb_refresh++ == 0 && Logger::isEnabled(Logger::ZONE_DEBUG)){
+				std::stringstream ss;
+				ss << "Menu open latency: " << (SDL_GetTicks() - open_ms) << " ms";
+				Logger::write(Logger::ZONE_DEBUG, "MenuMode", ss.str());
+			}
 		}
 
 		/// --------- reset screen refresh ---------
@@ -1132,5 +1117,12 @@ int MenuMode::launch( )
 	if(SDL_EnableKeyRepeat(backup_key_repeat_delay, backup_key_repeat_interval)){
 		MENU_ERROR_PRINTF("ERROR with SDL_EnableKeyRepeat: %s\n", SDL_GetError());
 	}
+
+	if(nb_refresh > 0 && Logger::isEnabled(Logger::ZONE_DEBUG)){
+		std::stringstream ss;
+		ss << "Menu drew " << nb_refresh << " frames, " << (float)refresh_ms / nb_refresh << " ms per frame, "
+		   << text_cache.size() << " cached text lines";
+		Logger::write(Logger::ZONE_DEBUG, "MenuMode", ss.str());
+	}
 	return returnCode;
 }
@@ -3,6 +3,8 @@
 #include <SDL/SDL.h>
 #include <SDL/SDL_ttf.h>
 #include <SDL/SDL_image.h>
+#include <string>
+#include <vector>
 #include "../Database/Configuration.h"
 
 typedef enum{
@@ -22,6 +24,7 @@ typedef enum{
 typedef enum{
     MENU_RETURN_OK,
     MENU_RETURN_EXIT,
+    MENU_RETURN_RELOAD_LAYOUT,
     NB_MENU_RETURN_CODES,
 } ENUM_MENU_RETURN_CODES;
 
@@ -44,10 +47,6 @@ typedef enum {ASPECT_RATIOS} ENUM_ASPECT_RATIOS_TYPES;
 #define STEP_CHANGE_BRIGHTNESS      10
 
 ////------ Menu commands -------
-#define SHELL_CMD_VOLUME_GET                    "volume get"
-#define SHELL_CMD_VOLUME_SET                    "volume set"
-#define SHELL_CMD_BRIGHTNESS_GET                "brightness get"
-#define SHELL_CMD_BRIGHTNESS_SET                "brightness set"
 #define SHELL_CMD_SHARE_IS_USB_DATA_CONNECTED   "share is_usb_data_connected"
 #define SHELL_CMD_SHARE_START                   "share start"
 #define SHELL_CMD_SHARE_STOP                    "share stop"
@@ -107,6 +106,9 @@ private:
     static void init_menu_zones();
     static void init_menu_system_values();
     static void menu_screen_refresh(int menuItem, int prevItem, int scroll, uint8_t menu_confirmation, uint8_t menu_action);
+    static SDL_Surface * render_text(TTF_Font *font, const char *text);
+    static void blit_text_centered(SDL_Surface * surface, TTF_Font *font, const char *text, int offset_y);
+    static SDL_Surface * compose_menu_zone(int item, uint8_t menu_confirmation, uint8_t menu_action);
 
     //static SDL_Surface * hw_screen;
     //static SDL_Surface * virtual_hw_screen; // this one is not rotated
@@ -120,6 +122,8 @@ private:
     static TTF_Font *menu_info_font;
     static TTF_Font *menu_small_info_font;
     static SDL_Surface ** menu_zone_surfaces;
+    static std::vector<SDL_Surface *> menu_zone_composed;
+    static std::vector<std::string> menu_zone_composed_state;
     static int * idx_menus;
     static int nb_menu_zones;
     static int menuItem;
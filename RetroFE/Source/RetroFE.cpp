@@ -23,20 +23,29 @@
 #include "Execute/Launcher.h"
 #include "Menu/Menu.h"
 #include "Menu/MenuMode.h"
+#include "Utility/FramePacer.h"
 #include "Utility/Log.h"
+#include "Utility/SurfaceBudget.h"
+#include "Utility/SystemState.h"
 #include "Utility/Utils.h"
 #include "Collection/MenuParser.h"
 #include "SDL.h"
 #include <SDL/SDL_ttf.h>
 #include "Control/UserInput.h"
 #include "Graphics/PageBuilder.h"
+#include "Graphics/MipChain.h"
 #include "Graphics/Page.h"
+#include "Graphics/SurfaceSnapshot.h"
 #include "Graphics/Component/ScrollingList.h"
 #include "Graphics/Component/Video.h"
+#include "Graphics/Component/VideoComponent.h"
+#include "Sound/SoundCache.h"
 #include "Video/VideoFactory.h"
 #include <algorithm>
+#include <chrono>
 #include <dirent.h>
 #include <fstream>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -82,11 +91,16 @@ RetroFE::RetroFE( Configuration &c )
     , metadb_(NULL)
     , input_(config_)
     , currentPage_(NULL)
+    , pageCache_(2, evictPage)
     , keyInputDisable_(0)
     , currentTime_(0)
     , lastLaunchReturnTime_(0)
     , keyLastTime_(0)
     , keyDelayTime_(.3f)
+    , launchReturnPending_(false)
+    , frameStatsEnabled_(false)
+    , virtualClock_(false)
+    , frame_(0)
 {
     menuMode_ = false;
     mustRender_ = true;
@@ -139,6 +153,9 @@ void RetroFE::render( )
 
     SDL_UnlockMutex( SDL::getMutex( ) );
 
+    // Images left off screen by this frame give up their surfaces first
+    SurfaceBudget::endFrame( );
+
 }
 
 
@@ -199,9 +216,27 @@ void RetroFE::launchEnter( )
     // Disable window focus
     //SDL_SetWindowGrab(SDL::getWindow( ), SDL_FALSE);
 
+    // Optionally keep the decoded surfaces in a compressed snapshot so the
+    // return from the game does not reload them from disk
+    bool launchSnapshot = false;
+    config_.getProperty( "launchSnapshot", launchSnapshot );
+    if ( launchSnapshot )
+    {
+        int maxSize = 16;
+        config_.getProperty( "launchSnapshotMaxSize", maxSize );
+        SurfaceSnapshot::begin( static_cast<size_t>( (maxSize > 0) ? maxSize : 0 ) * 1024 * 1024 );
+    }
+
     // Free the textures, and optionally take down SDL
     freeGraphicsMemory( );
 
+    if ( launchSnapshot )
+    {
+        std::string file;
+        config_.getProperty( "launchSnapshotFile", file );
+        SurfaceSnapshot::seal( file );
+    }
+
 }
 
 
@@ -209,8 +244,16 @@ void RetroFE::launchEnter( )
 void RetroFE::launchExit( )
 {
 
+    launchReturnTime_    = std::chrono::steady_clock::now( );
+    launchReturnPending_ = true;
+
+    // The game may have changed the volume or brightness
+    SystemState::reloadLevels( );
+
     // Optionally set up SDL, and load the textures
+    SurfaceSnapshot::resume( );
     allocateGraphicsMemory( );
+    SurfaceSnapshot::end( );
 
     // Restore the SDL settings
     //SDL_RestoreWindow( SDL::getWindow( ) );
@@ -246,6 +289,10 @@ void RetroFE::freeGraphicsMemory( )
         currentPage_->freeGraphicsMemory( );
     }
 
+    // Drop the cached pages too, whether or not SDL goes down: their
+    // artwork would otherwise stay resident while the game runs
+    pageCache_.clear( );
+
     // Close down SDL
     bool unloadSDL = false;
     config_.getProperty( "unloadSDL", unloadSDL );
@@ -295,7 +342,8 @@ bool RetroFE::deInitialize( )
     // Free textures
     freeGraphicsMemory( );
 
-    // Delete page
+    // Delete pages
+    pageCache_.clear( );
     if ( currentPage_ )
     {
         currentPage_->deInitialize( );
@@ -303,6 +351,9 @@ bool RetroFE::deInitialize( )
         currentPage_ = NULL;
     }
 
+    SoundCache::clear( );
+    MipChain::shutdown( );
+
     // Delete databases
     if ( metadb_ )
     {
@@ -316,6 +367,8 @@ bool RetroFE::deInitialize( )
         db_ = NULL;
     }
 
+    SystemState::stop( );
+
     initialized = false;
 
     Logger::write( Logger::ZONE_INFO, "RetroFE", "Exiting" );
@@ -351,15 +404,78 @@ void RetroFE::run( )
 #endif  //PERIOD_FORCE_REFRESH
 
     // Initialize video
-    bool videoEnable = true;
-    int  videoLoop   = 0;
+    bool  videoEnable       = true;
+    int   videoLoop         = 0;
+    int   videoMaxWidth     = 0;
+    int   videoMaxHeight    = 0;
+    int   videoMaxFrameRate = 0;
+    int   videoStartDelay   = 0;
     config_.getProperty( "videoEnable", videoEnable );
     config_.getProperty( "videoLoop", videoLoop );
+    config_.getProperty( "videoMaxWidth", videoMaxWidth );
+    config_.getProperty( "videoMaxHeight", videoMaxHeight );
+    config_.getProperty( "videoMaxFrameRate", videoMaxFrameRate );
+    config_.getProperty( "videoStartDelay", videoStartDelay );
     VideoFactory::setEnabled( videoEnable );
     VideoFactory::setNumLoops( videoLoop );
+    VideoFactory::setDecodeLimits( videoMaxWidth, videoMaxHeight, videoMaxFrameRate );
+    VideoComponent::setStartDelay( static_cast<float>( videoStartDelay ) / 1000 );
     VideoFactory::createVideo( ); // pre-initialize the gstreamer engine
     Video::setEnabled( videoEnable );
 
+    // Battery, volume and brightness are read and written off the render thread
+    std::string sysfsRoot = "/sys";
+    config_.getProperty( "sysfsRoot", sysfsRoot );
+    std::string fileBatCapacity  = sysfsRoot + "/class/power_supply/axp20x-battery/capacity";
+    std::string fileBatConnected = sysfsRoot + "/class/power_supply/axp20x-battery/present";
+    std::string fileUsbConnected = sysfsRoot + "/class/power_supply/axp20x-usb/present";
+    int systemPollPeriod = 1000;
+    config_.getProperty( "fileBatCapacity", fileBatCapacity );
+    config_.getProperty( "fileBatConnected", fileBatConnected );
+    config_.getProperty( "fileUsbConnected", fileUsbConnected );
+    config_.getProperty( "systemPollPeriod", systemPollPeriod );
+    SystemState::start( fileBatCapacity, fileBatConnected, fileUsbConnected, systemPollPeriod );
+
+    // Frame pacing: sleep between input polls while the page is idle
+    FramePacer pacer( FPS );
+    int idleWakeupPeriod = 50;
+    config_.getProperty( "idleWakeupPeriod", idleWakeupPeriod );
+    pacer.setIdlePollPeriod( (idleWakeupPeriod > 0) ? static_cast<unsigned int>( idleWakeupPeriod ) : 0 );
+
+    // Benchmarking: record or replay key input by frame, and time each frame
+    std::string inputRecord;
+    std::string inputReplay;
+    std::string frameStatsFile;
+    config_.getPropertyAbsolutePath( "inputRecord", inputRecord );
+    config_.getPropertyAbsolutePath( "inputReplay", inputReplay );
+    config_.getPropertyAbsolutePath( "frameStats", frameStatsFile );
+    bool recording = false;
+    if ( !inputReplay.empty( ) && input_.replay( inputReplay ) )
+    {
+        Logger::write( Logger::ZONE_INFO, "RetroFE", "Replaying input from " + inputReplay );
+    }
+    else if ( !inputRecord.empty( ) && input_.record( inputRecord ) )
+    {
+        Logger::write( Logger::ZONE_INFO, "RetroFE", "Recording input to " + inputRecord );
+        recording = true;
+    }
+    frameStatsEnabled_ = input_.isReplaying( ) || !frameStatsFile.empty( );
+    if ( !frameStatsFile.empty( ) )
+    {
+        frameStats_.open( frameStatsFile );
+    }
+    virtualClock_ = SDL::isHeadless( ) || input_.isReplaying( );
+    frame_        = 0;
+
+    // A recording steps the clock by 1/FPS per frame like a replay, paced in
+    // real time, so each recorded frame replays at the same page state
+    bool fixedStep = virtualClock_ || recording;
+
+    // Memory budget for decoded and scaled surfaces, in MB (0 for none)
+    int surfaceBudget = 0;
+    config_.getProperty( "surfaceBudget", surfaceBudget );
+    SurfaceBudget::setBudget( (surfaceBudget > 0) ? static_cast<size_t>( surfaceBudget ) * 1024 * 1024 : 0 );
+
     // Init thread
     bool initMetaDbtmp;
     config_.getProperty( "initMetaDb", initMetaDbtmp );
@@ -398,12 +514,30 @@ void RetroFE::run( )
     Menu     m( config_ );
     preloadTime = static_cast<float>( GET_RUN_TIME_MS ) / 1000;
 
+    // Headless runs, replays and recordings step a fixed clock, so the frame
+    // in which the splash page ends must not depend on how long loading takes
+    if ( fixedStep )
+    {
+        while ( !initialized && !initializeError )
+        {
+            SDL_Delay( 10 );
+        }
+        currentTime_ = 0;
+        preloadTime  = 0;
+    }
+
     while ( running )
     {
 
         float lastTime = 0;
         float deltaTime = 0;
 
+        input_.setFrame( frame_ );
+        if ( frameStatsEnabled_ )
+        {
+            frameStats_.beginFrame( );
+        }
+
         // Exit splash mode when an active key is pressed
         SDL_Event e;
         if ( splashMode )
@@ -673,15 +807,27 @@ void RetroFE::run( )
                 lastMenuOffsets_[currentPage_->getCollectionName( )]   = currentPage_->getScrollOffsetIndex( );
                 lastMenuPlaylists_[currentPage_->getCollectionName( )] = currentPage_->getPlaylistName( );
                 std::string nextPageName = nextPageItem_->name;
+                Page *cachedPage = NULL;
                 if ( !menuMode_ )
                 {
-                    // Load new layout if available
-                    std::string layoutName;
-                    bool userLayout;
-                    config_.getProperty( "layout", layoutName );
-                    config_.getProperty( "userTheme", userLayout );
-                    PageBuilder pb( layoutName, "layout", config_, &fontcache_, false, userLayout);
-                    Page *page = pb.buildPage( nextPageItem_->name );
+                    // Reuse the page as it was left, or load new layout if available
+                    Page *page = NULL;
+                    if ( pageCache_.take( pageCacheKey( nextPageName ), cachedPage ) )
+                    {
+                        Logger::write( Logger::ZONE_INFO, "RetroFE", "Reusing cached page for " + nextPageName );
+                        cachedPage->resumeVideos( );
+                        page = cachedPage;
+                    }
+                    else
+                    {
+                        trimPageCache( );
+                        std::string layoutName;
+                        bool userLayout;
+                        config_.getProperty( "layout", layoutName );
+                        config_.getProperty( "userTheme", userLayout );
+                        PageBuilder pb( layoutName, "layout", config_, &fontcache_, false, userLayout);
+                        page = pb.buildPage( nextPageItem_->name );
+                    }
                     if ( page )
                     {
                         currentPage_->freeGraphicsMemory( );
@@ -692,6 +838,24 @@ void RetroFE::run( )
 
                 config_.setProperty( "currentCollection", nextPageName );
 
+                // A cached page still holds its collection, playlist and scroll
+                // position; without rememberMenu it starts over like a new page
+                if ( cachedPage )
+                {
+                    bool rememberMenu = false;
+                    config_.getProperty( "rememberMenu", rememberMenu );
+                    if ( !rememberMenu )
+                    {
+                        bool autoFavorites = true;
+                        config_.getProperty( "autoFavorites", autoFavorites );
+                        currentPage_->selectPlaylist( autoFavorites ? "favorites" : "all" );
+                        currentPage_->reallocateMenuSpritePoints( );
+                    }
+                    currentPage_->onNewItemSelected( );
+                    state = RETROFE_NEXT_PAGE_MENU_LOAD_ART;
+                    break;
+                }
+
                 CollectionInfo *info;
                 if ( menuMode_ )
                     info = getMenuCollection( nextPageName );
@@ -870,8 +1034,7 @@ void RetroFE::run( )
                 lastMenuPlaylists_[currentPage_->getCollectionName( )] = currentPage_->getPlaylistName( );
                 if (currentPage_->getMenuDepth( ) == 1)
                 {
-                    currentPage_->deInitialize( );
-                    delete currentPage_;
+                    cachePage( currentPage_ );
                     currentPage_ = pages_.top( );
                     pages_.pop( );
                     currentPage_->allocateGraphicsMemory( );
@@ -976,6 +1139,11 @@ void RetroFE::run( )
             if(res == MENU_RETURN_EXIT){
                 state = RETROFE_QUIT_REQUEST;
             }
+            else if(res == MENU_RETURN_RELOAD_LAYOUT){
+                // The new layout is already saved, a restart picks it up if
+                // the pages cannot be rebuilt in place
+                state = reloadLayout( ) ? RETROFE_LOAD_ART : RETROFE_QUIT_REQUEST;
+            }
             else{
                 state = RETROFE_IDLE;
             }
@@ -1030,9 +1198,46 @@ void RetroFE::run( )
         // Handle screen updates and attract mode
         if ( running )
         {
-            // Handle FPS
+            // Handle FPS: when nothing is moving, block until input arrives
+            // or a component next needs an update, otherwise pace frames
+            float idleTimeout = -1;
+            bool  idle        = !fixedStep && state == RETROFE_IDLE && !splashMode && !mustRender_ &&
+                                pacer.getIdlePollPeriod( ) > 0 &&
+                                currentPage_->isIdle( ) && !currentPage_->mustRender( );
+            if ( idle )
+            {
+                idleTimeout = currentPage_->getIdleTimeout( );
+            }
+
             lastTime = currentTime_;
-            currentTime_ = static_cast<float>( GET_RUN_TIME_MS ) / 1000;
+            if ( virtualClock_ )
+            {
+                // Every iteration is one rendered frame of exactly 1/FPS s,
+                // so frame numbers and animation states are reproducible
+                currentTime_ += 1.0f / FPS;
+                forceRender( true );
+            }
+            else
+            {
+                frameStats_.pause( );
+                if ( idle && idleTimeout != 0 )
+                {
+                    pacer.waitForEvent( idleTimeout );
+                }
+                else
+                {
+                    pacer.waitForFrame( );
+                }
+                frameStats_.resume( );
+                if ( fixedStep )
+                {
+                    currentTime_ += 1.0f / FPS;
+                }
+                else
+                {
+                    currentTime_ = static_cast<float>( GET_RUN_TIME_MS ) / 1000;
+                }
+            }
 
             if ( currentTime_ < lastTime )
             {
@@ -1041,12 +1246,6 @@ void RetroFE::run( )
 
             deltaTime = currentTime_ - lastTime;
 
-            double sleepTime = 1000.0/FPS - deltaTime*1000;
-            if ( sleepTime > 0 )
-            {
-                SDL_Delay( static_cast<unsigned int>( sleepTime ) );
-            }
-
             // ------- Check if previous update of page needed to be rendered -------
             if(!currentPage_->isIdle( ) || currentPage_->mustRender( ) || splashMode){
                 //printf("Not idle\n");
@@ -1072,12 +1271,41 @@ void RetroFE::run( )
                 //printf("render\n");
                 mustRender_ = false;
                 render( );
+
+                if ( launchReturnPending_ )
+                {
+                    launchReturnPending_ = false;
+                    std::stringstream ss;
+                    ss << "First frame " << std::chrono::duration<float, std::milli>( std::chrono::steady_clock::now( ) - launchReturnTime_ ).count( ) << " ms after game exit";
+                    Logger::write( Logger::ZONE_INFO, "RetroFE", ss.str( ) );
+                }
 #ifdef PERIOD_FORCE_REFRESH
 		ticks_last_refresh = static_cast<int>(GET_RUN_TIME_MS);
 #endif  //PERIOD_FORCE_REFRESH
             }
+
+            if ( frameStatsEnabled_ )
+            {
+                frameStats_.endFrame( frame_ );
+            }
+            frame_++;
+
+            if ( SDL::isHeadlessDone( ) || input_.isReplayFinished( ) )
+            {
+                running = false;
+            }
         }
     }
+
+    input_.stopRecording( );
+    if ( frameStatsEnabled_ && !frameStats_.isEmpty( ) )
+    {
+        std::string report = frameStats_.report( );
+        Logger::write( Logger::ZONE_NOTICE, "RetroFE", "Frame times: " + report );
+        printf( "Frame times: %s\n", report.c_str( ) );
+        printf( "Surface memory: %s\n", SurfaceBudget::report( ).c_str( ) );
+    }
+    Logger::write( Logger::ZONE_INFO, "RetroFE", "Surface memory: " + SurfaceBudget::report( ) );
 }
 
 
@@ -1436,6 +1664,177 @@ Page *RetroFE::loadSplashPage( )
 }
 
 
+// Rebuild the page stack for the layout now set in the configuration. The
+// collections of the old pages are handed over to the new ones, so nothing
+// is rescanned; only fonts no new page uses are released.
+bool RetroFE::reloadLayout( )
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now( );
+    std::string layoutName;
+    bool userLayout;
+    config_.getProperty( "layout", layoutName );
+    config_.getProperty( "userTheme", userLayout );
+
+    pageCache_.clear( );
+    fontcache_.markUnused( );
+    Page *page = loadPage( );
+    if ( !page )
+    {
+        Logger::write( Logger::ZONE_ERROR, "RetroFE", "Could not switch to layout \"" + layoutName + "\"" );
+        return false;
+    }
+
+    // Take the collections off the old pages, bottom page first
+    std::vector<Page *> oldPages;
+    oldPages.push_back( currentPage_ );
+    while ( !pages_.empty( ) )
+    {
+        oldPages.insert( oldPages.begin( ), pages_.top( ) );
+        pages_.pop( );
+    }
+
+    lastMenuOffsets_[currentPage_->getCollectionName( )]   = currentPage_->getScrollOffsetIndex( );
+    lastMenuPlaylists_[currentPage_->getCollectionName( )] = currentPage_->getPlaylistName( );
+    currentPage_->stop( );
+    currentPage_->freeGraphicsMemory( );
+
+    std::vector< std::vector<CollectionInfo *> > collections( oldPages.size( ) );
+    for ( unsigned int i = 0; i < oldPages.size( ); ++i )
+    {
+        oldPages[i]->detachCollections( collections[i] );
+        oldPages[i]->deInitialize( );
+        delete oldPages[i];
+    }
+    currentPage_ = NULL;
+
+    // Rebuild the stack; collections whose page cannot be built for the new
+    // layout stay on the page below, as when entering them
+    for ( unsigned int i = 0; i < collections.size( ); ++i )
+    {
+        if ( collections[i].empty( ) )
+        {
+            continue;
+        }
+
+        if ( i > 0 )
+        {
+            PageBuilder pb( layoutName, "layout", config_, &fontcache_, false, userLayout );
+            Page *next = pb.buildPage( collections[i].front( )->name );
+            if ( next )
+            {
+                page->freeGraphicsMemory( );
+                pages_.push( page );
+                page = next;
+            }
+        }
+
+        for ( std::vector<CollectionInfo *>::iterator it = collections[i].begin( ); it != collections[i].end( ); ++it )
+        {
+            page->pushCollection( *it );
+            if ( lastMenuPlaylists_.find( (*it)->name ) != lastMenuPlaylists_.end( ) )
+            {
+                page->selectPlaylist( lastMenuPlaylists_[(*it)->name] );
+            }
+        }
+    }
+    currentPage_ = page;
+
+    std::string collectionName = currentPage_->getCollectionName( );
+    config_.setProperty( "currentCollection", collectionName );
+    if ( lastMenuOffsets_.find( collectionName ) != lastMenuOffsets_.end( ) )
+    {
+        currentPage_->setScrollOffsetIndex( lastMenuOffsets_[collectionName] );
+    }
+    currentPage_->onNewItemSelected( );
+    currentPage_->reallocateMenuSpritePoints( );
+
+    fontcache_.purgeUnused( );
+
+    std::stringstream ss;
+    ss << "Switched to layout \"" << layoutName << "\" in "
+       << std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now( ) - start ).count( ) << " ms";
+    Logger::write( Logger::ZONE_INFO, "RetroFE", ss.str( ) );
+
+    return true;
+}
+
+
+// Pages are cached per layout and collection
+std::string RetroFE::pageCacheKey( std::string collectionName )
+{
+    std::string layoutName;
+    bool userLayout = false;
+    config_.getProperty( "layout", layoutName );
+    config_.getProperty( "userTheme", userLayout );
+
+    return (userLayout ? "user:" : "") + layoutName + ":" + collectionName;
+}
+
+
+// Keep a page that was just left, with its artwork and scroll position,
+// so entering the same collection again does not rebuild it. Its videos
+// are stopped until it is reused.
+void RetroFE::cachePage( Page *page )
+{
+    int pageCacheSize = 2;
+    config_.getProperty( "pageCacheSize", pageCacheSize );
+
+    page->cleanup( );
+    page->suspendVideos( );
+    if ( pageCacheSize <= 0 )
+    {
+        std::string key;
+        evictPage( key, page );
+        return;
+    }
+
+    pageCache_.setCapacity( pageCacheSize );
+    pageCache_.insert( pageCacheKey( page->getCollectionName( ) ), page );
+    trimPageCache( );
+}
+
+
+// Evict cached pages, oldest first, while the system runs low on memory
+void RetroFE::trimPageCache( )
+{
+    int minFreeMemory = 32;
+    config_.getProperty( "pageCacheMinFreeMemory", minFreeMemory );
+
+    while ( pageCache_.size( ) > 0 )
+    {
+        std::ifstream meminfo( "/proc/meminfo" );
+        std::string key;
+        long availableKb = -1;
+        while ( meminfo >> key )
+        {
+            if ( key == "MemAvailable:" )
+            {
+                meminfo >> availableKb;
+                break;
+            }
+            meminfo.ignore( std::numeric_limits<std::streamsize>::max( ), '\n' );
+        }
+
+        if ( availableKb < 0 || availableKb / 1024 >= minFreeMemory )
+        {
+            break;
+        }
+
+        Logger::write( Logger::ZONE_INFO, "RetroFE", "Low on memory, evicting a cached page" );
+        pageCache_.evictOldest( );
+    }
+}
+
+
+void RetroFE::evictPage( const std::string &key, Page *&page )
+{
+    page->freeGraphicsMemory( );
+    page->deInitialize( );
+    delete page;
+    page = NULL;
+}
+
+
 // Load a collection
 CollectionInfo *RetroFE::getCollection(std::string collectionName)
 {
@@ -1603,6 +2002,11 @@ void RetroFE::handle_sigusr1(int sig)
 /* Quick save and turn off the console */
 void RetroFE::quick_poweroff()
 {
+    /* exit() below skips deInitialize(), so join the worker threads here */
+    SoundCache::shutdown();
+    MipChain::shutdown();
+    SystemState::stop();
+
     /* Send command to cancel any previously scheduled powerdown */
     if (popen(SHELL_CMD_POWERDOWN_HANDLE, "r") == NULL)
     {
@@ -1613,6 +2017,7 @@ void RetroFE::quick_poweroff()
         std::stringstream ss;
         ss << "Failed to run command " << SHELL_CMD_POWERDOWN_HANDLE;
         Logger::write( Logger::ZONE_ERROR, "RetroFE", ss.str() );
+        Logger::deInitialize();
         exit(0);
     }
 
@@ -1623,5 +2028,6 @@ void RetroFE::quick_poweroff()
     printf("Failed to perform shutdown\n");
 
     /* Exit Emulator */
+    Logger::deInitialize();
     exit(0);
 }
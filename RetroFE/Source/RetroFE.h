@@ -22,10 +22,13 @@
 #include "Database/MetadataDatabase.h"
 #include "Execute/AttractMode.h"
 #include "Graphics/FontCache.h"
+#include "Utility/FrameStats.h"
+#include "Utility/LruCache.h"
 #include "Video/IVideo.h"
 #include "Video/VideoFactory.h"
 #include <SDL/SDL.h>
 #include <SDL/SDL_ttf.h>
+#include <chrono>
 #include <list>
 #include <stack>
 #include <map>
@@ -110,10 +113,15 @@ private:
     void            quit( );
     Page           *loadPage( );
     Page           *loadSplashPage( );
+    bool            reloadLayout( );
     RETROFE_STATE   processUserInput( Page *page );
     void            update( float dt, bool scrollActive );
     CollectionInfo *getCollection( std::string collectionName );
     CollectionInfo *getMenuCollection( std::string collectionName );
+    std::string     pageCacheKey( std::string collectionName );
+    void            cachePage( Page *page );
+    void            trimPageCache( );
+    static void     evictPage( const std::string &key, Page *&page );
     void            printState(RETROFE_STATE state);
 
     Configuration     &config_;
@@ -122,6 +130,7 @@ private:
     UserInput          input_;
     Page              *currentPage_;
     std::stack<Page *> pages_;
+    LruCache<std::string, Page *> pageCache_;
     float              keyInputDisable_;
     float              currentTime_;
     float              lastLaunchReturnTime_;
@@ -132,6 +141,12 @@ private:
     AttractMode        attract_;
     bool               menuMode_;
     bool               mustRender_;
+    bool               launchReturnPending_;
+    std::chrono::steady_clock::time_point launchReturnTime_;
+    FrameStats         frameStats_;
+    bool               frameStatsEnabled_;
+    bool               virtualClock_;
+    unsigned int       frame_;
 
     std::map<std::string, unsigned int> lastMenuOffsets_;
     std::map<std::string, std::string>  lastMenuPlaylists_;
@@ -17,8 +17,17 @@
 
 #include "SDL.h"
 #include "Database/Configuration.h"
+#include "Graphics/AlphaBlend.h"
+#include "Graphics/MipChain.h"
+#include "Graphics/Reflector.h"
+#include "Graphics/Rotator.h"
 #include "Utility/Log.h"
+#include "Utility/Utils.h"
 #include <SDL/SDL_mixer.h>
+#include <cstdio>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/types.h>
 //#include <SDL/SDL_rotozoom.h>
 //#include <SDL/SDL_gfxBlitFunc.h>
 
@@ -50,6 +59,19 @@ int           SDL::windowWidth_   = 0;
 int           SDL::windowHeight_  = 0;
 bool          SDL::fullscreen_    = false;
 bool          SDL::showFrame_    		= true;
+bool          SDL::headless_      = false;
+unsigned int  SDL::headlessFrames_ = 0;
+unsigned int  SDL::frameNumber_   = 0;
+bool          SDL::dumpAllFrames_ = false;
+std::set<unsigned int> SDL::dumpFrames_;
+FrameCapture::Format SDL::dumpFormat_ = FrameCapture::FormatPng;
+std::string   SDL::dumpPath_;
+FILE         *SDL::checksumFile_  = NULL;
+SDL::RotationCache_T *SDL::rotations_ = NULL;
+std::map<SDL_Surface *, int> SDL::rotationRefs_;
+float         SDL::rotationStep_  = 0.5f;
+size_t        SDL::rotationBytes_ = 0;
+SurfaceBudget::Account SDL::rotationAccount_;
 
 
 // Initialize SDL
@@ -63,11 +85,16 @@ bool SDL::initialize( Configuration &config )
     int         audioRate     = MIX_DEFAULT_FREQUENCY;
     Uint16      audioFormat   = MIX_DEFAULT_FORMAT; /* 16-bit stereo */
     int         audioChannels = 1;
-    int         audioBuffers  = 4096;
+    int         audioBuffers  = 1024;
     bool        hideMouse;
     const SDL_VideoInfo* videoInfo;
 
     Logger::write( Logger::ZONE_INFO, "SDL", "Initializing" );
+    if ( !initializeHeadless( config ) )
+    {
+        retVal = false;
+    }
+
     if (retVal && SDL_Init( SDL_INIT_EVERYTHING ) != 0)
     {
         std::string error = SDL_GetError( );
@@ -102,6 +129,13 @@ bool SDL::initialize( Configuration &config )
 	    displayHeight_ = videoInfo->current_h;
         }
 
+        // the dummy driver has no display to stretch to
+        if ( retVal && headless_ && (displayWidth_ <= 0 || displayHeight_ <= 0) )
+        {
+            displayWidth_  = 640;
+            displayHeight_ = 480;
+        }
+
         if ( !config.getProperty( "horizontal", hString ) )
         {
             Logger::write( Logger::ZONE_ERROR, "Configuration", "Missing property \"horizontal\"" );
@@ -164,8 +198,11 @@ bool SDL::initialize( Configuration &config )
 
         Logger::write( Logger::ZONE_INFO, "SDL", ss.str( ));
 
-        window_ = SDL_SetVideoMode(windowWidth_, windowHeight_, 32, windowFlags);
-        if ( window_ == NULL )
+        if ( !headless_ )
+        {
+            window_ = SDL_SetVideoMode(windowWidth_, windowHeight_, 32, windowFlags);
+        }
+        if ( !headless_ && window_ == NULL )
         {
             std::string error = SDL_GetError( );
             Logger::write( Logger::ZONE_ERROR, "SDL", "SDL_SetVideoMode failed: " + error );
@@ -249,11 +286,35 @@ bool SDL::initialize( Configuration &config )
         }
     }
 
+    // A small mixer buffer keeps UI sounds in step with the screen
+    config.getProperty( "audioBuffer", audioBuffers );
+    int soundChannels = 4;
+    config.getProperty( "soundChannels", soundChannels );
+
     if ( retVal && Mix_OpenAudio( audioRate, audioFormat, audioChannels, audioBuffers ) == -1 )
     {
         std::string error = Mix_GetError( );
         Logger::write( Logger::ZONE_WARNING, "SDL", "Audio initialize failed: " + error );
     }
+    else if ( retVal && soundChannels > 0 )
+    {
+        Mix_AllocateChannels( soundChannels );
+    }
+
+    // Half size copies of artwork, built in the background, to scale from
+    bool artworkMips = true;
+    config.getProperty( "artworkMips", artworkMips );
+    MipChain::setEnabled( artworkMips );
+
+    // Rotated artwork is kept, so a tilted image is only rotated once
+    std::string rotationStep;
+    int rotationCacheSize = 32;
+    if ( config.getProperty( "rotationStep", rotationStep ) )
+    {
+        rotationStep_ = Utils::convertFloat( rotationStep );
+    }
+    config.getProperty( "rotationCacheSize", rotationCacheSize );
+    rotations_ = new RotationCache_T( MAX( rotationCacheSize, 1 ), releaseRotation );
 
     return retVal;
 
@@ -283,12 +344,24 @@ bool SDL::deInitialize( )
         renderer_ = NULL;
     }*/
 
+    if ( rotations_ )
+    {
+        delete rotations_;
+        rotations_ = NULL;
+    }
+
     if ( window_virtual_ )
     {
         SDL_FreeSurface(window_virtual_);
         window_virtual_ = NULL;
     }
 
+    if ( checksumFile_ )
+    {
+        fclose(checksumFile_);
+        checksumFile_ = NULL;
+    }
+
     /*if ( texture_copy_alpha_ )
     {
         SDL_FreeSurface(texture_copy_alpha_);
@@ -387,6 +460,7 @@ void SDL::ditherSurface32bppTo16Bpp(SDL_Surface * src_surface){
 		printf("Error: src_surface is %dBpp while dst_surface is not 32\n", src_surface->format->BitsPerPixel);
 		return;
 	}
+	surfaceChanged(src_surface);
 
 	/* Loop for dithering */
 	for (y=0; y<src_surface->h; y++){
@@ -456,6 +530,18 @@ void SDL::ditherSurface32bppTo16Bpp(SDL_Surface * src_surface){
 // Copy virtual window to HW window and Flip display
 void SDL::renderAndFlipWindow( )
 {
+	// Drop the rotations of surfaces their owners have freed since
+	if ( rotations_ && rotations_->size( ) > 0 )
+	{
+		rotations_->eraseIf( []( const RotationKey &key, SDL_Surface *& ) { return key.surface->refcount <= 1; } );
+	}
+
+	if ( headless_ )
+	{
+		captureFrame( );
+		return;
+	}
+
 	//SDL_BlitSurface(window_virtual_, NULL, window_, NULL);
 	SDL_Rotate_270(window_virtual_, window_);
 
@@ -464,6 +550,154 @@ void SDL::renderAndFlipWindow( )
 
 
 
+// Select the offscreen backend before SDL starts, so no display is needed:
+// frames are only drawn into window_virtual_ and captured from there
+bool SDL::initializeHeadless( Configuration &config )
+{
+    std::string dumpFrames;
+    std::string dumpFormat = "png";
+    int frames = 0;
+    bool checksums = false;
+
+    headless_ = false;
+    config.getProperty( "headless", headless_ );
+    if ( !headless_ )
+    {
+        return true;
+    }
+
+    config.getProperty( "headlessFrames", frames );
+    config.getProperty( "headlessDumpFrames", dumpFrames );
+    config.getProperty( "headlessDumpFormat", dumpFormat );
+    config.getProperty( "headlessChecksums", checksums );
+    if ( !config.getPropertyAbsolutePath( "headlessDumpPath", dumpPath_ ) )
+    {
+        dumpPath_ = Utils::combinePath( Configuration::absolutePath, "frames" );
+    }
+
+    headlessFrames_ = (frames > 0) ? static_cast<unsigned int>( frames ) : 0;
+    frameNumber_    = 0;
+    dumpFormat_     = (Utils::toLower( dumpFormat ) == "raw") ? FrameCapture::FormatRaw : FrameCapture::FormatPng;
+    dumpAllFrames_  = Utils::toLower( Utils::trimEnds( dumpFrames ) ) == "all";
+    dumpFrames_.clear( );
+    if ( !dumpAllFrames_ )
+    {
+        std::stringstream ss( dumpFrames );
+        std::string frame;
+        while ( std::getline( ss, frame, ',' ) )
+        {
+            frame = Utils::trimEnds( frame );
+            if ( !frame.empty( ) )
+            {
+                dumpFrames_.insert( static_cast<unsigned int>( Utils::convertInt( frame ) ) );
+            }
+        }
+    }
+
+    // an explicit driver in the environment (e.g. a virtual framebuffer) wins
+    if ( !SDL_getenv( "SDL_VIDEODRIVER" ) )
+    {
+        SDL_putenv( const_cast<char *>( "SDL_VIDEODRIVER=dummy" ) );
+    }
+    if ( !SDL_getenv( "SDL_AUDIODRIVER" ) )
+    {
+        SDL_putenv( const_cast<char *>( "SDL_AUDIODRIVER=dummy" ) );
+    }
+
+    if ( checksums || dumpAllFrames_ || !dumpFrames_.empty( ) )
+    {
+        struct stat info;
+#if defined(__MINGW32__)
+        if ( stat( dumpPath_.c_str( ), &info ) != 0 && mkdir( dumpPath_.c_str( ) ) == -1 )
+#else
+        if ( stat( dumpPath_.c_str( ), &info ) != 0 && mkdir( dumpPath_.c_str( ), 0755 ) == -1 )
+#endif
+        {
+            Logger::write( Logger::ZONE_ERROR, "SDL", "Could not create frame dump directory " + dumpPath_ );
+            return false;
+        }
+    }
+
+    if ( checksums )
+    {
+        std::string checksumPath = Utils::combinePath( dumpPath_, "checksums.txt" );
+        checksumFile_ = fopen( checksumPath.c_str( ), "w" );
+        if ( !checksumFile_ )
+        {
+            Logger::write( Logger::ZONE_ERROR, "SDL", "Could not open " + checksumPath );
+            return false;
+        }
+    }
+
+    std::stringstream ss;
+    ss << "Rendering headless";
+    if ( headlessFrames_ > 0 )
+    {
+        ss << " for " << headlessFrames_ << " frames";
+    }
+    Logger::write( Logger::ZONE_INFO, "SDL", ss.str( ) );
+
+    return true;
+}
+
+
+FrameCapture::Frame SDL::describeFrame( )
+{
+    FrameCapture::Frame frame;
+
+    frame.pixels = static_cast<const uint8_t *>( window_virtual_->pixels );
+    frame.width  = window_virtual_->w;
+    frame.height = window_virtual_->h;
+    frame.pitch  = window_virtual_->pitch;
+    frame.rShift = window_virtual_->format->Rshift;
+    frame.gShift = window_virtual_->format->Gshift;
+    frame.bShift = window_virtual_->format->Bshift;
+
+    return frame;
+}
+
+
+// Checksum of the frame currently drawn into the window
+uint64_t SDL::frameChecksum( )
+{
+    if ( !window_virtual_ )
+    {
+        return 0;
+    }
+    return FrameCapture::checksum( describeFrame( ) );
+}
+
+
+bool SDL::dumpFrame( std::string path, FrameCapture::Format format )
+{
+    if ( !window_virtual_ || !FrameCapture::write( path, describeFrame( ), format ) )
+    {
+        Logger::write( Logger::ZONE_WARNING, "SDL", "Could not dump frame to " + path );
+        return false;
+    }
+    return true;
+}
+
+
+// Headless stand-in for the flip: record the finished frame
+void SDL::captureFrame( )
+{
+    if ( checksumFile_ )
+    {
+        fprintf( checksumFile_, "%u %s\n", frameNumber_, FrameCapture::checksumString( frameChecksum( ) ).c_str( ) );
+    }
+
+    if ( dumpAllFrames_ || dumpFrames_.count( frameNumber_ ) )
+    {
+        char name[32];
+        snprintf( name, sizeof( name ), "frame%06u.%s", frameNumber_, (dumpFormat_ == FrameCapture::FormatRaw) ? "raw" : "png" );
+        dumpFrame( Utils::combinePath( dumpPath_, name ), dumpFormat_ );
+    }
+
+    frameNumber_++;
+}
+
+
 Uint32 SDL::get_pixel32( SDL_Surface *surface, int x, int y )
 {
     //Convert the pixels to 32 bit
@@ -549,6 +783,70 @@ SDL_Surface * SDL::flip_surface( SDL_Surface *surface, int flags )
 }
 
 /// Nearest neighboor optimized with possible out of screen coordinates (for cropping)
+// Filter a 32bpp surface (or source, one of its mip levels, when it has
+// pixels) to width x height and crop it to crop, in one pass. *dst is reused
+// when it already has the cropped size, otherwise it is replaced. Parts of
+// the crop that fall outside the scaled image are left transparent.
+bool SDL::resampleSurface( SDL_Surface *src, Resampler::Image source, int width, int height, SDL_Rect *crop, SDL_Surface **dst )
+{
+    if ( !src || !dst || src->format->BytesPerPixel != 4 || width <= 0 || height <= 0 )
+    {
+        return false;
+    }
+
+    if ( !source.pixels )
+    {
+        source.pixels = static_cast<const uint32_t *>( src->pixels );
+        source.pitch  = src->pitch;
+        source.width  = src->w;
+        source.height = src->h;
+    }
+
+    int outWidth  = crop ? crop->w : width;
+    int outHeight = crop ? crop->h : height;
+    int cropX     = crop ? crop->x : 0;
+    int cropY     = crop ? crop->y : 0;
+    if ( outWidth <= 0 || outHeight <= 0 )
+    {
+        return false;
+    }
+
+    if ( *dst && ((*dst)->w != outWidth || (*dst)->h != outHeight) )
+    {
+        SDL_FreeSurface( *dst );
+        *dst = NULL;
+    }
+    if ( *dst )
+    {
+        surfaceChanged( *dst );
+    }
+    if ( !*dst )
+    {
+        *dst = SDL_CreateRGBSurface( src->flags, outWidth, outHeight, 32,
+                                     src->format->Rmask, src->format->Gmask, src->format->Bmask, src->format->Amask );
+        if ( !*dst )
+        {
+            Logger::write( Logger::ZONE_ERROR, "SDL", "Cannot create resampled surface: " + std::string( SDL_GetError( ) ) );
+            return false;
+        }
+    }
+
+    // The part of the crop window covered by the scaled image
+    int offsetX = MAX( -cropX, 0 );
+    int offsetY = MAX( -cropY, 0 );
+    if ( offsetX > 0 || offsetY > 0 || cropX + outWidth > width || cropY + outHeight > height )
+    {
+        memset( (*dst)->pixels, 0, (*dst)->pitch * (*dst)->h );
+    }
+
+    uint32_t *pixels = reinterpret_cast<uint32_t *>( static_cast<Uint8 *>( (*dst)->pixels ) + offsetY * (*dst)->pitch + offsetX * 4 );
+    Resampler::scale( source, width, height, pixels, (*dst)->pitch,
+                      cropX + offsetX, cropY + offsetY, outWidth - offsetX, outHeight - offsetY );
+
+    return true;
+}
+
+
 SDL_Surface * SDL::zoomSurface(SDL_Surface *src_surface, SDL_Rect *src_rect_origin, SDL_Rect *dst_rect, SDL_Rect *post_cropping_rect){
 
 	/* Declare vars */
@@ -592,6 +890,19 @@ SDL_Surface * SDL::zoomSurface(SDL_Surface *src_surface, SDL_Rect *src_rect_orig
 		printf("ERROR src_rect->y (%d) > src_rect->h(%d) \n", srcRect.y, srcRect.h);
 		return NULL;
 	}
+	/* 32bpp surfaces are filtered instead of point sampled */
+	if( src_surface->format->BytesPerPixel == 4 ){
+		Resampler::Image source;
+		source.pixels = reinterpret_cast<const uint32_t *>( static_cast<Uint8 *>( src_surface->pixels ) + srcRect.y * src_surface->pitch + srcRect.x * 4 );
+		source.pitch  = src_surface->pitch;
+		source.width  = MIN( srcRect.w, src_surface->w - srcRect.x );
+		source.height = MIN( srcRect.h, src_surface->h - srcRect.y );
+
+		SDL_Surface *dst_surface = NULL;
+		resampleSurface(src_surface, source, dst_rect->w, dst_rect->h, post_cropping_rect, &dst_surface);
+		return dst_surface;
+	}
+
 	if( post_cropping_rect != NULL ){
 		if( post_cropping_rect->w > dst_rect->w){
 			post_cropping_rect->w = dst_rect->w;
@@ -693,6 +1004,270 @@ SDL_Surface * SDL::zoomSurface(SDL_Surface *src_surface, SDL_Rect *src_rect_orig
 }
 
 
+// 32bpp with the alpha (if any) in the top byte: what Rotator, Reflector
+// and blitAlpha work on
+bool SDL::hasBlendableFormat( SDL_Surface *surface )
+{
+    SDL_PixelFormat *format = surface->format;
+
+    return format->BytesPerPixel == 4 && !(surface->flags & SDL_SRCCOLORKEY) &&
+           format->Gmask == 0x0000ff00 && (format->Rmask | format->Bmask) == 0x00ff00ff &&
+           (format->Amask == 0 || format->Amask == 0xff000000);
+}
+
+
+// The reflection of src described by viewInfo, to draw next to it with one
+// blit. The caller owns the result; NULL when there is no reflection.
+SDL_Surface *SDL::createReflection( SDL_Surface *src, const ViewInfo &viewInfo )
+{
+    int width;
+    int height;
+
+    if ( !src || !hasBlendableFormat( src ) ||
+         !Reflector::size( src->w, src->h, viewInfo.Reflection, viewInfo.ReflectionScale, width, height ) )
+    {
+        return NULL;
+    }
+
+    SDL_PixelFormat *format = src->format;
+    SDL_Surface *reflection = SDL_CreateRGBSurface( SDL_SWSURFACE, width, height, 32,
+                                                    format->Rmask, format->Gmask, format->Bmask, 0xff000000 );
+    if ( !reflection )
+    {
+        Logger::write( Logger::ZONE_ERROR, "SDL", "Cannot create reflection surface: " + std::string( SDL_GetError( ) ) );
+        return NULL;
+    }
+
+    Resampler::Image source;
+    source.pixels = static_cast<const uint32_t *>( src->pixels );
+    source.pitch  = src->pitch;
+    source.width  = src->w;
+    source.height = src->h;
+
+    if ( SDL_MUSTLOCK( src ) ) SDL_LockSurface( src );
+    Reflector::build( source, viewInfo.Reflection, viewInfo.ReflectionAlpha, format->Amask ? 0 : 0xff000000,
+                      static_cast<uint32_t *>( reflection->pixels ), reflection->pitch, width, height );
+    if ( SDL_MUSTLOCK( src ) ) SDL_UnlockSurface( src );
+
+    return reflection;
+}
+
+
+bool SDL::RotationKey::operator<( const RotationKey &other ) const
+{
+    if ( surface != other.surface ) return surface < other.surface;
+    if ( angle != other.angle ) return angle < other.angle;
+    if ( width != other.width ) return width < other.width;
+    if ( height != other.height ) return height < other.height;
+    if ( src.x != other.src.x ) return src.x < other.src.x;
+    if ( src.y != other.src.y ) return src.y < other.src.y;
+    if ( src.w != other.src.w ) return src.w < other.src.w;
+    if ( src.h != other.src.h ) return src.h < other.src.h;
+    if ( crop.x != other.crop.x ) return crop.x < other.crop.x;
+    if ( crop.y != other.crop.y ) return crop.y < other.crop.y;
+    if ( crop.w != other.crop.w ) return crop.w < other.crop.w;
+    return crop.h < other.crop.h;
+}
+
+
+// srcRect of texture, scaled to dstRect, cropped to crop and rotated by
+// angle (rounded to rotationStep_). Rotations are cached, so artwork that
+// stays tilted is rotated once; the cache owns the returned surface. Returns
+// NULL when the angle rounds to 0 or the format is not supported, and the
+// texture is then drawn unrotated.
+SDL_Surface *SDL::rotateSurface( SDL_Surface *texture, SDL_Rect *srcRect, SDL_Rect *dstRect, SDL_Rect *crop, float angle )
+{
+    SDL_PixelFormat *format = texture->format;
+
+    if ( !rotations_ || !hasBlendableFormat( texture ) )
+    {
+        return NULL;
+    }
+
+    RotationKey key;
+    key.surface = texture;
+    key.angle   = Rotator::quantize( angle, rotationStep_ );
+    key.src     = *srcRect;
+    key.width   = dstRect->w;
+    key.height  = dstRect->h;
+    if ( crop )
+    {
+        key.crop = *crop;
+    }
+    else
+    {
+        key.crop.x = 0;
+        key.crop.y = 0;
+        key.crop.w = dstRect->w;
+        key.crop.h = dstRect->h;
+    }
+    if ( key.angle == 0 )
+    {
+        return NULL;
+    }
+
+    SDL_Surface **cached = rotations_->find( key );
+    if ( cached )
+    {
+        return *cached;
+    }
+
+    // Scale and crop first, so the rotation runs at the size it is drawn
+    SDL_Surface *scaled = NULL;
+    Resampler::Image source;
+    if ( key.src.w != key.crop.w || key.src.h != key.crop.h )
+    {
+        SDL_Rect scaleSrc  = key.src;
+        SDL_Rect scaleDst  = *dstRect;
+        SDL_Rect scaleCrop = key.crop;
+        scaled = zoomSurface( texture, &scaleSrc, &scaleDst, crop ? &scaleCrop : NULL );
+        if ( !scaled )
+        {
+            return NULL;
+        }
+        source.pixels = static_cast<const uint32_t *>( scaled->pixels );
+        source.pitch  = scaled->pitch;
+        source.width  = scaled->w;
+        source.height = scaled->h;
+    }
+    else
+    {
+        source.pixels = reinterpret_cast<const uint32_t *>( static_cast<Uint8 *>( texture->pixels ) + key.src.y * texture->pitch + key.src.x * 4 );
+        source.pitch  = texture->pitch;
+        source.width  = MIN( key.src.w, texture->w - key.src.x );
+        source.height = MIN( key.src.h, texture->h - key.src.y );
+    }
+
+    int width;
+    int height;
+    Rotator::boundingBox( source.width, source.height, key.angle, width, height );
+    SDL_Surface *rotated = SDL_CreateRGBSurface( SDL_SWSURFACE, width, height, 32,
+                                                 format->Rmask, format->Gmask, format->Bmask, 0xff000000 );
+    if ( !rotated )
+    {
+        Logger::write( Logger::ZONE_ERROR, "SDL", "Cannot create rotated surface: " + std::string( SDL_GetError( ) ) );
+    }
+    else
+    {
+        if ( !scaled && SDL_MUSTLOCK( texture ) ) SDL_LockSurface( texture );
+        Rotator::rotate( source, key.angle, format->Amask ? 0 : 0xff000000,
+                         static_cast<uint32_t *>( rotated->pixels ), rotated->pitch, width, height );
+        if ( !scaled && SDL_MUSTLOCK( texture ) ) SDL_UnlockSurface( texture );
+
+        // Hold a reference, so the address cannot be reused by another
+        // surface while rotations of it are cached
+        if ( rotationRefs_[texture]++ == 0 )
+        {
+            texture->refcount++;
+        }
+        rotations_->insert( key, rotated );
+        rotationBytes_ += surfaceBytes( rotated );
+        rotationAccount_.set( SurfaceBudget::CategoryScaled, rotationBytes_ );
+    }
+
+    if ( scaled )
+    {
+        SDL_FreeSurface( scaled );
+    }
+
+    return rotated;
+}
+
+
+void SDL::releaseRotation( const RotationKey &key, SDL_Surface *&rotated )
+{
+    rotationBytes_ -= surfaceBytes( rotated );
+    rotationAccount_.set( SurfaceBudget::CategoryScaled, rotationBytes_ );
+    SDL_FreeSurface( rotated );
+
+    std::map<SDL_Surface *, int>::iterator it = rotationRefs_.find( key.surface );
+    if ( it != rotationRefs_.end( ) && --it->second == 0 )
+    {
+        rotationRefs_.erase( it );
+        SDL_FreeSurface( key.surface );
+    }
+}
+
+
+// Forget the rotations of a surface whose pixels were rewritten in place
+void SDL::surfaceChanged( SDL_Surface *surface )
+{
+    if ( rotations_ && surface && rotationRefs_.find( surface ) != rotationRefs_.end( ) )
+    {
+        rotations_->eraseIf( [surface]( const RotationKey &key, SDL_Surface *& ) { return key.surface == surface; } );
+    }
+}
+
+
+// Blit src onto dst modulated by alpha, honouring both the per-pixel alpha
+// of src and the global alpha, without changing the flags of src. Clips like
+// SDL_BlitSurface; returns false when the formats need SDL's own blitter.
+bool SDL::blitAlpha( SDL_Surface *src, SDL_Rect *srcRect, SDL_Surface *dst, SDL_Rect *dstRect, Uint8 alpha )
+{
+    SDL_PixelFormat *srcFormat = src->format;
+    SDL_PixelFormat *dstFormat = dst->format;
+
+    if ( srcFormat->BytesPerPixel != 4 || dstFormat->BytesPerPixel != 4 ||
+         (src->flags & SDL_SRCCOLORKEY) ||
+         srcFormat->Gmask != 0x0000ff00 || dstFormat->Gmask != 0x0000ff00 ||
+         (dstFormat->Rmask | dstFormat->Bmask) != 0x00ff00ff ||
+         (srcFormat->Amask != 0 && srcFormat->Amask != 0xff000000) )
+    {
+        return false;
+    }
+
+    bool swapRedBlue;
+    if ( srcFormat->Rmask == dstFormat->Rmask && srcFormat->Bmask == dstFormat->Bmask )
+        swapRedBlue = false;
+    else if ( srcFormat->Rmask == dstFormat->Bmask && srcFormat->Bmask == dstFormat->Rmask )
+        swapRedBlue = true;
+    else
+        return false;
+
+    int srcX   = srcRect ? srcRect->x : 0;
+    int srcY   = srcRect ? srcRect->y : 0;
+    int width  = srcRect ? srcRect->w : src->w;
+    int height = srcRect ? srcRect->h : src->h;
+    int dstX   = dstRect ? dstRect->x : 0;
+    int dstY   = dstRect ? dstRect->y : 0;
+
+    // Clip to the source, then to the destination clip rectangle
+    if ( srcX < 0 ) { width  += srcX; dstX -= srcX; srcX = 0; }
+    if ( srcY < 0 ) { height += srcY; dstY -= srcY; srcY = 0; }
+    width  = MIN( width, src->w - srcX );
+    height = MIN( height, src->h - srcY );
+
+    SDL_Rect &clip = dst->clip_rect;
+    if ( dstX < clip.x ) { width  -= clip.x - dstX; srcX += clip.x - dstX; dstX = clip.x; }
+    if ( dstY < clip.y ) { height -= clip.y - dstY; srcY += clip.y - dstY; dstY = clip.y; }
+    width  = MIN( width, clip.x + clip.w - dstX );
+    height = MIN( height, clip.y + clip.h - dstY );
+
+    if ( width > 0 && height > 0 )
+    {
+        if ( SDL_MUSTLOCK( src ) ) SDL_LockSurface( src );
+        if ( SDL_MUSTLOCK( dst ) ) SDL_LockSurface( dst );
+
+        const uint32_t *srcPixels = reinterpret_cast<const uint32_t *>( static_cast<Uint8 *>( src->pixels ) + srcY * src->pitch + srcX * 4 );
+        uint32_t *dstPixels       = reinterpret_cast<uint32_t *>( static_cast<Uint8 *>( dst->pixels ) + dstY * dst->pitch + dstX * 4 );
+        AlphaBlend::blend( srcPixels, src->pitch, dstPixels, dst->pitch, width, height, alpha, srcFormat->Amask != 0, swapRedBlue );
+
+        if ( SDL_MUSTLOCK( dst ) ) SDL_UnlockSurface( dst );
+        if ( SDL_MUSTLOCK( src ) ) SDL_UnlockSurface( src );
+    }
+
+    if ( dstRect )
+    {
+        dstRect->x = dstX;
+        dstRect->y = dstY;
+        dstRect->w = MAX( width, 0 );
+        dstRect->h = MAX( height, 0 );
+    }
+
+    return true;
+}
+
+
 // Render a copy of a texture
 bool SDL::renderCopy( SDL_Surface *texture, float alpha, SDL_Rect *src, SDL_Rect *dest, ViewInfo &viewInfo )
 {
@@ -828,8 +1403,22 @@ bool SDL::renderCopy( SDL_Surface *texture, float alpha, SDL_Rect *src, SDL_Rect
 				rect_cropping.x, rect_cropping.y, rect_cropping.w, rect_cropping.h);*/
 	}
 
+    /* Rotation, done once per angle and kept in rotations_ */
+	SDL_Surface * texture_rotated = NULL;
+	if ( viewInfo.Angle != 0 && dstRect.w > 0 && dstRect.h > 0 )
+	{
+		texture_rotated = rotateSurface( texture, &srcRect, &dstRect, cropping_needed ? &rect_cropping : NULL, viewInfo.Angle );
+	}
+	if ( texture_rotated )
+	{
+		/* The rotated bounding box is centred on the unrotated image */
+		dstRect.x += ((cropping_needed ? rect_cropping.w : dstRect.w) - texture_rotated->w) / 2;
+		dstRect.y += ((cropping_needed ? rect_cropping.h : dstRect.h) - texture_rotated->h) / 2;
+		surface_to_blit = texture_rotated;
+	}
+
     /* Scaling */
-	scaling_needed = (dstRect.w != 0 && dstRect.h!=0) &&
+	scaling_needed = !texture_rotated && (dstRect.w != 0 && dstRect.h!=0) &&
 					((!cropping_needed && (srcRect.w != dstRect.w || srcRect.h != dstRect.h)) ||
 					(cropping_needed && (srcRect.w != rect_cropping.w || srcRect.h != rect_cropping.h) ));
 	if(scaling_needed){
@@ -893,79 +1482,17 @@ bool SDL::renderCopy( SDL_Surface *texture, float alpha, SDL_Rect *src, SDL_Rect
     /* Blit surface */
 	bool perform_blit = (alpha != 0) && !dstRect.w==0 && !dstRect.h==0;
     if(perform_blit){
-        SDL_SetAlpha(surface_to_blit, SDL_SRCALPHA, static_cast<uint8_t>( alpha * 255 ));
-        SDL_BlitSurface(surface_to_blit, scaling_needed ? NULL : &srcRect, getWindow(), &dstRect);
+        SDL_Rect *blitRect = (scaling_needed || texture_rotated) ? NULL : &srcRect;
+        if(!blitAlpha(surface_to_blit, blitRect, getWindow(), &dstRect, static_cast<uint8_t>( alpha * 255 ))){
+            SDL_SetAlpha(surface_to_blit, SDL_SRCALPHA, static_cast<uint8_t>( alpha * 255 ));
+            SDL_BlitSurface(surface_to_blit, blitRect, getWindow(), &dstRect);
+        }
     }
 
     /* Free zoomed texture */
     if(texture_zoomed)
 	SDL_FreeSurface(texture_zoomed);
 
-
-
-
-
-
-    //texture = rotozoomSurfaceXY(texture, viewInfo.Angle, scaleX, scaleY, SMOOTHING_OFF);
-    //texture = rotozoomSurfaceXY(texture, viewInfo.Angle, 0.5, 0.5, SMOOTHING_OFF);
-    //double scale_x = 240/1920;
-    //double scale_y = 240/1080;
-    //texture = rotozoomSurfaceXY(texture, 0, 0.5, 0.6, SMOOTHING_ON);
-
-    /*if ( viewInfo.Reflection == "top" )
-    {
-        dstRect.h = static_cast<unsigned int>( static_cast<float>(dstRect.h ) * viewInfo.ReflectionScale);
-        dstRect.y = dstRect.y - dstRect.h - viewInfo.ReflectionDistance;
-        //SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-        //SDL_RenderCopyEx( getRenderer( ), texture, src, &dstRect, viewInfo.Angle, NULL, SDL_FLIP_VERTICAL );
-
-        //texture = rotozoomSurfaceXY(texture, viewInfo.Angle, scaleX, scaleY, SMOOTHING_ON);
-
-
-        SDL_SetAlpha( texture, 0, SDL_ALPHA_OPAQUE );
-        SDL_BlitSurface (texture, &srcRect, texture_copy_alpha_, &dstRect);
-        texture_copy_alpha_ = flip_surface(texture_copy_alpha_, FLIP_VERTICAL);
-        SDL_gfxMultiplyAlpha (texture_copy_alpha_, static_cast<char>( alpha * 255 ));
-        SDL_BlitSurface (texture_copy_alpha_, &dstRect, getWindow(), &dstRect);
-    }*/
-
-    /*if ( viewInfo.Reflection == "bottom" )
-    {
-        dstRect.y = dstRect.y + dstRect.h + viewInfo.ReflectionDistance;
-        dstRect.h = static_cast<unsigned int>( static_cast<float>(dstRect.h ) * viewInfo.ReflectionScale);
-        //SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-        //SDL_RenderCopyEx( getRenderer( ), texture, src, &dstRect, viewInfo.Angle, NULL, SDL_FLIP_VERTICAL );
-        SDL_SetAlpha(texture, SDL_SRCALPHA, static_cast<char>( alpha * 255 ));
-        //texture = flip_surface(texture, FLIP_VERTICAL);
-        //texture = rotozoomSurfaceXY(texture, viewInfo.Angle, scaleX, scaleY, SMOOTHING_ON);
-        SDL_BlitSurface(texture, src, getWindow(), &dstRect);
-    }
-
-    if ( viewInfo.Reflection == "left" )
-    {
-        dstRect.w = static_cast<unsigned int>( static_cast<float>(dstRect.w ) * viewInfo.ReflectionScale);
-        dstRect.x = dstRect.x - dstRect.w - viewInfo.ReflectionDistance;
-        //SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-        //SDL_RenderCopyEx( getRenderer( ), texture, src, &dstRect, viewInfo.Angle, NULL, SDL_FLIP_HORIZONTAL );
-        SDL_SetAlpha(texture, SDL_SRCALPHA, static_cast<char>( alpha * 255 ));
-        //texture = flip_surface(texture, FLIP_HORIZONTAL);
-        //texture = rotozoomSurfaceXY(texture, viewInfo.Angle, scaleX, scaleY, SMOOTHING_ON);
-        SDL_BlitSurface(texture, src, getWindow(), &dstRect);
-    }
-
-    if ( viewInfo.Reflection == "right" )
-    {
-        dstRect.x = dstRect.x + dstRect.w + viewInfo.ReflectionDistance;
-        dstRect.w = static_cast<unsigned int>( static_cast<float>(dstRect.w ) * viewInfo.ReflectionScale);
-        //SDL_SetTextureAlphaMod( texture, static_cast<char>( viewInfo.ReflectionAlpha * alpha * 255 ) );
-        //SDL_RenderCopyEx( getRenderer( ), texture, src, &dstRect, viewInfo.Angle, NULL, SDL_FLIP_HORIZONTAL );
-        SDL_SetAlpha(texture, SDL_SRCALPHA, static_cast<char>( alpha * 255 ));
-        //texture = flip_surface(texture, FLIP_HORIZONTAL);
-        //texture = rotozoomSurfaceXY(texture, viewInfo.Angle, scaleX, scaleY, SMOOTHING_ON);
-        SDL_BlitSurface(texture, src, getWindow(), &dstRect);
-    }*/
-
-
     return true;
 }
 
@@ -18,8 +18,14 @@
 
 //#include <SDL/SDL.h>
 #include <SDL/SDL.h>
+#include <map>
+#include <set>
 #include <string>
+#include "Graphics/FrameCapture.h"
+#include "Graphics/Resampler.h"
 #include "Graphics/ViewInfo.h"
+#include "Utility/LruCache.h"
+#include "Utility/SurfaceBudget.h"
 
 //Flip flags
 #define FLIP_VERTICAL	1
@@ -39,8 +45,15 @@ public:
     static SDL_Surface *getWindow( );
     static void renderAndFlipWindow( );
     static SDL_Surface * zoomSurface(SDL_Surface *surface_ptr, SDL_Rect *src_rect_origin, SDL_Rect *dst_rect, SDL_Rect *post_cropping_rect);
+    static bool resampleSurface( SDL_Surface *src, Resampler::Image source, int width, int height, SDL_Rect *crop, SDL_Surface **dst );
     static void ditherSurface32bppTo16Bpp(SDL_Surface *src_surface);
     static bool renderCopy( SDL_Surface *texture, float alpha, SDL_Rect *src, SDL_Rect *dest, ViewInfo &viewInfo );
+    static void surfaceChanged( SDL_Surface *surface );
+    static SDL_Surface *createReflection( SDL_Surface *src, const ViewInfo &viewInfo );
+    static size_t surfaceBytes( SDL_Surface *surface )
+    {
+        return surface ? static_cast<size_t>( surface->pitch ) * surface->h : 0;
+    }
     static int getWindowWidth( )
     {
         return windowWidth_;
@@ -54,8 +67,42 @@ public:
         return fullscreen_;
     }
     static void SDL_Rotate_270(SDL_Surface * dst, SDL_Surface * src);
+    static bool isHeadless( )
+    {
+        return headless_;
+    }
+    static bool isHeadlessDone( )
+    {
+        return headless_ && headlessFrames_ > 0 && frameNumber_ >= headlessFrames_;
+    }
+    static unsigned int getFrameNumber( )
+    {
+        return frameNumber_;
+    }
+    static uint64_t frameChecksum( );
+    static bool dumpFrame( std::string path, FrameCapture::Format format );
 
 private:
+    // A rotated copy of (part of) a surface, drawn at width x height and cropped to crop
+    struct RotationKey
+    {
+        SDL_Surface *surface;
+        float        angle;
+        SDL_Rect     src;
+        int          width;
+        int          height;
+        SDL_Rect     crop;
+        bool operator<( const RotationKey &other ) const;
+    };
+    typedef LruCache<RotationKey, SDL_Surface *> RotationCache_T;
+
+    static bool initializeHeadless( Configuration &config );
+    static bool hasBlendableFormat( SDL_Surface *surface );
+    static SDL_Surface *rotateSurface( SDL_Surface *texture, SDL_Rect *srcRect, SDL_Rect *dstRect, SDL_Rect *crop, float angle );
+    static void releaseRotation( const RotationKey &key, SDL_Surface *&rotated );
+    static void captureFrame( );
+    static FrameCapture::Frame describeFrame( );
+    static bool blitAlpha( SDL_Surface *src, SDL_Rect *srcRect, SDL_Surface *dst, SDL_Rect *dstRect, Uint8 alpha );
     static Uint32 get_pixel32( SDL_Surface *surface, int x, int y );
     static void put_pixel32( SDL_Surface *surface, int x, int y, Uint32 pixel );
     static SDL_Surface * flip_surface( SDL_Surface *surface, int flags );
@@ -69,5 +116,18 @@ private:
     static int           windowHeight_;
     static bool          fullscreen_;
     static bool          showFrame_;
+    static bool          headless_;
+    static unsigned int  headlessFrames_;
+    static unsigned int  frameNumber_;
+    static bool          dumpAllFrames_;
+    static std::set<unsigned int> dumpFrames_;
+    static FrameCapture::Format dumpFormat_;
+    static std::string   dumpPath_;
+    static FILE         *checksumFile_;
+    static RotationCache_T *rotations_;
+    static std::map<SDL_Surface *, int> rotationRefs_;
+    static float         rotationStep_;
+    static size_t        rotationBytes_;
+    static SurfaceBudget::Account rotationAccount_;
 };
 
@@ -15,6 +15,7 @@
  */
 
 #include "Sound.h"
+#include "SoundCache.h"
 
 #include "../Utility/Log.h"
 #include "../Utility/Utils.h"
@@ -24,26 +25,24 @@ int Sound::ampliStarted = 0;
 
 Sound::Sound(std::string file, std::string altfile)
     : file_(file)
-    , chunk_(NULL)
     , channel_(-1)
 {
-    if(!allocate())
+    if(!Utils::IsPathExist(file_))
     {
         file_ = altfile;
-        if (!allocate())
+        if (!Utils::IsPathExist(file_))
         {
             Logger::write(Logger::ZONE_ERROR, "Sound", "Cannot load " + file_);
         }
     }
+
+    // decoded in the background, shared with every other user of the file
+    SoundCache::preload(file_);
 }
 
 Sound::~Sound()
 {
-    if(chunk_)
-    {
-        Mix_FreeChunk(chunk_);
-        chunk_ = NULL;
-    }
+    SoundCache::release(file_);
 }
 
 void Sound::play()
@@ -60,9 +59,20 @@ void Sound::play()
     	}
     }
     
-    if(chunk_)
+    // Skip the sound rather than wait if it is not decoded yet
+    Mix_Chunk *chunk = SoundCache::get(file_);
+    if(chunk)
     {
-        channel_ = Mix_PlayChannel(-1, chunk_, 0);
+        channel_ = Mix_PlayChannel(-1, chunk, 0);
+        if(channel_ == -1)
+        {
+            // all UI channels busy: cut the oldest sound
+            int oldest = Mix_GroupOldest(-1);
+            if(oldest != -1)
+            {
+                channel_ = Mix_PlayChannel(oldest, chunk, 0);
+            }
+        }
         Mix_ChannelFinished(finished);
     }
 }
@@ -89,15 +99,12 @@ void Sound::finished(int channel)
     }
 }
 
+// The decoded chunk stays in SoundCache while a game runs, so there is
+// nothing to release or reload around launches.
 bool Sound::free()
 {
     //printf("%s\n", __func__);
-    if(chunk_)
-    {
-        Mix_FreeChunk(chunk_);
-        chunk_   = NULL;
-        channel_ = -1;
-    }
+    channel_ = -1;
 
     return true;
 }
@@ -105,12 +112,7 @@ bool Sound::free()
 bool Sound::allocate()
 {
     //printf("%s\n", __func__);
-    if(!chunk_)
-    {
-        chunk_ = Mix_LoadWAV(file_.c_str());
-    }
-
-    return (chunk_ != NULL);
+    return (SoundCache::get(file_) != NULL);
 }
 
 
@@ -33,6 +33,5 @@ private:
     static int ampliStarted;
     static SDL_TimerID idTimer;
     std::string file_;
-    Mix_Chunk  *chunk_;
     int         channel_;
 };
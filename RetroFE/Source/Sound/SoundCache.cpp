@@ -0,0 +1,205 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SoundCache.h"
+#include "../Utility/Log.h"
+
+std::map<std::string, SoundCache::Entry> SoundCache::entries_;
+std::deque<std::string> SoundCache::queue_;
+std::mutex SoundCache::mutex_;
+std::condition_variable SoundCache::wakeup_;
+std::condition_variable SoundCache::loaded_;
+std::thread SoundCache::thread_;
+bool SoundCache::stop_ = false;
+
+// Adds a reference to file and queues it for decoding if it is not loaded.
+void SoundCache::preload(std::string file)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::map<std::string, Entry>::iterator it = entries_.find(file);
+    if(it != entries_.end())
+    {
+        it->second.refs++;
+        return;
+    }
+
+    Entry entry;
+    entry.chunk   = NULL;
+    entry.refs    = 1;
+    entry.loading = true;
+    entries_[file] = entry;
+    queue_.push_back(file);
+
+    if(!thread_.joinable())
+    {
+        stop_   = false;
+        thread_ = std::thread(loader);
+    }
+    wakeup_.notify_one();
+}
+
+
+void SoundCache::release(std::string file)
+{
+    Mix_Chunk *chunk = NULL;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::map<std::string, Entry>::iterator it = entries_.find(file);
+        if(it == entries_.end() || --it->second.refs > 0)
+        {
+            return;
+        }
+
+        // the loader frees chunks whose last reference went away meanwhile
+        if(it->second.loading)
+        {
+            return;
+        }
+        chunk = it->second.chunk;
+        entries_.erase(it);
+    }
+
+    if(chunk)
+    {
+        Mix_FreeChunk(chunk);
+    }
+}
+
+
+// Never blocks: returns NULL while the chunk is still being decoded.
+Mix_Chunk *SoundCache::get(std::string file)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::map<std::string, Entry>::iterator it = entries_.find(file);
+    if(it == entries_.end())
+    {
+        return NULL;
+    }
+
+    return it->second.chunk;
+}
+
+
+// Blocks until every queued chunk has been decoded.
+void SoundCache::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    loaded_.wait(lock, []() {
+        if(!queue_.empty())
+        {
+            return false;
+        }
+        for(std::map<std::string, Entry>::iterator it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            if(it->second.loading)
+            {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+
+// Joins the loader thread, dropping the chunks still queued; loaded chunks
+// stay cached. Called before exit(), which would otherwise terminate.
+void SoundCache::shutdown()
+{
+    if(!thread_.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        for(std::deque<std::string>::iterator it = queue_.begin(); it != queue_.end(); ++it)
+        {
+            entries_.erase(*it);
+        }
+        queue_.clear();
+    }
+    wakeup_.notify_one();
+    thread_.join();
+    loaded_.notify_all();
+}
+
+
+void SoundCache::clear()
+{
+    shutdown();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for(std::map<std::string, Entry>::iterator it = entries_.begin(); it != entries_.end(); ++it)
+    {
+        if(it->second.chunk)
+        {
+            Mix_FreeChunk(it->second.chunk);
+        }
+    }
+    entries_.clear();
+    loaded_.notify_all();
+}
+
+
+void SoundCache::loader()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(!stop_)
+    {
+        if(queue_.empty())
+        {
+            wakeup_.wait(lock);
+            continue;
+        }
+
+        std::string file = queue_.front();
+        queue_.pop_front();
+
+        lock.unlock();
+        Mix_Chunk *chunk = Mix_LoadWAV(file.c_str());
+        // errors are flushed to disk at once, so log before taking the lock
+        // get() and so Sound::play() wait on
+        if(!chunk)
+        {
+            Logger::write(Logger::ZONE_ERROR, "Sound", "Cannot load " + file);
+        }
+        lock.lock();
+
+        std::map<std::string, Entry>::iterator it = entries_.find(file);
+        if(it == entries_.end() || it->second.refs <= 0)
+        {
+            if(it != entries_.end())
+            {
+                entries_.erase(it);
+            }
+            if(chunk)
+            {
+                Mix_FreeChunk(chunk);
+            }
+        }
+        else
+        {
+            it->second.chunk   = chunk;
+            it->second.loading = false;
+        }
+        loaded_.notify_all();
+    }
+}
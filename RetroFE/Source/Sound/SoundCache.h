@@ -0,0 +1,56 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <SDL/SDL_mixer.h>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Decoded sound chunks shared by path. Chunks are decoded on a background
+// thread as soon as a page asks for them and stay loaded while referenced,
+// across game launches, so playback never waits for the SD card.
+class SoundCache
+{
+public:
+    static void preload(std::string file);
+    static void release(std::string file);
+    static Mix_Chunk *get(std::string file);
+    static void wait();
+    static void shutdown();
+    static void clear();
+
+private:
+    struct Entry
+    {
+        Mix_Chunk *chunk;
+        int        refs;
+        bool       loading;
+    };
+
+    static void loader();
+
+    static std::map<std::string, Entry> entries_;
+    static std::deque<std::string> queue_;
+    static std::mutex mutex_;
+    static std::condition_variable wakeup_;
+    static std::condition_variable loaded_;
+    static std::thread thread_;
+    static bool stop_;
+};
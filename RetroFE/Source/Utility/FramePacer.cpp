@@ -0,0 +1,139 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "FramePacer.h"
+#include "Log.h"
+#include <SDL/SDL.h>
+#include <sstream>
+
+// how often the wakeup rate is measured and logged
+static const int WAKEUP_WINDOW_SECONDS = 10;
+
+FramePacer::FramePacer(unsigned int fps)
+    : framePeriod_(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps)))
+    , nextFrame_(Clock::now())
+    , idlePollPeriod_(50)
+    , wakeups_(0)
+    , wakeupWindowStart_(Clock::now())
+    , wakeupsPerSecond_(0)
+{
+}
+
+void FramePacer::setIdlePollPeriod(unsigned int milliseconds)
+{
+    idlePollPeriod_ = milliseconds;
+}
+
+unsigned int FramePacer::getIdlePollPeriod()
+{
+    return idlePollPeriod_;
+}
+
+void FramePacer::waitForFrame()
+{
+    Clock::time_point now = Clock::now();
+
+    // more than a frame behind (a slow frame, or the loop was idle): start a
+    // new schedule from now instead of rushing to catch up
+    if(now - nextFrame_ > framePeriod_)
+    {
+        nextFrame_ = now;
+    }
+    else
+    {
+        sleepUntil(nextFrame_);
+    }
+
+    nextFrame_ += framePeriod_;
+    countWakeup(Clock::now());
+}
+
+// Waits until an event is queued or timeout seconds have passed (forever if
+// negative). SDL 1.2 has no SDL_WaitEventTimeout and its SDL_WaitEvent polls
+// every 10 ms internally, so the queue is checked every idle poll period.
+bool FramePacer::waitForEvent(float timeout)
+{
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = Clock::time_point::max();
+    SDL_Event e;
+
+    if(timeout >= 0)
+    {
+        deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(timeout));
+    }
+
+    while(true)
+    {
+        SDL_PumpEvents();
+        if(SDL_PeepEvents(&e, 1, SDL_PEEKEVENT, SDL_ALLEVENTS) > 0)
+        {
+            break;
+        }
+
+        Clock::time_point now = Clock::now();
+        if(now >= deadline)
+        {
+            break;
+        }
+
+        Clock::time_point wake = now + std::chrono::milliseconds(idlePollPeriod_);
+        sleepUntil((wake < deadline) ? wake : deadline);
+        countWakeup(Clock::now());
+    }
+
+    // the next frame is scheduled from when we woke up
+    nextFrame_ = Clock::now();
+
+    return SDL_PeepEvents(&e, 1, SDL_PEEKEVENT, SDL_ALLEVENTS) > 0;
+}
+
+float FramePacer::getWakeupsPerSecond()
+{
+    return wakeupsPerSecond_;
+}
+
+void FramePacer::sleepUntil(Clock::time_point deadline)
+{
+    Clock::time_point now = Clock::now();
+
+    if(deadline > now)
+    {
+        Uint32 ms = static_cast<Uint32>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count());
+        if(ms > 0)
+        {
+            SDL_Delay(ms);
+        }
+    }
+}
+
+void FramePacer::countWakeup(Clock::time_point now)
+{
+    wakeups_++;
+
+    std::chrono::duration<float> window = now - wakeupWindowStart_;
+    if(window.count() >= WAKEUP_WINDOW_SECONDS)
+    {
+        wakeupsPerSecond_ = wakeups_ / window.count();
+        wakeups_ = 0;
+        wakeupWindowStart_ = now;
+
+        if(Logger::isEnabled(Logger::ZONE_DEBUG))
+        {
+            std::stringstream ss;
+            ss << "Main loop wakeups: " << wakeupsPerSecond_ << "/s";
+            Logger::write(Logger::ZONE_DEBUG, "RetroFE", ss.str());
+        }
+    }
+}
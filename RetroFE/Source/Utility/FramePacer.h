@@ -0,0 +1,46 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <chrono>
+
+// Paces the main loop. While something is animating, frames are scheduled on
+// a monotonic clock: each deadline is the previous one plus the frame period,
+// so sleep granularity does not accumulate into drift. While the page is
+// static the loop instead waits for input, waking only as often as needed.
+class FramePacer
+{
+public:
+    FramePacer(unsigned int fps);
+    void setIdlePollPeriod(unsigned int milliseconds);
+    unsigned int getIdlePollPeriod();
+    void waitForFrame();
+    bool waitForEvent(float timeout);
+    float getWakeupsPerSecond();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    void sleepUntil(Clock::time_point deadline);
+    void countWakeup(Clock::time_point now);
+
+    Clock::duration   framePeriod_;
+    Clock::time_point nextFrame_;
+    unsigned int      idlePollPeriod_;
+    unsigned int      wakeups_;
+    Clock::time_point wakeupWindowStart_;
+    float             wakeupsPerSecond_;
+};
@@ -0,0 +1,185 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "FrameStats.h"
+#include "Log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+#ifdef RETROFE_COUNT_ALLOCATIONS
+void *operator new(size_t size)
+{
+    FrameStats::countAllocation();
+    void *p = malloc(size > 0 ? size : 1);
+    if(!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+#endif
+
+
+FrameStats::FrameStats()
+    : fileProbes_(0)
+    , allocations_(0)
+    , elapsed_(Clock::duration::zero())
+    , startProbes_(0)
+    , startAllocations_(0)
+    , running_(false)
+    , out_(NULL)
+{
+}
+
+
+FrameStats::~FrameStats()
+{
+    if(out_)
+    {
+        fclose(out_);
+    }
+}
+
+
+bool FrameStats::open(const std::string &file)
+{
+    out_ = fopen(file.c_str(), "w");
+    if(!out_)
+    {
+        Logger::write(Logger::ZONE_ERROR, "FrameStats", "Could not create " + file);
+        return false;
+    }
+    fprintf(out_, "frame,ms,probes,allocations\n");
+    return true;
+}
+
+
+void FrameStats::beginFrame()
+{
+    elapsed_          = Clock::duration::zero();
+    startProbes_      = fileProbes().load(std::memory_order_relaxed);
+    startAllocations_ = allocations().load(std::memory_order_relaxed);
+    start_            = Clock::now();
+    running_          = true;
+}
+
+
+void FrameStats::pause()
+{
+    if(running_)
+    {
+        elapsed_ += Clock::now() - start_;
+        running_ = false;
+    }
+}
+
+
+void FrameStats::resume()
+{
+    if(!running_)
+    {
+        start_   = Clock::now();
+        running_ = true;
+    }
+}
+
+
+void FrameStats::endFrame(unsigned int frame)
+{
+    pause();
+
+    double   ms          = std::chrono::duration<double, std::milli>(elapsed_).count();
+    uint64_t probes      = fileProbes().load(std::memory_order_relaxed) - startProbes_;
+    uint64_t allocations = FrameStats::allocations().load(std::memory_order_relaxed) - startAllocations_;
+
+    times_.push_back(ms);
+    fileProbes_  += probes;
+    allocations_ += allocations;
+
+    if(out_)
+    {
+        fprintf(out_, "%u,%.3f,%llu,%llu\n", frame, ms,
+                static_cast<unsigned long long>(probes), static_cast<unsigned long long>(allocations));
+    }
+}
+
+
+bool FrameStats::isEmpty() const
+{
+    return times_.empty();
+}
+
+
+FrameStats::Summary FrameStats::summarize() const
+{
+    Summary summary;
+    std::vector<double> sorted(times_);
+
+    std::sort(sorted.begin(), sorted.end());
+    summary.frames      = sorted.size();
+    summary.p50         = percentile(sorted, 50);
+    summary.p95         = percentile(sorted, 95);
+    summary.p99         = percentile(sorted, 99);
+    summary.max         = sorted.empty() ? 0 : sorted.back();
+    summary.fileProbes  = fileProbes_;
+    summary.allocations = allocations_;
+
+    return summary;
+}
+
+
+std::string FrameStats::report() const
+{
+    Summary summary = summarize();
+    std::stringstream ss;
+
+    ss.setf(std::ios::fixed);
+    ss.precision(2);
+    ss << summary.frames << " frames, p50 " << summary.p50 << " ms, p95 " << summary.p95
+       << " ms, p99 " << summary.p99 << " ms, max " << summary.max << " ms, "
+       << summary.fileProbes << " file probes";
+#ifdef RETROFE_COUNT_ALLOCATIONS
+    ss << ", " << summary.allocations << " allocations";
+#endif
+
+    return ss.str();
+}
+
+
+double FrameStats::percentile(const std::vector<double> &sorted, double p)
+{
+    if(sorted.empty())
+    {
+        return 0;
+    }
+
+    size_t rank = static_cast<size_t>(std::ceil(p / 100 * sorted.size()));
+    return sorted[(rank > 0) ? rank - 1 : 0];
+}
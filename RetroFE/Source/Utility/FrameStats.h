@@ -0,0 +1,95 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Per-frame cost of the main loop for benchmarks: the time spent working on
+// each frame (pacing waits excluded), and how many file probes and heap
+// allocations the frame made. The counters are process wide. Heap
+// allocations are only counted in builds configured with
+// RETROFE_COUNT_ALLOCATIONS, by the operator new defined in FrameStats.cpp;
+// otherwise they read as 0.
+class FrameStats
+{
+public:
+    struct Summary
+    {
+        size_t   frames;
+        double   p50;
+        double   p95;
+        double   p99;
+        double   max;
+        uint64_t fileProbes;
+        uint64_t allocations;
+    };
+
+    FrameStats();
+    ~FrameStats();
+
+    // Optionally logs every frame as "frame,ms,probes,allocations".
+    bool open(const std::string &file);
+    void beginFrame();
+    void pause();
+    void resume();
+    void endFrame(unsigned int frame);
+    bool isEmpty() const;
+    Summary summarize() const;
+    std::string report() const;
+
+    // Nearest-rank percentile of an ascending list of times.
+    static double percentile(const std::vector<double> &sorted, double p);
+
+    static void countFileProbe()
+    {
+        fileProbes().fetch_add(1, std::memory_order_relaxed);
+    }
+    static void countAllocation()
+    {
+        allocations().fetch_add(1, std::memory_order_relaxed);
+    }
+    static std::atomic<uint64_t> &fileProbes()
+    {
+        static std::atomic<uint64_t> count(0);
+        return count;
+    }
+    static std::atomic<uint64_t> &allocations()
+    {
+        static std::atomic<uint64_t> count(0);
+        return count;
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    FrameStats(const FrameStats &);
+    FrameStats &operator=(const FrameStats &);
+
+    std::vector<double> times_;
+    uint64_t            fileProbes_;
+    uint64_t            allocations_;
+    Clock::time_point   start_;
+    Clock::duration     elapsed_;
+    uint64_t            startProbes_;
+    uint64_t            startAllocations_;
+    bool                running_;
+    FILE               *out_;
+};
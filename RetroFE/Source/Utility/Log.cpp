@@ -18,35 +18,194 @@
 #include <iostream>
 #include <sstream>
 #include <ctime>
+#include <cctype>
+#include <chrono>
 
+const size_t Logger::RING_SIZE;
+const size_t Logger::FLUSH_BATCH;
+const int Logger::FLUSH_PERIOD_MS;
 std::ofstream Logger::writeFileStream_;
 std::streambuf *Logger::cerrStream_ = NULL;
 std::streambuf *Logger::coutStream_ = NULL;
+std::FILE *Logger::file_ = NULL;
+std::atomic<unsigned int> Logger::zoneMask_(~0u);
+Logger::Slot Logger::ring_[Logger::RING_SIZE];
+std::atomic<size_t> Logger::enqueuePos_(0);
+size_t Logger::dequeuePos_ = 0;
+std::atomic<size_t> Logger::writtenPos_(0);
+std::atomic<bool> Logger::running_(false);
+std::thread Logger::thread_;
+std::mutex Logger::mutex_;
+std::condition_variable Logger::wakeup_;
+std::condition_variable Logger::written_;
 
 bool Logger::initialize(std::string file)
 {
-    writeFileStream_.open(file.c_str());
+    // Truncate, then reopen in append mode: stray std::cout/std::cerr output
+    // and the writer thread share the file through separate handles
+    writeFileStream_.open(file.c_str(), std::ios::out | std::ios::trunc);
+    writeFileStream_.close();
+    writeFileStream_.open(file.c_str(), std::ios::out | std::ios::app);
 
     cerrStream_ = std::cerr.rdbuf(writeFileStream_.rdbuf());
     coutStream_ = std::cout.rdbuf(writeFileStream_.rdbuf());
 
-    return writeFileStream_.is_open();
+    if(!writeFileStream_.is_open())
+    {
+        return false;
+    }
+
+    file_ = std::fopen(file.c_str(), "a");
+    if(file_)
+    {
+        for(size_t i = 0; i < RING_SIZE; ++i)
+        {
+            ring_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueuePos_.store(0);
+        dequeuePos_ = 0;
+        writtenPos_.store(0);
+        running_ = true;
+        thread_ = std::thread(writerThread);
+    }
+
+    return true;
 }
 
+// Safe to call more than once, and before initialize()
 void Logger::deInitialize()
 {
+    if(thread_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+        }
+        wakeup_.notify_one();
+        thread_.join();
+        writeBatch();
+        written_.notify_all();
+    }
+
+    if(file_)
+    {
+        std::fclose(file_);
+        file_ = NULL;
+    }
+
     if(writeFileStream_.is_open())
     {
         writeFileStream_.close();
 
     }
 
-    std::cerr.rdbuf(cerrStream_);
-    std::cout.rdbuf(coutStream_);
+    if(cerrStream_)
+    {
+        std::cerr.rdbuf(cerrStream_);
+        std::cout.rdbuf(coutStream_);
+        cerrStream_ = NULL;
+        coutStream_ = NULL;
+    }
+}
+
+
+bool Logger::isEnabled(Zone zone)
+{
+    return (zoneMask_.load(std::memory_order_relaxed) & (1u << zone)) != 0;
+}
+
+
+void Logger::setZoneEnabled(Zone zone, bool enabled)
+{
+    if(enabled)
+    {
+        zoneMask_.fetch_or(1u << zone);
+    }
+    else
+    {
+        zoneMask_.fetch_and(~(1u << zone));
+    }
+}
+
+
+// Enables exactly the zones named in a comma separated list such as
+// "INFO,WARNING,ERROR"; unknown names are ignored.
+void Logger::setZones(std::string zones)
+{
+    static const char *names[] = { "DEBUG", "INFO", "NOTICE", "WARNING", "ERROR" };
+    unsigned int mask = 0;
+    std::stringstream ss(zones);
+    std::string name;
+
+    while(std::getline(ss, name, ','))
+    {
+        std::string upper;
+        for(size_t i = 0; i < name.size(); ++i)
+        {
+            if(!std::isspace(static_cast<unsigned char>(name[i])))
+            {
+                upper += static_cast<char>(std::toupper(static_cast<unsigned char>(name[i])));
+            }
+        }
+        for(unsigned int zone = ZONE_DEBUG; zone <= ZONE_ERROR; ++zone)
+        {
+            if(upper == names[zone])
+            {
+                mask |= 1u << zone;
+            }
+        }
+    }
+
+    zoneMask_.store(mask);
 }
 
 
 void Logger::write(Zone zone, std::string component, std::string message)
+{
+    if(!isEnabled(zone))
+    {
+        return;
+    }
+
+    std::string record = format(zone, component, message);
+
+    if(!running_)
+    {
+        std::cout << record;
+        std::cout.flush();
+        return;
+    }
+
+    size_t ticket = push(record);
+
+    if(zone == ZONE_ERROR)
+    {
+        flush();
+    }
+    else if(ticket - writtenPos_.load(std::memory_order_relaxed) >= FLUSH_BATCH)
+    {
+        wakeup_.notify_one();
+    }
+}
+
+
+// Blocks until every record queued so far is in the file.
+void Logger::flush()
+{
+    if(!running_)
+    {
+        std::cout.flush();
+        return;
+    }
+
+    size_t target = enqueuePos_.load();
+    std::unique_lock<std::mutex> lock(mutex_);
+    wakeup_.notify_one();
+    written_.wait(lock, [target]() { return writtenPos_.load() >= target || !running_; });
+}
+
+
+std::string Logger::format(Zone zone, const std::string &component, const std::string &message)
 {
     std::string zoneStr;
 
@@ -69,13 +228,108 @@ void Logger::write(Zone zone, std::string component, std::string message)
         break;
     }
     std::time_t rawtime = std::time(NULL);
-    struct tm* timeinfo = std::localtime(&rawtime);
+    struct tm timeinfo;
+#ifdef WIN32
+    localtime_s(&timeinfo, &rawtime);
+#else
+    localtime_r(&rawtime, &timeinfo);
+#endif
 
-    static char timeStr[60];
-    std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", timeinfo);
+    char timeStr[60];
+    std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &timeinfo);
 
     std::stringstream ss;
     ss << "[" << timeStr << "] [" << zoneStr << "] [" << component << "] " << message << std::endl;
-    std::cout << ss.str();
-    std::cout.flush();
+    return ss.str();
+}
+
+
+// Queues a record, waiting for the writer while the ring is full. Returns
+// the number of records queued up to and including this one.
+size_t Logger::push(std::string &record)
+{
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Slot *slot;
+
+    for(;;)
+    {
+        slot = &ring_[pos % RING_SIZE];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if(sequence == pos)
+        {
+            if(enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if(sequence < pos)
+        {
+            // full: the writer has not released this slot yet
+            wakeup_.notify_one();
+            std::this_thread::yield();
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->record.swap(record);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    return pos + 1;
+}
+
+
+bool Logger::pop(std::string &record)
+{
+    Slot &slot = ring_[dequeuePos_ % RING_SIZE];
+
+    if(slot.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1)
+    {
+        return false;
+    }
+
+    record.swap(slot.record);
+    slot.record.clear();
+    slot.sequence.store(dequeuePos_ + RING_SIZE, std::memory_order_release);
+    dequeuePos_++;
+
+    return true;
+}
+
+
+void Logger::writerThread()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(running_)
+    {
+        wakeup_.wait_for(lock, std::chrono::milliseconds(FLUSH_PERIOD_MS));
+        lock.unlock();
+        writeBatch();
+        lock.lock();
+        written_.notify_all();
+    }
+}
+
+
+void Logger::writeBatch()
+{
+    std::string batch;
+    std::string record;
+
+    while(pop(record))
+    {
+        batch += record;
+    }
+
+    if(!batch.empty())
+    {
+        std::fwrite(batch.data(), 1, batch.size(), file_);
+        std::fflush(file_);
+    }
+
+    writtenPos_.store(dequeuePos_);
 }
@@ -20,6 +20,11 @@
 #include <sstream>
 #include <streambuf>
 #include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
 
 class Logger
 {
@@ -36,9 +41,42 @@ public:
     static bool initialize(std::string file);
     static void write(Zone zone, std::string component, std::string message);
     static void deInitialize();
+    static bool isEnabled(Zone zone);
+    static void setZoneEnabled(Zone zone, bool enabled);
+    static void setZones(std::string zones);
+    static void flush();
+
 private:
+    // Records are queued in a bounded multi producer, single consumer ring
+    // and written to the file in batches by the writer thread.
+    static const size_t RING_SIZE = 1024;
+    static const size_t FLUSH_BATCH = 64;
+    static const int FLUSH_PERIOD_MS = 250;
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        std::string         record;
+    };
+
+    static std::string format(Zone zone, const std::string &component, const std::string &message);
+    static size_t push(std::string &record);
+    static bool pop(std::string &record);
+    static void writerThread();
+    static void writeBatch();
 
     static std::streambuf *cerrStream_;
     static std::streambuf *coutStream_;
     static std::ofstream writeFileStream_;
+    static std::FILE *file_;
+    static std::atomic<unsigned int> zoneMask_;
+    static Slot ring_[RING_SIZE];
+    static std::atomic<size_t> enqueuePos_;
+    static size_t dequeuePos_;
+    static std::atomic<size_t> writtenPos_;
+    static std::atomic<bool> running_;
+    static std::thread thread_;
+    static std::mutex mutex_;
+    static std::condition_variable wakeup_;
+    static std::condition_variable written_;
 };
@@ -0,0 +1,200 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <utility>
+
+// Fixed capacity map which drops the least recently used entry when full.
+// The cache owns its values: every value leaving the cache (eviction,
+// erase, clear or destruction) is handed to the evict callback, so resource
+// handles such as surfaces can be stored directly.
+template <typename Key, typename Value>
+class LruCache
+{
+public:
+    typedef std::function<void(const Key &, Value &)> EvictCallback;
+
+    LruCache(size_t capacity, EvictCallback evict = EvictCallback())
+        : capacity_(capacity > 0 ? capacity : 1)
+        , evict_(evict)
+    {
+    }
+
+    ~LruCache()
+    {
+        clear();
+    }
+
+    // Returns the cached value and marks it most recently used, or NULL.
+    Value *find(const Key &key)
+    {
+        typename Index_T::iterator it = index_.find(key);
+        if(it == index_.end())
+        {
+            return NULL;
+        }
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return &it->second->second;
+    }
+
+    bool contains(const Key &key) const
+    {
+        return index_.find(key) != index_.end();
+    }
+
+    // Stores value under key, replacing (and evicting) any previous value.
+    Value &insert(const Key &key, const Value &value)
+    {
+        erase(key);
+        while(entries_.size() >= capacity_)
+        {
+            evictBack();
+        }
+        entries_.push_front(std::make_pair(key, value));
+        index_[key] = entries_.begin();
+        return entries_.front().second;
+    }
+
+    bool erase(const Key &key)
+    {
+        typename Index_T::iterator it = index_.find(key);
+        if(it == index_.end())
+        {
+            return false;
+        }
+        typename Entries_T::iterator entry = it->second;
+        index_.erase(it);
+        release(*entry);
+        entries_.erase(entry);
+        return true;
+    }
+
+    // Hands ownership of the value back to the caller without evicting it.
+    bool take(const Key &key, Value &value)
+    {
+        typename Index_T::iterator it = index_.find(key);
+        if(it == index_.end())
+        {
+            return false;
+        }
+        typename Entries_T::iterator entry = it->second;
+        index_.erase(it);
+        value = entry->second;
+        entries_.erase(entry);
+        return true;
+    }
+
+    // Evicts the least recently used entry, if any.
+    bool evictOldest()
+    {
+        if(entries_.empty())
+        {
+            return false;
+        }
+        evictBack();
+        return true;
+    }
+
+    // The least recently used entry, without marking it used.
+    bool oldest(Key &key, Value &value) const
+    {
+        if(entries_.empty())
+        {
+            return false;
+        }
+        key   = entries_.back().first;
+        value = entries_.back().second;
+        return true;
+    }
+
+    // Evicts every entry for which pred(key, value) holds; returns how many.
+    template <typename Predicate>
+    size_t eraseIf(Predicate pred)
+    {
+        size_t erased = 0;
+        typename Entries_T::iterator it = entries_.begin();
+        while(it != entries_.end())
+        {
+            typename Entries_T::iterator entry = it++;
+            if(pred(entry->first, entry->second))
+            {
+                index_.erase(entry->first);
+                release(*entry);
+                entries_.erase(entry);
+                ++erased;
+            }
+        }
+        return erased;
+    }
+
+    void clear()
+    {
+        while(!entries_.empty())
+        {
+            evictBack();
+        }
+    }
+
+    void setCapacity(size_t capacity)
+    {
+        capacity_ = capacity > 0 ? capacity : 1;
+        while(entries_.size() > capacity_)
+        {
+            evictBack();
+        }
+    }
+
+    size_t size() const
+    {
+        return entries_.size();
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+private:
+    typedef std::list< std::pair<Key, Value> > Entries_T;
+    typedef std::map<Key, typename Entries_T::iterator> Index_T;
+
+    LruCache(const LruCache &);
+    LruCache &operator=(const LruCache &);
+
+    void evictBack()
+    {
+        index_.erase(entries_.back().first);
+        release(entries_.back());
+        entries_.pop_back();
+    }
+
+    void release(std::pair<Key, Value> &entry)
+    {
+        if(evict_)
+        {
+            evict_(entry.first, entry.second);
+        }
+    }
+
+    size_t        capacity_;
+    EvictCallback evict_;
+    Entries_T     entries_;
+    Index_T       index_;
+};
@@ -0,0 +1,212 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Lz4.h"
+#include <cstring>
+#include <stdint.h>
+#include <vector>
+
+static const size_t MIN_MATCH     = 4;
+static const size_t LAST_LITERALS = 5;  // the block always ends in literals
+static const size_t MF_LIMIT      = 12; // no match may start in the last 12 bytes
+static const size_t MAX_OFFSET    = 65535;
+static const int    HASH_BITS     = 12;
+
+static uint32_t read32(const unsigned char *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint32_t hash(uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+static unsigned char *writeLength(unsigned char *op, size_t length)
+{
+    while(length >= 255)
+    {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = static_cast<unsigned char>(length);
+
+    return op;
+}
+
+static unsigned char *writeLiterals(unsigned char *op, unsigned char *token, const unsigned char *literals, size_t length)
+{
+    if(length >= 15)
+    {
+        *token = 15 << 4;
+        op = writeLength(op, length - 15);
+    }
+    else
+    {
+        *token = static_cast<unsigned char>(length << 4);
+    }
+
+    memcpy(op, literals, length);
+
+    return op + length;
+}
+
+size_t Lz4::compressBound(size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+// Greedy single-probe compressor. dst must hold compressBound(size) bytes;
+// returns the compressed length.
+size_t Lz4::compress(const unsigned char *src, size_t size, unsigned char *dst)
+{
+    unsigned char *op = dst;
+    size_t anchor = 0;
+
+    if(size > MF_LIMIT)
+    {
+        std::vector<int> table(1 << HASH_BITS, -1);
+        size_t matchLimit = size - LAST_LITERALS;
+        size_t ip = 0;
+
+        while(ip + MF_LIMIT <= size)
+        {
+            uint32_t sequence = read32(src + ip);
+            uint32_t h = hash(sequence);
+            int ref = table[h];
+            table[h] = static_cast<int>(ip);
+
+            if(ref < 0 || ip - ref > MAX_OFFSET || read32(src + ref) != sequence)
+            {
+                ip++;
+                continue;
+            }
+
+            size_t length = MIN_MATCH;
+            while(ip + length < matchLimit && src[ref + length] == src[ip + length])
+            {
+                length++;
+            }
+
+            unsigned char *token = op++;
+            op = writeLiterals(op, token, src + anchor, ip - anchor);
+
+            size_t offset = ip - ref;
+            *op++ = static_cast<unsigned char>(offset & 0xff);
+            *op++ = static_cast<unsigned char>(offset >> 8);
+
+            size_t matchLength = length - MIN_MATCH;
+            if(matchLength >= 15)
+            {
+                *token |= 15;
+                op = writeLength(op, matchLength - 15);
+            }
+            else
+            {
+                *token |= static_cast<unsigned char>(matchLength);
+            }
+
+            ip += length;
+            anchor = ip;
+        }
+    }
+
+    unsigned char *token = op++;
+    op = writeLiterals(op, token, src + anchor, size - anchor);
+
+    return op - dst;
+}
+
+// Decodes a block into exactly dstSize bytes. Malformed input is rejected
+// rather than read or written out of bounds.
+bool Lz4::decompress(const unsigned char *src, size_t size, unsigned char *dst, size_t dstSize)
+{
+    const unsigned char *ip   = src;
+    const unsigned char *iend = src + size;
+    unsigned char *op         = dst;
+    unsigned char *oend       = dst + dstSize;
+
+    while(ip < iend)
+    {
+        unsigned char token = *ip++;
+
+        size_t length = token >> 4;
+        if(length == 15)
+        {
+            unsigned char b;
+            do
+            {
+                if(ip >= iend) return false;
+                b = *ip++;
+                length += b;
+            } while(b == 255);
+        }
+
+        if(length > static_cast<size_t>(iend - ip) || length > static_cast<size_t>(oend - op))
+        {
+            return false;
+        }
+        memcpy(op, ip, length);
+        ip += length;
+        op += length;
+
+        // the last sequence has no match part
+        if(ip == iend)
+        {
+            break;
+        }
+
+        if(iend - ip < 2)
+        {
+            return false;
+        }
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if(offset == 0 || offset > static_cast<size_t>(op - dst))
+        {
+            return false;
+        }
+
+        length = token & 15;
+        if(length == 15)
+        {
+            unsigned char b;
+            do
+            {
+                if(ip >= iend) return false;
+                b = *ip++;
+                length += b;
+            } while(b == 255);
+        }
+        length += MIN_MATCH;
+
+        if(length > static_cast<size_t>(oend - op))
+        {
+            return false;
+        }
+
+        // byte by byte: the match may overlap what it is producing
+        const unsigned char *match = op - offset;
+        for(size_t i = 0; i < length; i++)
+        {
+            op[i] = match[i];
+        }
+        op += length;
+    }
+
+    return op == oend;
+}
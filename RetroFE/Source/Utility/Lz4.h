@@ -0,0 +1,29 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstddef>
+
+// Minimal LZ4 block format codec. Fast enough to squeeze decoded surfaces
+// into RAM around a game launch; blocks are compatible with LZ4_compress_default
+// and LZ4_decompress_safe output, but no frame format is produced.
+class Lz4
+{
+public:
+    static size_t compressBound(size_t size);
+    static size_t compress(const unsigned char *src, size_t size, unsigned char *dst);
+    static bool decompress(const unsigned char *src, size_t size, unsigned char *dst, size_t dstSize);
+};
@@ -0,0 +1,239 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SurfaceBudget.h"
+#include "Log.h"
+#include <sstream>
+
+std::atomic<size_t>       SurfaceBudget::bytes_[SurfaceBudget::CategoryCount];
+std::atomic<size_t>       SurfaceBudget::total_(0);
+std::atomic<size_t>       SurfaceBudget::peak_(0);
+std::atomic<uint64_t>     SurfaceBudget::evictions_(0);
+std::atomic<size_t>       SurfaceBudget::budget_(0);
+uint64_t                  SurfaceBudget::frame_ = 0;
+bool                      SurfaceBudget::overWarned_ = false;
+SurfaceBudget::Clients_T  SurfaceBudget::clients_(static_cast<size_t>(-1));
+std::mutex                SurfaceBudget::mutex_;
+
+
+SurfaceBudget::Account::Account()
+{
+    for(int i = 0; i < CategoryCount; ++i)
+    {
+        bytes_[i] = 0;
+    }
+}
+
+
+SurfaceBudget::Account::~Account()
+{
+    for(int i = 0; i < CategoryCount; ++i)
+    {
+        set(static_cast<Category>(i), 0);
+    }
+}
+
+
+void SurfaceBudget::Account::set(Category category, size_t bytes)
+{
+    if(bytes > bytes_[category])
+    {
+        add(category, bytes - bytes_[category]);
+    }
+    else if(bytes < bytes_[category])
+    {
+        remove(category, bytes_[category] - bytes);
+    }
+    bytes_[category] = bytes;
+}
+
+
+size_t SurfaceBudget::Account::bytes(Category category) const
+{
+    return bytes_[category];
+}
+
+
+SurfaceBudget::Client::~Client()
+{
+    forget(this);
+}
+
+
+void SurfaceBudget::setBudget(size_t bytes)
+{
+    budget_ = bytes;
+}
+
+
+size_t SurfaceBudget::budget()
+{
+    return budget_;
+}
+
+
+size_t SurfaceBudget::bytes(Category category)
+{
+    return bytes_[category].load(std::memory_order_relaxed);
+}
+
+
+size_t SurfaceBudget::total()
+{
+    return total_.load(std::memory_order_relaxed);
+}
+
+
+size_t SurfaceBudget::peak()
+{
+    return peak_.load(std::memory_order_relaxed);
+}
+
+
+uint64_t SurfaceBudget::evictions()
+{
+    return evictions_.load(std::memory_order_relaxed);
+}
+
+
+// Makes a client which loaded surfaces evictable before it is first drawn,
+// e.g. list items prefetched off screen.
+void SurfaceBudget::loaded(Client *client)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(!clients_.contains(client))
+    {
+        clients_.insert(client, frame_ - 1);
+    }
+}
+
+
+// Marks client as drawn in the current frame, which protects its surfaces
+// from eviction until the next frame ends.
+void SurfaceBudget::drawn(Client *client)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t *frame = clients_.find(client);
+    if(frame)
+    {
+        *frame = frame_;
+    }
+    else
+    {
+        clients_.insert(client, frame_);
+    }
+}
+
+
+void SurfaceBudget::forget(Client *client)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    clients_.erase(client);
+}
+
+
+// Evicts least recently drawn clients until the total is back under budget
+// or only clients drawn this frame are left.
+void SurfaceBudget::endFrame()
+{
+    while(true)
+    {
+        Client *client = NULL;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            uint64_t lastDrawn;
+            if(budget() > 0 && total() > budget() && clients_.oldest(client, lastDrawn) && lastDrawn != frame_)
+            {
+                clients_.erase(client);
+            }
+            else
+            {
+                client = NULL;
+            }
+        }
+        if(!client)
+        {
+            break;
+        }
+        client->releaseSurfaces();
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool over = budget() > 0 && total() > budget();
+    if(over && !overWarned_)
+    {
+        Logger::write(Logger::ZONE_WARNING, "Memory", "Surfaces over budget with nothing left to evict: " + report());
+    }
+    overWarned_ = over;
+    frame_++;
+}
+
+
+const char *SurfaceBudget::name(Category category)
+{
+    switch(category)
+    {
+    case CategoryArtwork: return "artwork";
+    case CategoryScaled:  return "scaled";
+    case CategoryText:    return "text";
+    case CategoryVideo:   return "video";
+    default:              return "unknown";
+    }
+}
+
+
+std::string SurfaceBudget::report()
+{
+    std::stringstream ss;
+    const double mb = 1024.0 * 1024.0;
+
+    ss.setf(std::ios::fixed);
+    ss.precision(1);
+    for(int i = 0; i < CategoryCount; ++i)
+    {
+        ss << name(static_cast<Category>(i)) << " " << bytes(static_cast<Category>(i)) / mb << " MB, ";
+    }
+    ss << "total " << total() / mb << " MB, peak " << peak() / mb << " MB, ";
+    if(budget() > 0)
+    {
+        ss << "budget " << budget() / mb << " MB, ";
+    }
+    else
+    {
+        ss << "no budget, ";
+    }
+    ss << evictions() << " evictions";
+
+    return ss.str();
+}
+
+
+void SurfaceBudget::add(Category category, size_t bytes)
+{
+    bytes_[category].fetch_add(bytes, std::memory_order_relaxed);
+    size_t total = total_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t peak  = peak_.load(std::memory_order_relaxed);
+    while(total > peak && !peak_.compare_exchange_weak(peak, total, std::memory_order_relaxed))
+    {
+    }
+}
+
+
+void SurfaceBudget::remove(Category category, size_t bytes)
+{
+    bytes_[category].fetch_sub(bytes, std::memory_order_relaxed);
+    total_.fetch_sub(bytes, std::memory_order_relaxed);
+}
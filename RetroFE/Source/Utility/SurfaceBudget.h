@@ -0,0 +1,99 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "LruCache.h"
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+
+// Process wide accounting of the memory held in decoded surfaces, by owner
+// category, with an optional budget. Owners report what they hold through an
+// Account. Owners which can reload their surfaces on demand register as a
+// Client and report when they are drawn; while the total is over budget,
+// endFrame() asks the least recently drawn clients which were not drawn this
+// frame (off screen list items, cached pages) to release their surfaces.
+class SurfaceBudget
+{
+public:
+    enum Category
+    {
+        CategoryArtwork,
+        CategoryScaled,
+        CategoryText,
+        CategoryVideo,
+        CategoryCount
+    };
+
+    // The bytes one owner holds in each category. set() only touches the
+    // global totals when a value changes, so owners may call it every frame.
+    class Account
+    {
+    public:
+        Account();
+        ~Account();
+        void set(Category category, size_t bytes);
+        size_t bytes(Category category) const;
+
+    private:
+        Account(const Account &);
+        Account &operator=(const Account &);
+
+        size_t bytes_[CategoryCount];
+    };
+
+    // An owner whose surfaces can be dropped while it is not drawn.
+    // releaseSurfaces() must not call back into drawn() or forget().
+    class Client
+    {
+    public:
+        virtual ~Client();
+        virtual void releaseSurfaces() = 0;
+    };
+
+    // 0 disables eviction
+    static void setBudget(size_t bytes);
+    static size_t budget();
+    static size_t bytes(Category category);
+    static size_t total();
+    static size_t peak();
+    static uint64_t evictions();
+
+    static void loaded(Client *client);
+    static void drawn(Client *client);
+    static void forget(Client *client);
+    static void endFrame();
+
+    static const char *name(Category category);
+    static std::string report();
+
+private:
+    typedef LruCache<Client *, uint64_t> Clients_T;
+
+    static void add(Category category, size_t bytes);
+    static void remove(Category category, size_t bytes);
+
+    static std::atomic<size_t>   bytes_[CategoryCount];
+    static std::atomic<size_t>   total_;
+    static std::atomic<size_t>   peak_;
+    static std::atomic<uint64_t> evictions_;
+    static std::atomic<size_t>   budget_;
+    static uint64_t              frame_;
+    static bool                  overWarned_;
+    static Clients_T             clients_;
+    static std::mutex            mutex_;
+};
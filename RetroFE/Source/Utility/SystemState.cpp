@@ -0,0 +1,298 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SystemState.h"
+#include "Log.h"
+#include "Utils.h"
+#include "../Execute/Process.h"
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sstream>
+#include <unistd.h>
+
+// level not read yet, or no level change waiting to be applied
+static const int NO_LEVEL = -1;
+static const int DEFAULT_LEVEL = 50;
+
+std::thread SystemState::thread_;
+std::mutex SystemState::mutex_;
+std::condition_variable SystemState::wake_;
+bool SystemState::running_ = false;
+bool SystemState::refresh_ = false;
+bool SystemState::reloadLevels_ = false;
+int SystemState::pollPeriodMs_ = 1000;
+
+SystemState::SysfsValue SystemState::batteryCapacity_ = { "", -1 };
+SystemState::SysfsValue SystemState::batteryPresent_ = { "", -1 };
+SystemState::SysfsValue SystemState::usbPresent_ = { "", -1 };
+
+std::atomic<int> SystemState::batteryPercent_(0);
+std::atomic<bool> SystemState::batteryConnected_(false);
+std::atomic<bool> SystemState::usbConnected_(false);
+std::atomic<unsigned int> SystemState::pollCount_(0);
+std::atomic<int> SystemState::volume_(NO_LEVEL);
+std::atomic<int> SystemState::brightness_(NO_LEVEL);
+std::atomic<int> SystemState::pendingVolume_(NO_LEVEL);
+std::atomic<int> SystemState::pendingBrightness_(NO_LEVEL);
+
+// Starts the service. The battery is polled once before returning so the
+// first frame already has real values.
+void SystemState::start(const std::string &batteryCapacityFile, const std::string &batteryPresentFile,
+                        const std::string &usbPresentFile, int pollPeriodMs)
+{
+    stop();
+
+    batteryCapacity_.path = batteryCapacityFile;
+    batteryPresent_.path  = batteryPresentFile;
+    usbPresent_.path      = usbPresentFile;
+    pollPeriodMs_         = (pollPeriodMs > 0) ? pollPeriodMs : 1000;
+
+    poll();
+
+    running_      = true;
+    refresh_      = false;
+    reloadLevels_ = false;
+    thread_       = std::thread(run);
+}
+
+void SystemState::stop()
+{
+    if(thread_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+        }
+        wake_.notify_one();
+        thread_.join();
+    }
+
+    closeAll();
+}
+
+// Asks the thread for a poll now rather than at the end of the period.
+void SystemState::refresh()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        refresh_ = true;
+    }
+    wake_.notify_one();
+}
+
+// Reads the volume and brightness again, since a game or script may have
+// changed them. The thread reads them on its next pass, so the caller never
+// waits on the level commands.
+void SystemState::reloadLevels()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reloadLevels_ = true;
+        refresh_      = true;
+    }
+    wake_.notify_one();
+}
+
+int SystemState::getBatteryPercent()
+{
+    return batteryPercent_;
+}
+
+bool SystemState::isBatteryConnected()
+{
+    return batteryConnected_;
+}
+
+bool SystemState::isUsbConnected()
+{
+    return usbConnected_;
+}
+
+unsigned int SystemState::getPollCount()
+{
+    return pollCount_;
+}
+
+int SystemState::getVolume()
+{
+    int volume = volume_;
+    return (volume == NO_LEVEL) ? DEFAULT_LEVEL : volume;
+}
+
+int SystemState::getBrightness()
+{
+    int brightness = brightness_;
+    return (brightness == NO_LEVEL) ? DEFAULT_LEVEL : brightness;
+}
+
+void SystemState::setVolume(int percent)
+{
+    volume_ = percent;
+    pendingVolume_ = percent;
+    refresh();
+}
+
+void SystemState::setBrightness(int percent)
+{
+    brightness_ = percent;
+    pendingBrightness_ = percent;
+    refresh();
+}
+
+void SystemState::run()
+{
+    readLevels();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(running_)
+    {
+        wake_.wait_for(lock, std::chrono::milliseconds(pollPeriodMs_), []{ return !running_ || refresh_; });
+        refresh_ = false;
+        bool reload = reloadLevels_;
+        reloadLevels_ = false;
+
+        if(!running_)
+        {
+            break;
+        }
+
+        lock.unlock();
+        applyLevels();
+        if(reload)
+        {
+            readLevels();
+        }
+        poll();
+        lock.lock();
+    }
+
+    // a level set just before shutdown is still applied
+    lock.unlock();
+    applyLevels();
+}
+
+void SystemState::poll()
+{
+    int capacity = read(batteryCapacity_);
+
+    batteryPercent_   = (capacity >= 0) ? capacity : 0;
+    batteryConnected_ = (read(batteryPresent_) == 1);
+    usbConnected_     = (read(usbPresent_) == 1);
+
+    pollCount_++;
+}
+
+// Reads an integer attribute, or -1. The descriptor stays open between
+// polls; it is reopened only if a read fails.
+int SystemState::read(SysfsValue &value)
+{
+    if(value.fd < 0)
+    {
+        value.fd = open(value.path.c_str(), O_RDONLY | O_CLOEXEC);
+        if(value.fd < 0)
+        {
+            return -1;
+        }
+    }
+
+    char buffer[32];
+    ssize_t bytes = pread(value.fd, buffer, sizeof(buffer) - 1, 0);
+    if(bytes <= 0)
+    {
+        close(value.fd);
+        value.fd = -1;
+        return -1;
+    }
+    buffer[bytes] = '\0';
+
+    return atoi(buffer);
+}
+
+static int readLevel(const char *command)
+{
+    std::string output;
+
+    if(Process::capture(Process::splitArguments(command), output) != 0 || output.empty() || output[0] < '0' || output[0] > '9')
+    {
+        Logger::write(Logger::ZONE_WARNING, "SystemState", "Could not read level from \"" + std::string(command) + "\"");
+        return NO_LEVEL;
+    }
+
+    return atoi(output.c_str());
+}
+
+// Replaces the cached level with the read one, unless the read failed (the
+// getters keep the last level, or the default) or a level set meanwhile is
+// not applied yet: the read value would be stale.
+static void reloadLevel(std::atomic<int> &level, const std::atomic<int> &pending, const char *command)
+{
+    int expected = level;
+    int read     = readLevel(command);
+
+    if(read != NO_LEVEL && pending == NO_LEVEL)
+    {
+        level.compare_exchange_strong(expected, read);
+    }
+}
+
+void SystemState::readLevels()
+{
+    reloadLevel(volume_, pendingVolume_, SHELL_CMD_VOLUME_GET);
+    reloadLevel(brightness_, pendingBrightness_, SHELL_CMD_BRIGHTNESS_GET);
+}
+
+static void applyLevel(const char *command, int percent)
+{
+    Process::Args argv = Process::splitArguments(command);
+    std::stringstream ss;
+    ss << percent;
+    argv.push_back(ss.str());
+
+    if(Process::run(argv) != 0)
+    {
+        Logger::write(Logger::ZONE_WARNING, "SystemState", "Failed to run: " + std::string(command) + " " + ss.str());
+    }
+}
+
+void SystemState::applyLevels()
+{
+    int volume = pendingVolume_.exchange(NO_LEVEL);
+    if(volume != NO_LEVEL)
+    {
+        applyLevel(SHELL_CMD_VOLUME_SET, volume);
+    }
+
+    int brightness = pendingBrightness_.exchange(NO_LEVEL);
+    if(brightness != NO_LEVEL)
+    {
+        applyLevel(SHELL_CMD_BRIGHTNESS_SET, brightness);
+    }
+}
+
+void SystemState::closeAll()
+{
+    SysfsValue *values[] = { &batteryCapacity_, &batteryPresent_, &usbPresent_ };
+
+    for(unsigned int i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+    {
+        if(values[i]->fd >= 0)
+        {
+            close(values[i]->fd);
+            values[i]->fd = -1;
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Background service for the hardware state shown in the UI. A thread polls
+// the battery through sysfs (descriptors stay open, each poll is a pread at
+// offset 0), reads the volume and brightness levels at start and whenever
+// reloadLevels() asks, and applies level changes. The render thread only ever
+// loads cached atomics; repeated level changes between two passes of the
+// thread are coalesced into the last one.
+class SystemState
+{
+public:
+    static void start(const std::string &batteryCapacityFile, const std::string &batteryPresentFile,
+                      const std::string &usbPresentFile, int pollPeriodMs);
+    static void stop();
+    static void refresh();
+    static void reloadLevels();
+
+    static int getBatteryPercent();
+    static bool isBatteryConnected();
+    static bool isUsbConnected();
+    static unsigned int getPollCount();
+
+    static int getVolume();
+    static int getBrightness();
+    static void setVolume(int percent);
+    static void setBrightness(int percent);
+
+private:
+    struct SysfsValue
+    {
+        std::string path;
+        int         fd;
+    };
+
+    static void run();
+    static void poll();
+    static int read(SysfsValue &value);
+    static void readLevels();
+    static void applyLevels();
+    static void closeAll();
+
+    static std::thread             thread_;
+    static std::mutex              mutex_;
+    static std::condition_variable wake_;
+    static bool                    running_;
+    static bool                    refresh_;
+    static bool                    reloadLevels_;
+    static int                     pollPeriodMs_;
+
+    static SysfsValue batteryCapacity_;
+    static SysfsValue batteryPresent_;
+    static SysfsValue usbPresent_;
+
+    static std::atomic<int>          batteryPercent_;
+    static std::atomic<bool>         batteryConnected_;
+    static std::atomic<bool>         usbConnected_;
+    static std::atomic<unsigned int> pollCount_;
+    static std::atomic<int>          volume_;
+    static std::atomic<int>          brightness_;
+    static std::atomic<int>          pendingVolume_;
+    static std::atomic<int>          pendingBrightness_;
+};
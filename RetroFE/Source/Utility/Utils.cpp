@@ -16,6 +16,7 @@
 
 #include "Utils.h"
 #include "../Database/Configuration.h"
+#include "FrameStats.h"
 #include "Log.h"
 #include <algorithm>
 #include <sstream>
@@ -151,6 +152,7 @@ bool Utils::findMatchingFile(std::string prefix, std::vector<std::string> &exten
         std::string temp = prefix + "." + extensions[i];
         temp = Configuration::convertToAbsolutePath(Configuration::isUserLayout_?Configuration::userPath:Configuration::absolutePath, temp);
 
+        FrameStats::countFileProbe();
         std::ifstream f(temp.c_str());
 
         if (f.good())
@@ -291,6 +293,7 @@ std::string Utils::trimEnds(std::string str)
 bool Utils::IsPathExist(const std::string &s)
 {
     struct stat buffer;
+    FrameStats::countFileProbe();
     return (stat (s.c_str(), &buffer) == 0);
 }
 
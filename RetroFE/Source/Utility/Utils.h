@@ -27,6 +27,10 @@
 #define SHELL_CMD_AUDIO_AMP_OFF         "audio_amp off"
 #define SHELL_CMD_MAPPING_ROM           "keymap rom"
 #define SHELL_CMD_MAPPING_DEFAULT       "keymap default"
+#define SHELL_CMD_VOLUME_GET            "volume get"
+#define SHELL_CMD_VOLUME_SET            "volume set"
+#define SHELL_CMD_BRIGHTNESS_GET        "brightness get"
+#define SHELL_CMD_BRIGHTNESS_SET        "brightness set"
 
 class Utils
 {
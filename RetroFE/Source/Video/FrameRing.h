@@ -0,0 +1,76 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <atomic>
+
+// Fixed size single producer / single consumer queue. The GStreamer streaming
+// thread pushes decoded frames and the render thread pops them; neither side
+// takes a lock or waits on the other.
+template <typename T, unsigned int N>
+class FrameRing
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "FrameRing size must be a power of two");
+
+public:
+    FrameRing()
+        : head_(0)
+        , tail_(0)
+    {
+    }
+
+    // producer side; returns false (and leaves the ring untouched) when full
+    bool push(const T &item)
+    {
+        unsigned int head = head_.load(std::memory_order_relaxed);
+
+        if(head - tail_.load(std::memory_order_acquire) >= N)
+        {
+            return false;
+        }
+
+        items_[head & (N - 1)] = item;
+        head_.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // consumer side; returns false when empty
+    bool pop(T &item)
+    {
+        unsigned int tail = tail_.load(std::memory_order_relaxed);
+
+        if(tail == head_.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        item = items_[tail & (N - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    unsigned int size()
+    {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    T                         items_[N];
+    std::atomic<unsigned int> head_;
+    std::atomic<unsigned int> tail_;
+};
@@ -32,6 +32,9 @@
 #include <gst/video/video.h>
 
 bool GStreamerVideo::initialized_ = false;
+int GStreamerVideo::defaultMaxWidth_ = 0;
+int GStreamerVideo::defaultMaxHeight_ = 0;
+int GStreamerVideo::defaultMaxFrameRate_ = 0;
 
 //todo: this started out as sandbox code. This class needs to be refactored
 
@@ -45,17 +48,29 @@ GStreamerVideo::GStreamerVideo()
     : playbin_(NULL)
     , videoBin_(NULL)
     , videoSink_(NULL)
+    , videoScale_(NULL)
+    , videoRate_(NULL)
     , videoConvert_(NULL)
     , videoConvertCaps_(NULL)
     , videoBus_(NULL)
-    //, texture_(NULL)
+    , busWatchId_(0)
+    , texture_(NULL)
     , height_(0)
     , width_(0)
+    , streamHeight_(0)
+    , streamWidth_(0)
     , videoBuffer_(NULL)
     , frameReady_(false)
     , isPlaying_(false)
+    , isPaused_(false)
+    , maxWidth_(0)
+    , maxHeight_(0)
+    , maxFrameRate_(0)
     , playCount_(0)
     , numLoops_(0)
+    , droppedFrames_(0)
+    , lateFrames_(0)
+    , presentedFrames_(0)
 {
 }
 GStreamerVideo::~GStreamerVideo()
@@ -68,11 +83,12 @@ GStreamerVideo::~GStreamerVideo()
         videoBuffer_ = NULL;
     }
 
-    /*if (texture_)
+    if(texture_)
     {
-        SDL_DestroyTexture(texture_);
+        SDL_FreeSurface(texture_);
         texture_ = NULL;
-    }*/
+        account_.set(SurfaceBudget::CategoryVideo, 0);
+    }
 
     freeElements();
 }
@@ -82,34 +98,89 @@ void GStreamerVideo::setNumLoops(int n)
     numLoops_ = n;
 }
 
-/*SDL_Texture *GStreamerVideo::getTexture() const
+void GStreamerVideo::setDecodeLimits(int maxWidth, int maxHeight, int maxFrameRate)
 {
-    return texture_;
-}*/
+    maxWidth_     = maxWidth;
+    maxHeight_    = maxHeight;
+    maxFrameRate_ = maxFrameRate;
+}
+
+void GStreamerVideo::setDefaultDecodeLimits(int maxWidth, int maxHeight, int maxFrameRate)
+{
+    defaultMaxWidth_     = maxWidth;
+    defaultMaxHeight_    = maxHeight;
+    defaultMaxFrameRate_ = maxFrameRate;
+}
+
+// the tighter of the global and the layout limit wins; 0 means unlimited
+static int tighterLimit(int a, int b)
+{
+    if(a <= 0) return b;
+    if(b <= 0) return a;
+    return (a < b) ? a : b;
+}
+
+GstCaps *GStreamerVideo::createLimitCaps()
+{
+    int maxWidth     = tighterLimit(maxWidth_, defaultMaxWidth_);
+    int maxHeight    = tighterLimit(maxHeight_, defaultMaxHeight_);
+    int maxFrameRate = tighterLimit(maxFrameRate_, defaultMaxFrameRate_);
+    std::stringstream ss;
+
+    // videoscale/videorate in front of this capsfilter only kick in when the
+    // stream exceeds a limit; otherwise the caps pass through unchanged
+    ss << "video/x-raw";
+    if(maxWidth > 0)
+    {
+        ss << ",width=(int)[1," << maxWidth << "]";
+    }
+    if(maxHeight > 0)
+    {
+        ss << ",height=(int)[1," << maxHeight << "]";
+    }
+    if(maxFrameRate > 0)
+    {
+        ss << ",framerate=(fraction)[0/1," << maxFrameRate << "/1]";
+    }
 
+    return gst_caps_from_string(ss.str().c_str());
+}
+
+// runs on the GStreamer streaming thread; only touches the frame ring and the stream* members
 void GStreamerVideo::processNewBuffer (GstElement * /* fakesink */, GstBuffer *buf, GstPad *new_pad, gpointer userdata)
 {
     GStreamerVideo *video = (GStreamerVideo *)userdata;
 
-    SDL_LockMutex(SDL::getMutex());
-    if (!video->frameReady_ && video && video->isPlaying_)
+    if (video && video->isPlaying_)
     {
-        if(!video->width_ || !video->height_)
+        if(!video->streamWidth_ || !video->streamHeight_)
         {
             GstCaps *caps = gst_pad_get_current_caps (new_pad);
-            GstStructure *s = gst_caps_get_structure(caps, 0);
+            if(caps)
+            {
+                GstStructure *s = gst_caps_get_structure(caps, 0);
 
-            gst_structure_get_int(s, "width", &video->width_);
-            gst_structure_get_int(s, "height", &video->height_);
+                gst_structure_get_int(s, "width", &video->streamWidth_);
+                gst_structure_get_int(s, "height", &video->streamHeight_);
+                gst_caps_unref(caps);
+            }
         }
 
-        if(video->height_ && video->width_ && !video->videoBuffer_)
+        if(video->streamHeight_ && video->streamWidth_)
         {
-            video->videoBuffer_ = gst_buffer_ref(buf);
-            video->frameReady_ = true;
+            Frame frame;
+            frame.buffer = gst_buffer_ref(buf);
+            frame.width  = video->streamWidth_;
+            frame.height = video->streamHeight_;
+
+            // the render thread has fallen behind by a whole ring; drop this frame
+            if(!video->frames_.push(frame))
+            {
+                gst_buffer_unref(frame.buffer);
+                video->droppedFrames_++;
+            }
         }
     }
-    SDL_UnlockMutex(SDL::getMutex());
 }
 
 
@@ -158,11 +229,19 @@ bool GStreamerVideo::stop()
         (void)gst_element_set_state(playbin_, GST_STATE_NULL);
     }
 
-    /*if(texture_)
+    // the streaming thread has stopped, so the ring can be drained from here
+    Frame frame;
+    while(frames_.pop(frame))
+    {
+        gst_buffer_unref(frame.buffer);
+    }
+
+    if(texture_)
     {
-        SDL_DestroyTexture(texture_);
+        SDL_FreeSurface(texture_);
         texture_ = NULL;
-    }*/
+        account_.set(SurfaceBudget::CategoryVideo, 0);
+    }
 
     if(videoBuffer_)
     {
@@ -170,16 +249,64 @@ bool GStreamerVideo::stop()
         videoBuffer_ = NULL;
     }
 
+    if(presentedFrames_ || droppedFrames_ || lateFrames_)
+    {
+        std::stringstream ss;
+        ss << currentFile_ << ": " << presentedFrames_ << " frames presented, "
+           << droppedFrames_ << " dropped, " << lateFrames_ << " late";
+        Logger::write(Logger::ZONE_INFO, "Video", ss.str());
+    }
+
     // FreeElements();
 
     isPlaying_ = false;
+    isPaused_ = false;
     height_ = 0;
     width_ = 0;
+    streamHeight_ = 0;
+    streamWidth_ = 0;
     frameReady_ = false;
+    droppedFrames_ = 0;
+    lateFrames_ = 0;
+    presentedFrames_ = 0;
 
     return true;
 }
 
+// Pausing keeps the pipeline prerolled at its current position, so resuming
+// continues from the frame that is on screen without a seek.
+bool GStreamerVideo::pause()
+{
+    if(!playbin_ || !isPlaying_ || isPaused_)
+    {
+        return false;
+    }
+
+    if(gst_element_set_state(playbin_, GST_STATE_PAUSED) == GST_STATE_CHANGE_FAILURE)
+    {
+        return false;
+    }
+
+    isPaused_ = true;
+    return true;
+}
+
+bool GStreamerVideo::resume()
+{
+    if(!playbin_ || !isPlaying_ || !isPaused_)
+    {
+        return false;
+    }
+
+    if(gst_element_set_state(playbin_, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE)
+    {
+        return false;
+    }
+
+    isPaused_ = false;
+    return true;
+}
+
 bool GStreamerVideo::play(std::string file)
 {
     playCount_ = 0;
@@ -208,6 +335,8 @@ bool GStreamerVideo::play(std::string file)
             playbin_ = gst_element_factory_make("playbin", "player");
             videoBin_ = gst_bin_new("SinkBin");
             videoSink_  = gst_element_factory_make("fakesink", "video_sink");
+            videoScale_  = gst_element_factory_make("videoscale", "video_scale");
+            videoRate_  = gst_element_factory_make("videorate", "video_rate");
             videoConvert_  = gst_element_factory_make("capsfilter", "video_convert");
             videoConvertCaps_ = gst_caps_from_string("video/x-raw,format=(string)I420,pixel-aspect-ratio=(fraction)1/1");
             height_ = 0;
@@ -224,6 +353,12 @@ bool GStreamerVideo::play(std::string file)
                 freeElements();
                 return false;
             }
+            if(!videoScale_ || !videoRate_)
+            {
+                Logger::write(Logger::ZONE_DEBUG, "Video", "Could not create video scaler");
+                freeElements();
+                return false;
+            }
             if(!videoConvert_)
             {
                 Logger::write(Logger::ZONE_DEBUG, "Video", "Could not create video converter");
@@ -237,9 +372,10 @@ bool GStreamerVideo::play(std::string file)
                 return false;
             }
 
-            gst_bin_add_many(GST_BIN(videoBin_), videoConvert_, videoSink_, NULL);
+            gst_bin_add_many(GST_BIN(videoBin_), videoScale_, videoRate_, videoConvert_, videoSink_, NULL);
+            gst_element_link_many(videoScale_, videoRate_, videoConvert_, NULL);
             gst_element_link_filtered(videoConvert_, videoSink_, videoConvertCaps_);
-            GstPad *videoConvertSinkPad = gst_element_get_static_pad(videoConvert_, "sink");
+            GstPad *videoConvertSinkPad = gst_element_get_static_pad(videoScale_, "sink");
 
             if(!videoConvertSinkPad)
             {
@@ -263,17 +399,27 @@ bool GStreamerVideo::play(std::string file)
             gst_element_add_pad(videoBin_, videoSinkPad);
             gst_object_unref(videoConvertSinkPad);
             videoConvertSinkPad = NULL;
+
+            // connected once for the life of the pipeline; stop() only turns
+            // the handoffs off, so a replay does not queue each frame twice
+            g_signal_connect(videoSink_, "handoff", G_CALLBACK(processNewBuffer), this);
+
+            videoBus_ = gst_pipeline_get_bus(GST_PIPELINE(playbin_));
+            busWatchId_ = gst_bus_add_watch(videoBus_, &busCallback, this);
         }
+        GstCaps *limitCaps = createLimitCaps();
+        if(limitCaps)
+        {
+            g_object_set(G_OBJECT(videoConvert_), "caps", limitCaps, NULL);
+            gst_caps_unref(limitCaps);
+        }
+
         g_object_set(G_OBJECT(playbin_), "uri", file.c_str(), "video-sink", videoBin_, NULL);
 
         isPlaying_ = true;
 
 
         g_object_set(G_OBJECT(videoSink_), "signal-handoffs", TRUE, NULL);
-        g_signal_connect(videoSink_, "handoff", G_CALLBACK(processNewBuffer), this);
-
-        videoBus_ = gst_pipeline_get_bus(GST_PIPELINE(playbin_));
-        gst_bus_add_watch(videoBus_, &busCallback, this);
 
         /* Start playing */
         GstStateChangeReturn playState = gst_element_set_state(GST_ELEMENT(playbin_), GST_STATE_PLAYING);
@@ -294,6 +440,16 @@ bool GStreamerVideo::play(std::string file)
 
 void GStreamerVideo::freeElements()
 {
+    if(busWatchId_)
+    {
+        g_source_remove(busWatchId_);
+        busWatchId_ = 0;
+    }
+    if(videoBus_)
+    {
+        gst_object_unref(videoBus_);
+        videoBus_ = NULL;
+    }
     if(videoBin_)
     {
         gst_object_unref(videoBin_);
@@ -304,6 +460,16 @@ void GStreamerVideo::freeElements()
         gst_object_unref(videoSink_);
         videoSink_ = NULL;
     }
+    if(videoScale_)
+    {
+        gst_object_unref(videoScale_);
+        videoScale_ = NULL;
+    }
+    if(videoRate_)
+    {
+        gst_object_unref(videoRate_);
+        videoRate_ = NULL;
+    }
     if(videoConvert_)
     {
         gst_object_unref(videoConvert_);
@@ -333,82 +499,152 @@ int GStreamerVideo::getWidth()
 }
 
 
-void GStreamerVideo::draw()
+SDL_Surface *GStreamerVideo::getTexture(int width, int height)
 {
-    frameReady_ = false;
+    if(width <= 0 || height <= 0 || !videoBuffer_)
+    {
+        return texture_;
+    }
+
+    SDL_Surface *window = SDL::getWindow();
+
+    // convert straight into the layout of the screen, at the size it is drawn
+    if(texture_ && (texture_->w != width || texture_->h != height))
+    {
+        SDL_FreeSurface(texture_);
+        texture_ = NULL;
+    }
+
+    if(!texture_ && window)
+    {
+        SDL_PixelFormat *format = window->format;
+        texture_ = SDL_CreateRGBSurface(SDL_SWSURFACE, width, height, format->BitsPerPixel,
+                                        format->Rmask, format->Gmask, format->Bmask, 0);
+        if(!texture_)
+        {
+            Logger::write(Logger::ZONE_ERROR, "Video", "Could not create video surface: " + std::string(SDL_GetError()));
+            return NULL;
+        }
+        frameReady_ = true;
+    }
+    account_.set(SurfaceBudget::CategoryVideo, SDL::surfaceBytes(texture_));
+
+    if(texture_ && frameReady_ && convertFrame())
+    {
+        frameReady_ = false;
+        // a new frame in the same surface, any rotation of it is stale
+        SDL::surfaceChanged(texture_);
+    }
+
+    return texture_;
 }
 
-void GStreamerVideo::update(float /* dt */)
+bool GStreamerVideo::convertFrame()
 {
-    SDL_LockMutex(SDL::getMutex());
-    /*if(!texture_ && width_ != 0 && height_ != 0)
+    bool retVal = false;
+    SDL_PixelFormat *format = texture_->format;
+    YuvConverter::PixelLayout layout;
+    YuvConverter::Planes planes;
+
+    layout.bytesPerPixel = format->BytesPerPixel;
+    layout.rShift        = format->Rshift;
+    layout.gShift        = format->Gshift;
+    layout.bShift        = format->Bshift;
+    layout.rLoss         = format->Rloss;
+    layout.gLoss         = format->Gloss;
+    layout.bLoss         = format->Bloss;
+    layout.aMask         = format->Amask;
+
+    planes.width  = width_;
+    planes.height = height_;
+
+    if(SDL_MUSTLOCK(texture_))
     {
-        texture_ = SDL_CreateTexture(SDL::getRenderer(), SDL_PIXELFORMAT_IYUV,
-                                    SDL_TEXTUREACCESS_STREAMING, width_, height_);
-        SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
-    }*/
+        SDL_LockSurface(texture_);
+    }
 
-    if(videoBuffer_)
+    GstVideoMeta *meta = gst_buffer_get_video_meta(videoBuffer_);
+
+    // Presence of meta indicates non-contiguous data in the buffer
+    if (meta)
     {
-        GstVideoMeta *meta;
-        meta = gst_buffer_get_video_meta(videoBuffer_);
+        GstMapInfo y_info, u_info, v_info;
+        gpointer y_plane, u_plane, v_plane;
+        gint y_stride, u_stride, v_stride;
+
+        gst_video_meta_map(meta, 0, &y_info, &y_plane, &y_stride, GST_MAP_READ);
+        gst_video_meta_map(meta, 1, &u_info, &u_plane, &u_stride, GST_MAP_READ);
+        gst_video_meta_map(meta, 2, &v_info, &v_plane, &v_stride, GST_MAP_READ);
+
+        planes.y       = static_cast<const unsigned char *>(y_plane);
+        planes.u       = static_cast<const unsigned char *>(u_plane);
+        planes.v       = static_cast<const unsigned char *>(v_plane);
+        planes.yStride = y_stride;
+        planes.uStride = u_stride;
+        planes.vStride = v_stride;
+        retVal = converter_.convert(planes, layout, texture_->pixels, texture_->pitch, texture_->w, texture_->h);
+
+        gst_video_meta_unmap(meta, 0, &y_info);
+        gst_video_meta_unmap(meta, 1, &u_info);
+        gst_video_meta_unmap(meta, 2, &v_info);
+    }
+    else
+    {
+        GstVideoInfo info;
+        GstMapInfo bufInfo;
 
-        // Presence of meta indicates non-contiguous data in the buffer
-        if (!meta)
-        {
-            void *pixels;
-            int pitch;
-            unsigned int vbytes = width_ * height_;
-            vbytes += (vbytes / 2);
-            gsize bufSize = gst_buffer_get_size(videoBuffer_);
+        // without meta the planes follow GStreamer's default I420 layout
+        gst_video_info_set_format(&info, GST_VIDEO_FORMAT_I420, width_, height_);
 
-            if (bufSize == vbytes)
-            {
-                //SDL_LockTexture(texture_, NULL, &pixels, &pitch);
-                gst_buffer_extract(videoBuffer_, 0, pixels, vbytes);
-                //SDL_UnlockTexture(texture_);
-            }
-            else
+        if(gst_buffer_map(videoBuffer_, &bufInfo, GST_MAP_READ))
+        {
+            if(bufInfo.size >= GST_VIDEO_INFO_SIZE(&info))
             {
-                GstMapInfo bufInfo;
-                unsigned int y_stride, u_stride, v_stride;
-                const Uint8 *y_plane, *u_plane, *v_plane;
-                std::stringstream ss;
-
-                y_stride = GST_ROUND_UP_4(width_);
-                u_stride = v_stride = GST_ROUND_UP_4(y_stride / 2);
-
-                gst_buffer_map(videoBuffer_, &bufInfo, GST_MAP_READ);
-                y_plane = bufInfo.data;
-                u_plane = y_plane + (height_ * y_stride);
-                v_plane = u_plane + ((height_ / 2) * u_stride);
-                /*SDL_UpdateYUVTexture(texture_, NULL,
-                                     (const Uint8*)y_plane, y_stride,
-                                     (const Uint8*)u_plane, u_stride,
-                                     (const Uint8*)v_plane, v_stride);*/
-                gst_buffer_unmap(videoBuffer_, &bufInfo);
+                planes.y       = bufInfo.data + GST_VIDEO_INFO_PLANE_OFFSET(&info, 0);
+                planes.u       = bufInfo.data + GST_VIDEO_INFO_PLANE_OFFSET(&info, 1);
+                planes.v       = bufInfo.data + GST_VIDEO_INFO_PLANE_OFFSET(&info, 2);
+                planes.yStride = GST_VIDEO_INFO_PLANE_STRIDE(&info, 0);
+                planes.uStride = GST_VIDEO_INFO_PLANE_STRIDE(&info, 1);
+                planes.vStride = GST_VIDEO_INFO_PLANE_STRIDE(&info, 2);
+                retVal = converter_.convert(planes, layout, texture_->pixels, texture_->pitch, texture_->w, texture_->h);
             }
+            gst_buffer_unmap(videoBuffer_, &bufInfo);
         }
-        else
+    }
+
+    if(SDL_MUSTLOCK(texture_))
+    {
+        SDL_UnlockSurface(texture_);
+    }
+
+    if(retVal)
+    {
+        presentedFrames_++;
+    }
+
+    return retVal;
+}
+
+void GStreamerVideo::update(float /* dt */)
+{
+    Frame frame;
+
+    // keep only the newest decoded frame; anything older missed its slot
+    while(frames_.pop(frame))
+    {
+        if(videoBuffer_)
         {
-            GstMapInfo y_info, u_info, v_info;
-            void *y_plane, *u_plane, *v_plane;
-            int y_stride, u_stride, v_stride;
-
-            gst_video_meta_map(meta, 0, &y_info, &y_plane, &y_stride, GST_MAP_READ);
-            gst_video_meta_map(meta, 1, &u_info, &u_plane, &u_stride, GST_MAP_READ);
-            gst_video_meta_map(meta, 2, &v_info, &v_plane, &v_stride, GST_MAP_READ);
-            /*SDL_UpdateYUVTexture(texture_, NULL,
-                                 (const Uint8*)y_plane, y_stride,
-                                 (const Uint8*)u_plane, u_stride,
-                                 (const Uint8*)v_plane, v_stride);*/
-            gst_video_meta_unmap(meta, 0, &y_info);
-            gst_video_meta_unmap(meta, 1, &u_info);
-            gst_video_meta_unmap(meta, 2, &v_info);
+            gst_buffer_unref(videoBuffer_);
+            if(frameReady_)
+            {
+                lateFrames_++;
+            }
         }
 
-        gst_buffer_unref(videoBuffer_);
-        videoBuffer_ = NULL;
+        videoBuffer_ = frame.buffer;
+        width_       = frame.width;
+        height_      = frame.height;
+        frameReady_  = true;
     }
 
     if(videoBus_)
@@ -442,7 +678,6 @@ void GStreamerVideo::update(float /* dt */)
             gst_message_unref(msg);
         }
     }
-    SDL_UnlockMutex(SDL::getMutex());
 }
 
 
@@ -450,3 +685,18 @@ bool GStreamerVideo::isPlaying()
 {
     return isPlaying_;
 }
+
+unsigned int GStreamerVideo::getPresentedFrames()
+{
+    return presentedFrames_;
+}
+
+unsigned int GStreamerVideo::getDroppedFrames()
+{
+    return droppedFrames_;
+}
+
+unsigned int GStreamerVideo::getLateFrames()
+{
+    return lateFrames_;
+}
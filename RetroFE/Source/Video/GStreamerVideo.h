@@ -16,6 +16,10 @@
 #pragma once
 
 #include "IVideo.h"
+#include "FrameRing.h"
+#include "YuvConverter.h"
+#include "../Utility/SurfaceBudget.h"
+#include <atomic>
 
 extern "C"
 {
@@ -32,34 +36,67 @@ public:
     bool initialize();
     bool play(std::string file);
     bool stop();
+    bool pause();
+    bool resume();
+    void setDecodeLimits(int maxWidth, int maxHeight, int maxFrameRate);
+    static void setDefaultDecodeLimits(int maxWidth, int maxHeight, int maxFrameRate);
     bool deInitialize();
-    //SDL_Texture *getTexture() const;
+    SDL_Surface *getTexture(int width, int height);
     void update(float dt);
-    void draw();
     void setNumLoops(int n);
     void freeElements();
     int getHeight();
     int getWidth();
     bool isPlaying();
+    unsigned int getPresentedFrames();
+    unsigned int getDroppedFrames();
+    unsigned int getLateFrames();
 
 private:
+    struct Frame
+    {
+        GstBuffer *buffer;
+        gint       width;
+        gint       height;
+    };
+
     static void processNewBuffer (GstElement *fakesink, GstBuffer *buf, GstPad *pad, gpointer data);
     static gboolean busCallback(GstBus *bus, GstMessage *msg, gpointer data);
+    bool convertFrame();
+    GstCaps *createLimitCaps();
 
     GstElement *playbin_;
     GstElement *videoBin_;
     GstElement *videoSink_;
+    GstElement *videoScale_;
+    GstElement *videoRate_;
     GstElement *videoConvert_;
     GstCaps *videoConvertCaps_;
     GstBus *videoBus_;
-    //SDL_Texture* texture_;
+    guint busWatchId_;
+    SDL_Surface *texture_;
+    SurfaceBudget::Account account_;
+    YuvConverter converter_;
+    FrameRing<Frame, 4> frames_;
     gint height_;
     gint width_;
+    gint streamHeight_;
+    gint streamWidth_;
     GstBuffer *videoBuffer_;
     bool frameReady_;
-    bool isPlaying_;
+    std::atomic<bool> isPlaying_;
+    bool isPaused_;
+    int maxWidth_;
+    int maxHeight_;
+    int maxFrameRate_;
+    static int defaultMaxWidth_;
+    static int defaultMaxHeight_;
+    static int defaultMaxFrameRate_;
     static bool initialized_;
     int playCount_;
     std::string currentFile_;
     int numLoops_;
+    std::atomic<unsigned int> droppedFrames_;
+    unsigned int lateFrames_;
+    unsigned int presentedFrames_;
 };
@@ -25,10 +25,12 @@ public:
     virtual bool initialize() = 0;
     virtual bool play(std::string file) = 0;
     virtual bool stop() = 0;
+    virtual bool pause() = 0;
+    virtual bool resume() = 0;
+    virtual void setDecodeLimits(int maxWidth, int maxHeight, int maxFrameRate) = 0;
     virtual bool deInitialize() = 0;
-    //virtual SDL_Texture *getTexture() const = 0;
+    virtual SDL_Surface *getTexture(int width, int height) = 0;
     virtual void update(float dt) = 0;
-    virtual void draw() = 0;
     virtual int getHeight() = 0;
     virtual int getWidth() = 0;
 };
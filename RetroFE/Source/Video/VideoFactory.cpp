@@ -44,3 +44,8 @@ void VideoFactory::setNumLoops(int numLoops)
 {
     numLoops_ = numLoops;
 }
+
+void VideoFactory::setDecodeLimits(int maxWidth, int maxHeight, int maxFrameRate)
+{
+    GStreamerVideo::setDefaultDecodeLimits(maxWidth, maxHeight, maxFrameRate);
+}
@@ -23,6 +23,7 @@ public:
     static IVideo *createVideo();
     static void setEnabled(bool enabled);
     static void setNumLoops(int numLoops);
+    static void setDecodeLimits(int maxWidth, int maxHeight, int maxFrameRate);
 
 private:
     static bool enabled_;
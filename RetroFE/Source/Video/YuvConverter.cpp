@@ -0,0 +1,250 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "YuvConverter.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// BT.601 limited range, 8 bit fixed point:
+//   R = (298 * (Y - 16)                     + 409 * (V - 128) + 128) >> 8
+//   G = (298 * (Y - 16) - 100 * (U - 128) - 208 * (V - 128) + 128) >> 8
+//   B = (298 * (Y - 16) + 516 * (U - 128)                   + 128) >> 8
+
+static inline int clampByte(int value)
+{
+    return (value < 0) ? 0 : ((value > 255) ? 255 : value);
+}
+
+YuvConverter::YuvConverter()
+    : tableSrcWidth_(0)
+    , tableDstWidth_(0)
+{
+}
+
+bool YuvConverter::convert(const Planes &src, const PixelLayout &layout, void *dst, int dstPitch, int dstWidth, int dstHeight)
+{
+    if(!src.y || !src.u || !src.v || !dst || src.width <= 0 || src.height <= 0 || dstWidth <= 0 || dstHeight <= 0)
+    {
+        return false;
+    }
+
+    if(layout.bytesPerPixel != 2 && layout.bytesPerPixel != 4)
+    {
+        return false;
+    }
+
+    buildSampleTable(src.width, dstWidth);
+
+    unsigned char *dstRow = static_cast<unsigned char *>(dst);
+
+    for(int row = 0; row < dstHeight; ++row)
+    {
+        int sy = static_cast<int>((static_cast<long long>(2 * row + 1) * src.height) / (2 * dstHeight));
+        const unsigned char *yRow = src.y + sy * src.yStride;
+        const unsigned char *uRow = src.u + (sy >> 1) * src.uStride;
+        const unsigned char *vRow = src.v + (sy >> 1) * src.vStride;
+
+        for(int x = 0; x < dstWidth; ++x)
+        {
+            int sx = sampleX_[x];
+            lineY_[x] = yRow[sx];
+            lineU_[x] = uRow[sx >> 1];
+            lineV_[x] = vRow[sx >> 1];
+        }
+
+        convertRow(&lineY_[0], &lineU_[0], &lineV_[0], layout, dstRow, dstWidth);
+        dstRow += dstPitch;
+    }
+
+    return true;
+}
+
+void YuvConverter::buildSampleTable(int srcWidth, int dstWidth)
+{
+    if(srcWidth == tableSrcWidth_ && dstWidth == tableDstWidth_)
+    {
+        return;
+    }
+
+    sampleX_.resize(dstWidth);
+    lineY_.resize(dstWidth);
+    lineU_.resize(dstWidth);
+    lineV_.resize(dstWidth);
+
+    for(int x = 0; x < dstWidth; ++x)
+    {
+        sampleX_[x] = static_cast<int>((static_cast<long long>(2 * x + 1) * srcWidth) / (2 * dstWidth));
+    }
+
+    tableSrcWidth_ = srcWidth;
+    tableDstWidth_ = dstWidth;
+}
+
+void YuvConverter::convertRow(const unsigned char *y, const unsigned char *u, const unsigned char *v, const PixelLayout &layout, void *dst, int count)
+{
+    int i = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero    = _mm_setzero_si128();
+    const __m128i yOffset = _mm_set1_epi16(16);
+    const __m128i cOffset = _mm_set1_epi16(128);
+    const __m128i round   = _mm_set1_epi32(128);
+    const __m128i coefR   = _mm_set_epi16(409, 298, 409, 298, 409, 298, 409, 298);
+    const __m128i coefG   = _mm_set_epi16(-100, 298, -100, 298, -100, 298, -100, 298);
+    const __m128i coefGv  = _mm_set_epi16(0, -208, 0, -208, 0, -208, 0, -208);
+    const __m128i coefB   = _mm_set_epi16(516, 298, 516, 298, 516, 298, 516, 298);
+    const __m128i rLoss   = _mm_cvtsi32_si128(layout.rLoss);
+    const __m128i gLoss   = _mm_cvtsi32_si128(layout.gLoss);
+    const __m128i bLoss   = _mm_cvtsi32_si128(layout.bLoss);
+    const __m128i rShift  = _mm_cvtsi32_si128(layout.rShift);
+    const __m128i gShift  = _mm_cvtsi32_si128(layout.gShift);
+    const __m128i bShift  = _mm_cvtsi32_si128(layout.bShift);
+    const __m128i aMask   = _mm_set1_epi32(static_cast<int>(layout.aMask));
+    const __m128i bias16  = _mm_set1_epi32(0x8000);
+    const __m128i unbias16 = _mm_set1_epi16(static_cast<short>(0x8000));
+
+    for(; i + 8 <= count; i += 8)
+    {
+        __m128i c = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(y + i)), zero), yOffset);
+        __m128i d = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(u + i)), zero), cOffset);
+        __m128i e = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(v + i)), zero), cOffset);
+
+        __m128i ceLo = _mm_unpacklo_epi16(c, e);
+        __m128i ceHi = _mm_unpackhi_epi16(c, e);
+        __m128i cdLo = _mm_unpacklo_epi16(c, d);
+        __m128i cdHi = _mm_unpackhi_epi16(c, d);
+        __m128i eLo  = _mm_unpacklo_epi16(e, zero);
+        __m128i eHi  = _mm_unpackhi_epi16(e, zero);
+
+        __m128i rLo = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(ceLo, coefR), round), 8);
+        __m128i rHi = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(ceHi, coefR), round), 8);
+        __m128i gLo = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(cdLo, coefG), _mm_madd_epi16(eLo, coefGv)), round), 8);
+        __m128i gHi = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(cdHi, coefG), _mm_madd_epi16(eHi, coefGv)), round), 8);
+        __m128i bLo = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(cdLo, coefB), round), 8);
+        __m128i bHi = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(cdHi, coefB), round), 8);
+
+        // saturate to 0..255 and widen back to 32 bit lanes
+        __m128i r = _mm_unpacklo_epi8(_mm_packus_epi16(_mm_packs_epi32(rLo, rHi), zero), zero);
+        __m128i g = _mm_unpacklo_epi8(_mm_packus_epi16(_mm_packs_epi32(gLo, gHi), zero), zero);
+        __m128i b = _mm_unpacklo_epi8(_mm_packus_epi16(_mm_packs_epi32(bLo, bHi), zero), zero);
+
+        __m128i pixelLo = _mm_or_si128(aMask, _mm_or_si128(
+                              _mm_sll_epi32(_mm_srl_epi32(_mm_unpacklo_epi16(r, zero), rLoss), rShift),
+                              _mm_or_si128(_mm_sll_epi32(_mm_srl_epi32(_mm_unpacklo_epi16(g, zero), gLoss), gShift),
+                                           _mm_sll_epi32(_mm_srl_epi32(_mm_unpacklo_epi16(b, zero), bLoss), bShift))));
+        __m128i pixelHi = _mm_or_si128(aMask, _mm_or_si128(
+                              _mm_sll_epi32(_mm_srl_epi32(_mm_unpackhi_epi16(r, zero), rLoss), rShift),
+                              _mm_or_si128(_mm_sll_epi32(_mm_srl_epi32(_mm_unpackhi_epi16(g, zero), gLoss), gShift),
+                                           _mm_sll_epi32(_mm_srl_epi32(_mm_unpackhi_epi16(b, zero), bLoss), bShift))));
+
+        if(layout.bytesPerPixel == 4)
+        {
+            __m128i *out = reinterpret_cast<__m128i *>(static_cast<unsigned int *>(dst) + i);
+            _mm_storeu_si128(out, pixelLo);
+            _mm_storeu_si128(out + 1, pixelHi);
+        }
+        else
+        {
+            // packs_epi32 is signed, so move the 16 bit pixels into signed range and back
+            __m128i packed = _mm_packs_epi32(_mm_sub_epi32(pixelLo, bias16), _mm_sub_epi32(pixelHi, bias16));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(static_cast<unsigned short *>(dst) + i), _mm_add_epi16(packed, unbias16));
+        }
+    }
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    const int32x4_t rLoss  = vdupq_n_s32(-static_cast<int>(layout.rLoss));
+    const int32x4_t gLoss  = vdupq_n_s32(-static_cast<int>(layout.gLoss));
+    const int32x4_t bLoss  = vdupq_n_s32(-static_cast<int>(layout.bLoss));
+    const int32x4_t rShift = vdupq_n_s32(static_cast<int>(layout.rShift));
+    const int32x4_t gShift = vdupq_n_s32(static_cast<int>(layout.gShift));
+    const int32x4_t bShift = vdupq_n_s32(static_cast<int>(layout.bShift));
+    const uint32x4_t aMask = vdupq_n_u32(layout.aMask);
+
+    for(; i + 8 <= count; i += 8)
+    {
+        int16x8_t c = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(y + i), vdup_n_u8(16)));
+        int16x8_t d = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(u + i), vdup_n_u8(128)));
+        int16x8_t e = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(v + i), vdup_n_u8(128)));
+
+        int32x4_t cLo = vmull_n_s16(vget_low_s16(c), 298);
+        int32x4_t cHi = vmull_n_s16(vget_high_s16(c), 298);
+
+        int32x4_t rLo = vmlal_n_s16(cLo, vget_low_s16(e), 409);
+        int32x4_t rHi = vmlal_n_s16(cHi, vget_high_s16(e), 409);
+        int32x4_t gLo = vmlal_n_s16(vmlal_n_s16(cLo, vget_low_s16(d), -100), vget_low_s16(e), -208);
+        int32x4_t gHi = vmlal_n_s16(vmlal_n_s16(cHi, vget_high_s16(d), -100), vget_high_s16(e), -208);
+        int32x4_t bLo = vmlal_n_s16(cLo, vget_low_s16(d), 516);
+        int32x4_t bHi = vmlal_n_s16(cHi, vget_high_s16(d), 516);
+
+        // rounding shift, then saturate to 0..255
+        uint16x8_t r = vmovl_u8(vqmovun_s16(vcombine_s16(vqrshrn_n_s32(rLo, 8), vqrshrn_n_s32(rHi, 8))));
+        uint16x8_t g = vmovl_u8(vqmovun_s16(vcombine_s16(vqrshrn_n_s32(gLo, 8), vqrshrn_n_s32(gHi, 8))));
+        uint16x8_t b = vmovl_u8(vqmovun_s16(vcombine_s16(vqrshrn_n_s32(bLo, 8), vqrshrn_n_s32(bHi, 8))));
+
+        uint32x4_t pixelLo = vorrq_u32(aMask, vorrq_u32(
+                                 vshlq_u32(vshlq_u32(vmovl_u16(vget_low_u16(r)), rLoss), rShift),
+                                 vorrq_u32(vshlq_u32(vshlq_u32(vmovl_u16(vget_low_u16(g)), gLoss), gShift),
+                                           vshlq_u32(vshlq_u32(vmovl_u16(vget_low_u16(b)), bLoss), bShift))));
+        uint32x4_t pixelHi = vorrq_u32(aMask, vorrq_u32(
+                                 vshlq_u32(vshlq_u32(vmovl_u16(vget_high_u16(r)), rLoss), rShift),
+                                 vorrq_u32(vshlq_u32(vshlq_u32(vmovl_u16(vget_high_u16(g)), gLoss), gShift),
+                                           vshlq_u32(vshlq_u32(vmovl_u16(vget_high_u16(b)), bLoss), bShift))));
+
+        if(layout.bytesPerPixel == 4)
+        {
+            unsigned int *out = static_cast<unsigned int *>(dst) + i;
+            vst1q_u32(out, pixelLo);
+            vst1q_u32(out + 4, pixelHi);
+        }
+        else
+        {
+            vst1q_u16(static_cast<unsigned short *>(dst) + i, vcombine_u16(vmovn_u32(pixelLo), vmovn_u32(pixelHi)));
+        }
+    }
+#endif
+
+    convertRowScalar(y, u, v, layout, dst, i, count - i);
+}
+
+void YuvConverter::convertRowScalar(const unsigned char *y, const unsigned char *u, const unsigned char *v, const PixelLayout &layout, void *dst, int start, int count)
+{
+    for(int i = start; i < start + count; ++i)
+    {
+        int c = y[i] - 16;
+        int d = u[i] - 128;
+        int e = v[i] - 128;
+
+        unsigned int r = static_cast<unsigned int>(clampByte((298 * c + 409 * e + 128) >> 8));
+        unsigned int g = static_cast<unsigned int>(clampByte((298 * c - 100 * d - 208 * e + 128) >> 8));
+        unsigned int b = static_cast<unsigned int>(clampByte((298 * c + 516 * d + 128) >> 8));
+
+        unsigned int pixel = layout.aMask
+                           | ((r >> layout.rLoss) << layout.rShift)
+                           | ((g >> layout.gLoss) << layout.gShift)
+                           | ((b >> layout.bLoss) << layout.bShift);
+
+        if(layout.bytesPerPixel == 4)
+        {
+            static_cast<unsigned int *>(dst)[i] = pixel;
+        }
+        else
+        {
+            static_cast<unsigned short *>(dst)[i] = static_cast<unsigned short>(pixel);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+/* This file is part of RetroFE.
+ *
+ * RetroFE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RetroFE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with RetroFE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <vector>
+
+// Converts decoded I420 (BT.601, limited range) video frames to a packed
+// 16 or 32 bpp RGB surface. Scaling is fused into the conversion: every
+// destination row is sampled from the source planes (nearest neighbour) into
+// line buffers which are then run through the colour space kernel, so no
+// full size intermediate frame is ever produced.
+class YuvConverter
+{
+public:
+    struct PixelLayout
+    {
+        int          bytesPerPixel;
+        unsigned int rShift;
+        unsigned int gShift;
+        unsigned int bShift;
+        unsigned int rLoss;
+        unsigned int gLoss;
+        unsigned int bLoss;
+        unsigned int aMask;
+    };
+
+    struct Planes
+    {
+        const unsigned char *y;
+        const unsigned char *u;
+        const unsigned char *v;
+        int                  yStride;
+        int                  uStride;
+        int                  vStride;
+        int                  width;
+        int                  height;
+    };
+
+    YuvConverter();
+    bool convert(const Planes &src, const PixelLayout &layout, void *dst, int dstPitch, int dstWidth, int dstHeight);
+    static void convertRow(const unsigned char *y, const unsigned char *u, const unsigned char *v, const PixelLayout &layout, void *dst, int count);
+    static void convertRowScalar(const unsigned char *y, const unsigned char *u, const unsigned char *v, const PixelLayout &layout, void *dst, int start, int count);
+
+private:
+    void buildSampleTable(int srcWidth, int dstWidth);
+
+    std::vector<int>           sampleX_;
+    std::vector<unsigned char> lineY_;
+    std::vector<unsigned char> lineU_;
+    std::vector<unsigned char> lineV_;
+    int                        tableSrcWidth_;
+    int                        tableDstWidth_;
+};
@@ -0,0 +1,247 @@
+#include "Benchmark.h"
+#include <Utility/Log.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+Benchmark::State::State(uint64_t iterations)
+    : iterations_(iterations)
+    , remaining_(iterations)
+    , items_(0)
+    , started_(false)
+    , running_(false)
+    , cpuStart_(0)
+    , realSeconds_(0)
+    , cpuSeconds_(0)
+{
+}
+
+
+bool Benchmark::State::keepRunning()
+{
+    if(!started_)
+    {
+        started_ = true;
+        start();
+    }
+    if(remaining_ > 0)
+    {
+        remaining_--;
+        return true;
+    }
+    stop();
+    return false;
+}
+
+
+void Benchmark::State::pauseTiming()
+{
+    stop();
+}
+
+
+void Benchmark::State::resumeTiming()
+{
+    start();
+}
+
+
+void Benchmark::State::setItemsPerIteration(uint64_t items)
+{
+    items_ = items;
+}
+
+
+uint64_t Benchmark::State::iterations() const
+{
+    return iterations_;
+}
+
+
+void Benchmark::State::start()
+{
+    if(!running_)
+    {
+        running_   = true;
+        realStart_ = Clock::now();
+        cpuStart_  = std::clock();
+    }
+}
+
+
+void Benchmark::State::stop()
+{
+    if(running_)
+    {
+        running_ = false;
+        realSeconds_ += std::chrono::duration<double>(Clock::now() - realStart_).count();
+        cpuSeconds_  += static_cast<double>(std::clock() - cpuStart_) / CLOCKS_PER_SEC;
+    }
+}
+
+
+std::vector<Benchmark::Entry> &Benchmark::registry()
+{
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+
+int Benchmark::add(const char *name, Function function)
+{
+    Entry entry;
+    entry.name     = name;
+    entry.function = function;
+    registry().push_back(entry);
+    return static_cast<int>(registry().size());
+}
+
+
+// Grows the iteration count until one run lasts minTime, then reports the
+// median of the repetitions at that count
+Benchmark::Result Benchmark::measure(const Entry &entry, double minTime, int repetitions)
+{
+    uint64_t iterations = 1;
+    for(;;)
+    {
+        State state(iterations);
+        entry.function(state);
+        if(state.realSeconds_ >= minTime || iterations >= 1000000000ULL)
+        {
+            break;
+        }
+        double scale = (state.realSeconds_ > 0) ? minTime / state.realSeconds_ * 1.4 : 10;
+        iterations = static_cast<uint64_t>(iterations * std::min(std::max(scale, 2.0), 10.0));
+    }
+
+    std::vector<Result> runs;
+    for(int i = 0; i < repetitions; ++i)
+    {
+        State state(iterations);
+        entry.function(state);
+
+        Result run;
+        run.name           = entry.name;
+        run.iterations     = iterations;
+        run.realTime       = state.realSeconds_ * 1e9 / iterations;
+        run.cpuTime        = state.cpuSeconds_ * 1e9 / iterations;
+        run.itemsPerSecond = (state.items_ > 0 && state.realSeconds_ > 0) ? state.items_ * iterations / state.realSeconds_ : 0;
+        runs.push_back(run);
+    }
+
+    std::sort(runs.begin(), runs.end(), [](const Result &a, const Result &b) { return a.realTime < b.realTime; });
+    return runs[runs.size() / 2];
+}
+
+
+bool Benchmark::writeJson(const std::string &file, const char *executable, const std::vector<Result> &results)
+{
+    FILE *out = fopen(file.c_str(), "w");
+    if(!out)
+    {
+        fprintf(stderr, "Could not write %s\n", file.c_str());
+        return false;
+    }
+
+    char date[32];
+    time_t now = time(NULL);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+    fprintf(out, "{\n  \"context\": {\n");
+    fprintf(out, "    \"date\": \"%s\",\n", date);
+    fprintf(out, "    \"executable\": \"%s\",\n", executable);
+    fprintf(out, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+#ifdef NDEBUG
+    fprintf(out, "    \"library_build_type\": \"release\"\n");
+#else
+    fprintf(out, "    \"library_build_type\": \"debug\"\n");
+#endif
+    fprintf(out, "  },\n  \"benchmarks\": [\n");
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        const Result &r = results[i];
+        fprintf(out, "    {\n");
+        fprintf(out, "      \"name\": \"%s\",\n", r.name.c_str());
+        fprintf(out, "      \"iterations\": %llu,\n", static_cast<unsigned long long>(r.iterations));
+        fprintf(out, "      \"real_time\": %.3f,\n", r.realTime);
+        fprintf(out, "      \"cpu_time\": %.3f,\n", r.cpuTime);
+        fprintf(out, "      \"time_unit\": \"ns\"");
+        if(r.itemsPerSecond > 0)
+        {
+            fprintf(out, ",\n      \"items_per_second\": %.1f", r.itemsPerSecond);
+        }
+        fprintf(out, "\n    }%s\n", (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+
+    return fclose(out) == 0;
+}
+
+
+int Benchmark::main(int argc, char **argv)
+{
+    std::string filter;
+    std::string json;
+    double minTime = 0.5;
+    int repetitions = 3;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if(arg.compare(0, 9, "--filter=") == 0)
+        {
+            filter = arg.substr(9);
+        }
+        else if(arg.compare(0, 7, "--json=") == 0)
+        {
+            json = arg.substr(7);
+        }
+        else if(arg.compare(0, 11, "--min-time=") == 0)
+        {
+            minTime = atof(arg.c_str() + 11);
+        }
+        else if(arg.compare(0, 14, "--repetitions=") == 0)
+        {
+            repetitions = std::max(1, atoi(arg.c_str() + 14));
+        }
+        else
+        {
+            printf("Usage: %s [--filter=<substring>] [--json=<file>] [--min-time=<seconds>] [--repetitions=<n>]\n", argv[0]);
+            return (arg == "--help") ? 0 : 1;
+        }
+    }
+
+    // keep fixture chatter out of the results table
+    Logger::setZones("WARNING,ERROR");
+
+    std::vector<Result> results;
+    printf("%-40s %14s %14s %12s %16s\n", "Benchmark", "Time (ns)", "CPU (ns)", "Iterations", "Items/s");
+    for(size_t i = 0; i < registry().size(); ++i)
+    {
+        const Entry &entry = registry()[i];
+        if(!filter.empty() && entry.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        Result r = measure(entry, minTime, repetitions);
+        printf("%-40s %14.0f %14.0f %12llu %16.0f\n", r.name.c_str(), r.realTime, r.cpuTime,
+               static_cast<unsigned long long>(r.iterations), r.itemsPerSecond);
+        fflush(stdout);
+        results.push_back(r);
+    }
+
+    if(!json.empty() && !writeJson(json, argv[0], results))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+
+int main(int argc, char **argv)
+{
+    return Benchmark::main(argc, argv);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <ctime>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Minimal in-tree microbenchmark harness. Each benchmark times the body of
+// its keepRunning() loop; setup before the loop is not timed. Results are
+// printed as a table and optionally written as JSON in the layout used by
+// Google Benchmark, so Scripts/CompareBenchmarks.py (or Google's own tools)
+// can compare two runs.
+class Benchmark
+{
+public:
+    class State
+    {
+    public:
+        bool keepRunning();
+        void pauseTiming();
+        void resumeTiming();
+        void setItemsPerIteration(uint64_t items);
+        uint64_t iterations() const;
+
+    private:
+        friend class Benchmark;
+        typedef std::chrono::steady_clock Clock;
+
+        State(uint64_t iterations);
+        void start();
+        void stop();
+
+        uint64_t          iterations_;
+        uint64_t          remaining_;
+        uint64_t          items_;
+        bool              started_;
+        bool              running_;
+        Clock::time_point realStart_;
+        std::clock_t      cpuStart_;
+        double            realSeconds_;
+        double            cpuSeconds_;
+    };
+
+    typedef void (*Function)(State &state);
+
+    static int add(const char *name, Function function);
+    static int main(int argc, char **argv);
+
+private:
+    struct Result
+    {
+        std::string name;
+        uint64_t    iterations;
+        double      realTime;
+        double      cpuTime;
+        double      itemsPerSecond;
+    };
+
+    struct Entry
+    {
+        std::string name;
+        Function    function;
+    };
+
+    static std::vector<Entry> &registry();
+    static Result measure(const Entry &entry, double minTime, int repetitions);
+    static bool writeJson(const std::string &file, const char *executable, const std::vector<Result> &results);
+};
+
+#define RETROFE_BENCHMARK(name) \
+    static void name(Benchmark::State &state); \
+    static const int name##Registration = Benchmark::add(#name, name); \
+    static void name(Benchmark::State &state)
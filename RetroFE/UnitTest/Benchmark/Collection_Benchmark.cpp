@@ -0,0 +1,166 @@
+#include "Benchmark.h"
+#include <Collection/CollectionInfo.h>
+#include <Collection/Item.h>
+#include <Database/Configuration.h>
+#include <Database/DB.h>
+#include <Database/MetadataDatabase.h>
+#include <Utility/Utils.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+    const int ITEMS = 20000;
+
+    std::string gameName(int i)
+    {
+        char name[16];
+        snprintf(name, sizeof(name), "game%05d", i);
+        return name;
+    }
+
+    std::string gameTitle(int i)
+    {
+        static const char *words[] = { "Super", "Street", "Final", "Galaxy", "Metal", "Dragon", "Puzzle", "Racing", "Ninja", "Space" };
+        std::stringstream title;
+        title << words[(i * 7) % 10] << " " << words[(i * 3 + 1) % 10] << " " << (i % 97) << " (Rev " << (i % 5) << ")";
+        return title.str();
+    }
+
+    // A synthetic 20k item collection, shuffled so sorting has work to do
+    CollectionInfo *makeCollection()
+    {
+        CollectionInfo *collection = new CollectionInfo("Bench", "", "zip", "Bench", "");
+        for(int i = 0; i < ITEMS; ++i)
+        {
+            Item *item = new Item();
+            item->name           = gameName(i);
+            item->title          = gameTitle(i);
+            item->fullTitle      = item->title;
+            item->collectionInfo = collection;
+            item->leaf           = true;
+            collection->items.push_back(item);
+        }
+        std::mt19937 random(11);
+        std::shuffle(collection->items.begin(), collection->items.end(), random);
+        collection->playlists["all"] = &collection->items;
+        return collection;
+    }
+
+    // A generated hyperlist covering every item of the collection
+    std::string makeHyperlist(const std::string &dir)
+    {
+        std::string file = Utils::combinePath(dir, "Bench.xml");
+        std::ofstream out(file.c_str());
+
+        out << "<?xml version=\"1.0\"?>\n<menu>\n";
+        for(int i = 0; i < ITEMS; ++i)
+        {
+            out << "  <game name=\"" << gameName(i) << "\" index=\"\" image=\"\">\n"
+                << "    <description>" << gameTitle(i) << "</description>\n"
+                << "    <cloneof></cloneof>\n"
+                << "    <crc>" << std::hex << (i * 2654435761u) << std::dec << "</crc>\n"
+                << "    <manufacturer>Maker " << (i % 40) << "</manufacturer>\n"
+                << "    <year>" << (1978 + i % 30) << "</year>\n"
+                << "    <genre>Genre " << (i % 25) << "</genre>\n"
+                << "    <rating>" << (i % 5) << "</rating>\n"
+                << "    <enabled>Yes</enabled>\n"
+                << "  </game>\n";
+        }
+        out << "</menu>\n";
+
+        return file;
+    }
+
+    // Metadata database in a scratch directory, so no real meta files are
+    // scanned. It is built once and shared by the metadata benchmarks.
+    struct MetadataFixture
+    {
+        MetadataFixture()
+        {
+            char path[] = "/tmp/retrofebenchXXXXXX";
+            dir = mkdtemp(path) ? path : "/tmp";
+            Configuration::absolutePath = dir;
+            hyperlist = makeHyperlist(dir);
+            db = new DB(Utils::combinePath(dir, "meta.db"));
+            db->initialize();
+            metadb = new MetadataDatabase(*db, config);
+            metadb->initialize();
+        }
+
+        ~MetadataFixture()
+        {
+            delete metadb;
+            delete db;
+            remove(hyperlist.c_str());
+            remove(Utils::combinePath(dir, "meta.db").c_str());
+            rmdir(dir.c_str());
+        }
+
+        std::string       dir;
+        std::string       hyperlist;
+        Configuration     config;
+        DB               *db;
+        MetadataDatabase *metadb;
+    };
+
+    MetadataFixture &metadataFixture()
+    {
+        static MetadataFixture fixture;
+        return fixture;
+    }
+}
+
+
+RETROFE_BENCHMARK(CollectionInfoSortItems)
+{
+    CollectionInfo *collection = makeCollection();
+    std::vector<Item *> shuffled = collection->items;
+
+    state.setItemsPerIteration(ITEMS);
+    while(state.keepRunning())
+    {
+        state.pauseTiming();
+        collection->items = shuffled;
+        state.resumeTiming();
+
+        collection->sortItems();
+    }
+
+    delete collection;
+}
+
+
+RETROFE_BENCHMARK(MetadataDatabaseImportHyperlist)
+{
+    MetadataFixture &fixture = metadataFixture();
+
+    state.setItemsPerIteration(ITEMS);
+    while(state.keepRunning())
+    {
+        fixture.metadb->importHyperlist(fixture.hyperlist, "Bench");
+    }
+}
+
+
+RETROFE_BENCHMARK(MetadataDatabaseInjectMetadata)
+{
+    MetadataFixture &fixture = metadataFixture();
+    CollectionInfo *collection = makeCollection();
+    fixture.metadb->importHyperlist(fixture.hyperlist, "Bench");
+
+    state.setItemsPerIteration(ITEMS);
+    while(state.keepRunning())
+    {
+        fixture.metadb->injectMetadata(collection);
+    }
+
+    delete collection;
+}
@@ -0,0 +1,154 @@
+#include "Benchmark.h"
+#include "../../Source/SDL.h"
+#include <Database/Configuration.h>
+#include <Graphics/ViewInfo.h>
+#include <cstdlib>
+
+namespace
+{
+    const int WIDTH  = 320;
+    const int HEIGHT = 240;
+
+    // SDL is brought up once, headless, with the window size of the device
+    bool initializeSdl()
+    {
+        static bool initialized = false;
+        static bool ok = false;
+
+        if(!initialized)
+        {
+            static Configuration config;
+            config.setProperty("headless", "yes");
+            config.setProperty("horizontal", "320");
+            config.setProperty("vertical", "240");
+            config.setProperty("fullscreen", "no");
+            config.setProperty("showFrame", "yes");
+            config.setProperty("artworkMips", "no");
+            initialized = true;
+            ok = SDL::initialize(config);
+        }
+        return ok;
+    }
+
+    // Noise with a soft alpha ramp, so blending takes every path
+    SDL_Surface *makeSurface(int width, int height, bool alpha)
+    {
+        SDL_Surface *surface = SDL_CreateRGBSurface(SDL_SWSURFACE, width, height, 32,
+                                                    0x00ff0000, 0x0000ff00, 0x000000ff, alpha ? 0xff000000 : 0);
+        srand(5);
+        Uint32 *pixels = static_cast<Uint32 *>(surface->pixels);
+        for(int y = 0; y < height; ++y)
+        {
+            for(int x = 0; x < width; ++x)
+            {
+                Uint32 a = alpha ? static_cast<Uint32>(x * 255 / width) : 0xff;
+                pixels[y * surface->pitch / 4 + x] = (a << 24) | (static_cast<Uint32>(rand()) & 0x00ffffff);
+            }
+        }
+        return surface;
+    }
+
+    // angleStep turns the image further on every draw, defeating the rotation cache
+    void renderCopyBenchmark(Benchmark::State &state, int textureSize, int drawSize, float alpha,
+                             float angle = 0, float angleStep = 0)
+    {
+        if(!initializeSdl())
+        {
+            return;
+        }
+        SDL_Surface *texture = makeSurface(textureSize, textureSize, true);
+        ViewInfo viewInfo;
+        SDL_Rect dest = { 40, 0, static_cast<Uint16>(drawSize), static_cast<Uint16>(drawSize) };
+
+        viewInfo.Angle = angle;
+        state.setItemsPerIteration(drawSize * drawSize);
+        while(state.keepRunning())
+        {
+            SDL::renderCopy(texture, alpha, NULL, &dest, viewInfo);
+            viewInfo.Angle += angleStep;
+        }
+        SDL_FreeSurface(texture);
+    }
+}
+
+
+RETROFE_BENCHMARK(SDLRotate270)
+{
+    SDL_Surface *src = makeSurface(WIDTH, HEIGHT, false);
+    SDL_Surface *dst = makeSurface(WIDTH, HEIGHT, false);
+
+    state.setItemsPerIteration(WIDTH * HEIGHT);
+    while(state.keepRunning())
+    {
+        SDL::SDL_Rotate_270(src, dst);
+    }
+
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(dst);
+}
+
+
+RETROFE_BENCHMARK(SDLDitherSurface32bppTo16Bpp)
+{
+    SDL_Surface *source  = makeSurface(WIDTH, HEIGHT, false);
+    SDL_Surface *surface = makeSurface(WIDTH, HEIGHT, false);
+
+    state.setItemsPerIteration(WIDTH * HEIGHT);
+    while(state.keepRunning())
+    {
+        state.pauseTiming();
+        SDL_BlitSurface(source, NULL, surface, NULL);
+        state.resumeTiming();
+
+        SDL::ditherSurface32bppTo16Bpp(surface);
+    }
+
+    SDL_FreeSurface(source);
+    SDL_FreeSurface(surface);
+}
+
+
+RETROFE_BENCHMARK(SDLZoomSurface)
+{
+    SDL_Surface *source = makeSurface(512, 512, true);
+    SDL_Rect dest = { 0, 0, 150, 150 };
+
+    state.setItemsPerIteration(150 * 150);
+    while(state.keepRunning())
+    {
+        SDL_Surface *zoomed = SDL::zoomSurface(source, NULL, &dest, NULL);
+        SDL_FreeSurface(zoomed);
+    }
+
+    SDL_FreeSurface(source);
+}
+
+
+RETROFE_BENCHMARK(SDLRenderCopyOpaque)
+{
+    renderCopyBenchmark(state, 240, 240, 1.0f);
+}
+
+
+RETROFE_BENCHMARK(SDLRenderCopyTranslucent)
+{
+    renderCopyBenchmark(state, 240, 240, 0.5f);
+}
+
+
+RETROFE_BENCHMARK(SDLRenderCopyScaled)
+{
+    renderCopyBenchmark(state, 512, 150, 1.0f);
+}
+
+
+RETROFE_BENCHMARK(SDLRenderCopyRotated)
+{
+    renderCopyBenchmark(state, 512, 150, 1.0f, 12.0f);
+}
+
+
+RETROFE_BENCHMARK(SDLRenderCopyRotating)
+{
+    renderCopyBenchmark(state, 512, 150, 1.0f, 12.0f, 1.0f);
+}
@@ -0,0 +1,110 @@
+#include "Benchmark.h"
+#include <Graphics/MipChain.h>
+#include <Graphics/Resampler.h>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    const int SourceSize = 1024;
+
+    // A SourceSize square of noise, the worst case for the filters
+    struct Source
+    {
+        Source()
+            : pixels(SourceSize * SourceSize)
+            , out(512 * 512)
+        {
+            for(unsigned int i = 0; i < pixels.size(); ++i)
+            {
+                pixels[i] = (static_cast<uint32_t>(rand() & 0xffff) << 16) | static_cast<uint32_t>(rand() & 0xffff);
+            }
+            image.pixels = &pixels[0];
+            image.pitch  = SourceSize * 4;
+            image.width  = SourceSize;
+            image.height = SourceSize;
+        }
+
+        std::vector<uint32_t> pixels;
+        std::vector<uint32_t> out;
+        Resampler::Image      image;
+    };
+
+    // Point sampling, as SDL::zoomSurface did before filtering
+    void nearest(const Resampler::Image &src, int width, int height, uint32_t *dst)
+    {
+        int xRatio = (src.width << 16) / width;
+        int yRatio = (src.height << 16) / height;
+        for(int y = 0; y < height; ++y)
+        {
+            const uint32_t *row = src.pixels + ((y * yRatio) >> 16) * (src.pitch / 4);
+            for(int x = 0; x < width; ++x)
+            {
+                dst[y * width + x] = row[(x * xRatio) >> 16];
+            }
+        }
+    }
+}
+
+
+// Items are source pixels, so the rates compare directly
+RETROFE_BENCHMARK(ResampleNearestTo240)
+{
+    Source source;
+    state.setItemsPerIteration(SourceSize * SourceSize);
+    while(state.keepRunning())
+    {
+        nearest(source.image, 240, 240, &source.out[0]);
+    }
+}
+
+
+RETROFE_BENCHMARK(ResampleBoxScalarTo240)
+{
+    Source source;
+    state.setItemsPerIteration(SourceSize * SourceSize);
+    while(state.keepRunning())
+    {
+        Resampler::scaleScalar(source.image, 240, 240, &source.out[0], 240 * 4, 0, 0, 240, 240);
+    }
+}
+
+
+RETROFE_BENCHMARK(ResampleBoxTo240)
+{
+    Source source;
+    state.setItemsPerIteration(SourceSize * SourceSize);
+    while(state.keepRunning())
+    {
+        Resampler::scale(source.image, 240, 240, &source.out[0], 240 * 4, 0, 0, 240, 240);
+    }
+}
+
+
+RETROFE_BENCHMARK(ResampleHalving)
+{
+    Source source;
+    state.setItemsPerIteration(SourceSize * SourceSize);
+    while(state.keepRunning())
+    {
+        Resampler::scale(source.image, 512, 512, &source.out[0], 512 * 4, 0, 0, 512, 512);
+    }
+}
+
+
+RETROFE_BENCHMARK(ResampleFromMipTo240)
+{
+    Source source;
+    MipChain mips;
+    mips.build(source.image, 256);
+    MipChain::wait();
+    Resampler::Image mip = mips.nearest(240, 240);
+
+    state.setItemsPerIteration(SourceSize * SourceSize);
+    while(state.keepRunning())
+    {
+        Resampler::scale(mip, 240, 240, &source.out[0], 240 * 4, 0, 0, 240, 240);
+    }
+    mips.reset();
+    MipChain::shutdown();
+}
@@ -0,0 +1,105 @@
+#include "Benchmark.h"
+#include <Database/Configuration.h>
+#include <Utility/Utils.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+    // A configuration shaped like a full install: per collection media and
+    // list settings plus the global settings.conf keys
+    void makeConfiguration(Configuration &config, std::vector<std::string> &keys)
+    {
+        static const char *media[] = { "artwork_front", "artwork_back", "logo", "screenshot", "video" };
+
+        for(int c = 0; c < 200; ++c)
+        {
+            std::stringstream collection;
+            collection << "collections.Collection" << c;
+            config.setProperty(collection.str() + ".list.path", "%BASE_ITEM_PATH%/Collection/roms");
+            config.setProperty(collection.str() + ".list.extensions", "zip,7z,bin");
+            for(int m = 0; m < 5; ++m)
+            {
+                std::string key = collection.str() + ".media." + media[m];
+                config.setProperty(key, "%BASE_MEDIA_PATH%/Collection/" + std::string(media[m]));
+                if(c % 10 == 0)
+                {
+                    keys.push_back(key);
+                }
+            }
+        }
+        config.setProperty("horizontal", "320");
+        config.setProperty("fullscreen", "yes");
+        keys.push_back("horizontal");
+        keys.push_back("fullscreen");
+        keys.push_back("missingProperty");
+    }
+
+    std::string makeTempDir()
+    {
+        char path[] = "/tmp/retrofebenchXXXXXX";
+        return mkdtemp(path) ? std::string(path) : std::string();
+    }
+}
+
+
+RETROFE_BENCHMARK(ConfigurationGetProperty)
+{
+    Configuration config;
+    std::vector<std::string> keys;
+    makeConfiguration(config, keys);
+
+    std::string value;
+    state.setItemsPerIteration(keys.size());
+    while(state.keepRunning())
+    {
+        for(size_t i = 0; i < keys.size(); ++i)
+        {
+            config.getProperty(keys[i], value);
+        }
+    }
+}
+
+
+RETROFE_BENCHMARK(UtilsFindMatchingFile)
+{
+    std::string dir = makeTempDir();
+    std::vector<std::string> prefixes;
+    for(int i = 0; i < 200; ++i)
+    {
+        std::stringstream name;
+        name << "game" << i;
+        prefixes.push_back(Utils::combinePath(dir, name.str()));
+        // a third of the artwork is missing, the rest is found on the last extension tried
+        if(i % 3 != 0)
+        {
+            std::ofstream(prefixes.back() + ".jpg").put('x');
+        }
+    }
+
+    std::vector<std::string> extensions;
+    extensions.push_back("png");
+    extensions.push_back("PNG");
+    extensions.push_back("jpg");
+
+    std::string file;
+    state.setItemsPerIteration(prefixes.size());
+    while(state.keepRunning())
+    {
+        for(size_t i = 0; i < prefixes.size(); ++i)
+        {
+            Utils::findMatchingFile(prefixes[i], extensions, file);
+        }
+    }
+
+    for(size_t i = 0; i < prefixes.size(); ++i)
+    {
+        remove((prefixes[i] + ".jpg").c_str());
+    }
+    rmdir(dir.c_str());
+}
@@ -0,0 +1,167 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Collection/JumpIndex.h>
+#include <Collection/Item.h>
+#include <cctype>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+class JumpIndexTest : public ::testing::Test
+{
+protected:
+    std::vector<Item *> items;
+
+    virtual void TearDown()
+    {
+        for(unsigned int i = 0; i < items.size(); ++i)
+        {
+            delete items[i];
+        }
+        items.clear();
+    }
+
+    void setTitles(const std::vector<std::string> &titles)
+    {
+        TearDown();
+        for(unsigned int i = 0; i < titles.size(); ++i)
+        {
+            Item *item = new Item();
+            item->fullTitle = titles[i];
+            items.push_back(item);
+        }
+    }
+
+    // The linear walk ScrollingList::letterChange used before the index.
+    unsigned int walk(unsigned int position, bool increment)
+    {
+        unsigned int size = items.size();
+        unsigned int result = position;
+        std::string startname = items[position]->lowercaseFullTitle();
+
+        for(unsigned int i = 0; i < size; ++i)
+        {
+            unsigned int index = increment ? (position + i) % size : (position + size - i) % size;
+            std::string endname = items[index]->lowercaseFullTitle();
+            if((isalpha(startname[0]) ^ isalpha(endname[0])) ||
+               (isalpha(startname[0]) && isalpha(endname[0]) && startname[0] != endname[0]))
+            {
+                result = index;
+                break;
+            }
+        }
+
+        if(!increment)
+        {
+            startname = items[result]->lowercaseFullTitle();
+            for(unsigned int i = 0; i < size; ++i)
+            {
+                unsigned int index = (result + size - i) % size;
+                std::string endname = items[index]->lowercaseFullTitle();
+                if((isalpha(startname[0]) ^ isalpha(endname[0])) ||
+                   (isalpha(startname[0]) && isalpha(endname[0]) && startname[0] != endname[0]))
+                {
+                    result = (index + 1) % size;
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    void expectSameAsWalk()
+    {
+        JumpIndex index;
+        index.build(items);
+        for(unsigned int position = 0; position < items.size(); ++position)
+        {
+            ASSERT_EQ(walk(position, true), index.next(position)) << "next from " << position;
+            ASSERT_EQ(walk(position, false), index.previous(position)) << "previous from " << position;
+        }
+    }
+};
+
+TEST_F(JumpIndexTest, JumpsBetweenLetters)
+{
+    const char *titles[] = { "1942", "Aliens", "asteroids", "Bomb Jack", "Bubble Bobble", "Contra" };
+    setTitles(std::vector<std::string>(titles, titles + 6));
+
+    JumpIndex index;
+    index.build(items);
+    ASSERT_EQ(4u, index.groups());
+    ASSERT_EQ(3u, index.next(1));
+    ASSERT_EQ(3u, index.next(2));
+    ASSERT_EQ(0u, index.next(5));
+    ASSERT_EQ(1u, index.previous(4));
+    ASSERT_EQ(3u, index.previous(5));
+    ASSERT_EQ(5u, index.previous(0));
+}
+
+TEST_F(JumpIndexTest, GroupSplitOverTheEndWraps)
+{
+    const char *titles[] = { "Zaxxon", "1942", "Asteroids", "Zoo Keeper", "Zookeeper" };
+    setTitles(std::vector<std::string>(titles, titles + 5));
+
+    JumpIndex index;
+    index.build(items);
+    ASSERT_EQ(3u, index.groups());
+    ASSERT_EQ(1u, index.next(0));
+    ASSERT_EQ(1u, index.next(4));
+    ASSERT_EQ(3u, index.next(2));
+    ASSERT_EQ(3u, index.previous(1));
+    expectSameAsWalk();
+}
+
+TEST_F(JumpIndexTest, SingleGroupDoesNotMove)
+{
+    const char *titles[] = { "Galaga", "galaxian", "Gauntlet" };
+    setTitles(std::vector<std::string>(titles, titles + 3));
+
+    JumpIndex index;
+    index.build(items);
+    ASSERT_EQ(1u, index.groups());
+    ASSERT_EQ(1u, index.next(1));
+    ASSERT_EQ(2u, index.previous(2));
+}
+
+TEST_F(JumpIndexTest, MatchesLinearWalk)
+{
+    const char *alphabet[] = { "a", "B", "b", "c", "1", "#", "", "z" };
+    srand(42);
+
+    for(int run = 0; run < 200; ++run)
+    {
+        std::vector<std::string> titles;
+        unsigned int size = 1 + rand() % 12;
+        for(unsigned int i = 0; i < size; ++i)
+        {
+            titles.push_back(std::string(alphabet[rand() % 8]) + "title");
+        }
+        setTitles(titles);
+        expectSameAsWalk();
+    }
+}
+
+TEST_F(JumpIndexTest, JumpsBetweenYears)
+{
+    const char *years[] = { "1980", "1980", "1981", "1984", "1984" };
+    setTitles(std::vector<std::string>(5, "game"));
+    for(unsigned int i = 0; i < items.size(); ++i)
+    {
+        items[i]->year = years[i];
+    }
+
+    JumpIndex index;
+    ASSERT_FALSE(index.isBuilt(&items, JumpIndex::YEAR));
+    index.build(items, JumpIndex::YEAR);
+    ASSERT_TRUE(index.isBuilt(&items, JumpIndex::YEAR));
+    ASSERT_FALSE(index.isBuilt(&items, JumpIndex::LETTER));
+    ASSERT_EQ(3u, index.groups());
+    ASSERT_EQ(2u, index.next(1));
+    ASSERT_EQ(3u, index.next(2));
+    ASSERT_EQ(0u, index.next(4));
+
+    items.push_back(new Item());
+    ASSERT_FALSE(index.isBuilt(&items, JumpIndex::YEAR));
+}
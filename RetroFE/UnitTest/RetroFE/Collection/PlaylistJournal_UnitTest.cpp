@@ -0,0 +1,267 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Collection/PlaylistJournal.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+// Tears every write in two and exits the process at the given step, where a
+// step ends at each half of a write and at each checkpoint.
+class CrashingJournal : public PlaylistJournal
+{
+public:
+    static const int FAULT_EXIT_CODE = 86;
+
+    CrashingJournal(std::string file, int faultStep)
+        : PlaylistJournal(file, false)
+        , countdown_(faultStep)
+    {
+    }
+
+    virtual ~CrashingJournal()
+    {
+        // the writer must not call the overrides once they are gone
+        wait();
+    }
+
+protected:
+    virtual bool writeData(int fd, const std::string &data)
+    {
+        std::size_t half = data.size() / 2;
+        bool retVal = writeAll(fd, data.substr(0, half));
+        checkpoint();
+        return retVal && writeAll(fd, data.substr(half));
+    }
+
+    virtual void checkpoint()
+    {
+        if(countdown_ > 0 && --countdown_ == 0)
+        {
+            _exit(FAULT_EXIT_CODE);
+        }
+    }
+
+private:
+    int countdown_;
+};
+
+const int CrashingJournal::FAULT_EXIT_CODE;
+
+class PlaylistJournalTest : public ::testing::Test
+{
+protected:
+    typedef std::vector< std::pair<char, std::string> > Workload_T;
+
+    std::string dir;
+    std::string file;
+    Workload_T workload;
+
+    virtual void SetUp()
+    {
+        char path[] = "/tmp/retrofe_playlist_XXXXXX";
+        ASSERT_TRUE(mkdtemp(path) != NULL);
+        dir = path;
+        file = dir + "/favorites.txt";
+
+        for(int i = 0; i < 8; ++i)
+        {
+            std::stringstream ss;
+            ss << "game" << i;
+            workload.push_back(std::make_pair('+', ss.str()));
+        }
+        workload.push_back(std::make_pair('-', std::string("game2")));
+        workload.push_back(std::make_pair('+', std::string("_Arcade:game8")));
+        workload.push_back(std::make_pair('-', std::string("game0")));
+        workload.push_back(std::make_pair('+', std::string("game2")));
+    }
+
+    virtual void TearDown()
+    {
+        clean();
+        rmdir(dir.c_str());
+    }
+
+    void clean()
+    {
+        std::remove(file.c_str());
+        std::remove((file + ".tmp").c_str());
+        std::remove((file + ".journal").c_str());
+        std::remove((file + ".journal.compacting").c_str());
+        std::remove((file + ".journal.compacting.tmp").c_str());
+    }
+
+    void writeFile(const std::string &name, const std::string &data)
+    {
+        FILE *fp = fopen(name.c_str(), "w");
+        ASSERT_TRUE(fp != NULL);
+        fputs(data.c_str(), fp);
+        fclose(fp);
+    }
+
+    // Runs f in a child process, returning its exit code.
+    template <typename F>
+    int runInChild(F f)
+    {
+        pid_t pid = fork();
+        if(pid == 0)
+        {
+            f();
+            _exit(0);
+        }
+
+        int status = 0;
+        waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+
+    static void apply(const std::pair<char, std::string> &op, std::vector<std::string> &list)
+    {
+        std::vector<std::string>::iterator it = std::find(list.begin(), list.end(), op.second);
+        if(op.first == '+' && it == list.end())
+        {
+            list.push_back(op.second);
+        }
+        else if(op.first == '-' && it != list.end())
+        {
+            list.erase(it);
+        }
+    }
+
+    // Toggles favorites like the UI does, compacting every third change.
+    void runWorkload(int faultStep = 0)
+    {
+        CrashingJournal journal(file, faultStep);
+        std::vector<std::string> list;
+
+        for(size_t i = 0; i < workload.size(); ++i)
+        {
+            apply(workload[i], list);
+            if(workload[i].first == '+')
+            {
+                journal.add(workload[i].second);
+            }
+            else
+            {
+                journal.remove(workload[i].second);
+            }
+            if(i % 3 == 2)
+            {
+                journal.compact(list);
+            }
+        }
+        journal.wait();
+    }
+
+    std::vector< std::vector<std::string> > prefixStates()
+    {
+        std::vector< std::vector<std::string> > states;
+        std::vector<std::string> list;
+
+        states.push_back(list);
+        for(size_t i = 0; i < workload.size(); ++i)
+        {
+            apply(workload[i], list);
+            std::vector<std::string> sorted = list;
+            std::sort(sorted.begin(), sorted.end());
+            states.push_back(sorted);
+        }
+        return states;
+    }
+
+    std::vector<std::string> replaySorted()
+    {
+        std::vector<std::string> entries;
+        PlaylistJournal::replay(file, entries);
+        std::sort(entries.begin(), entries.end());
+        return entries;
+    }
+};
+
+TEST_F(PlaylistJournalTest, ReplayRestoresTheFinalList)
+{
+    runWorkload();
+
+    ASSERT_EQ(prefixStates().back(), replaySorted());
+    ASSERT_EQ(0, access(file.c_str(), F_OK));
+}
+
+TEST_F(PlaylistJournalTest, ReplayWithoutPlaylistUsesJournal)
+{
+    {
+        PlaylistJournal journal(file, false);
+        journal.add("game1");
+        journal.add("game2");
+        journal.remove("game1");
+    }
+
+    std::vector<std::string> entries;
+    ASSERT_TRUE(PlaylistJournal::replay(file, entries));
+    ASSERT_EQ(1u, entries.size());
+    ASSERT_EQ("game2", entries[0]);
+}
+
+TEST_F(PlaylistJournalTest, CrashAtAnyStepKeepsAConsistentPrefix)
+{
+    std::vector< std::vector<std::string> > states = prefixStates();
+    int faults = 0;
+
+    for(int step = 1; ; ++step)
+    {
+        clean();
+
+        int status = runInChild([this, step]() { runWorkload(step); });
+
+        std::vector<std::string> entries = replaySorted();
+        ASSERT_TRUE(std::find(states.begin(), states.end(), entries) != states.end())
+            << "inconsistent list after a crash at step " << step;
+
+        if(status == 0)
+        {
+            ASSERT_EQ(states.back(), entries);
+            break;
+        }
+        ASSERT_EQ(CrashingJournal::FAULT_EXIT_CODE, status);
+        faults++;
+    }
+
+    ASSERT_GT(faults, 20);
+}
+
+TEST_F(PlaylistJournalTest, CompactionKeepsAJournalLeftByACrash)
+{
+    for(int step = 1; ; ++step)
+    {
+        // a crash left game1 in a compacting journal, not in the playlist
+        clean();
+        writeFile(file, "game0\n");
+        writeFile(file + ".journal.compacting", "+game1\n-game0\n+gam");
+
+        int status = runInChild([this, step]() {
+            CrashingJournal journal(file, step);
+            std::vector<std::string> list;
+            PlaylistJournal::replay(file, list);
+            list.push_back("game2");
+            journal.add("game2");
+            journal.compact(list);
+        });
+
+        std::vector<std::string> entries = replaySorted();
+        ASSERT_LE(1u, entries.size()) << "crash at step " << step;
+        ASSERT_EQ("game1", entries[0]) << "crash at step " << step;
+        ASSERT_TRUE(std::find(entries.begin(), entries.end(), "game0") == entries.end());
+
+        if(status == 0)
+        {
+            ASSERT_EQ(2u, entries.size());
+            ASSERT_EQ(-1, access((file + ".journal.compacting").c_str(), F_OK));
+            break;
+        }
+        ASSERT_EQ(CrashingJournal::FAULT_EXIT_CODE, status);
+    }
+}
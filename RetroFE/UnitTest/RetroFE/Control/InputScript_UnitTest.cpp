@@ -0,0 +1,74 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Control/InputScript.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+TEST(InputScriptTest, ReplaysEventsByFrame)
+{
+    InputScript script;
+    std::stringstream in("# frame key state\n0 right down\n\n300 right up   # release\n300 select down\n360 end\n");
+    std::vector<InputScript::Event> events;
+
+    ASSERT_TRUE(script.parse(in));
+    ASSERT_EQ(3u, script.getEvents().size());
+
+    script.take(0, events);
+    ASSERT_EQ(1u, events.size());
+    ASSERT_EQ(InputScript::keyCode("right"), events[0].key);
+    ASSERT_TRUE(events[0].pressed);
+
+    events.clear();
+    script.take(299, events);
+    ASSERT_TRUE(events.empty());
+    ASSERT_FALSE(script.isFinished(299));
+
+    script.take(305, events);
+    ASSERT_EQ(2u, events.size());
+    ASSERT_FALSE(events[0].pressed);
+    ASSERT_EQ(InputScript::keyCode("select"), events[1].key);
+    ASSERT_TRUE(script.isFinished(360));
+}
+
+TEST(InputScriptTest, RejectsMalformedLines)
+{
+    InputScript script;
+    std::stringstream unknownKey("0 sideways down\n");
+    std::stringstream badState("0 up pressed\n");
+    std::stringstream outOfOrder("10 up down\n5 up up\n");
+    std::stringstream noFrame("up down\n");
+
+    ASSERT_FALSE(script.parse(unknownKey));
+    ASSERT_FALSE(script.parse(badState));
+    ASSERT_FALSE(script.parse(outOfOrder));
+    ASSERT_FALSE(script.parse(noFrame));
+}
+
+TEST(InputScriptTest, RecordingReadsBack)
+{
+    char path[] = "/tmp/inputscriptXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_NE(-1, fd);
+    close(fd);
+
+    {
+        InputScript recorder;
+        ASSERT_TRUE(recorder.record(path));
+        recorder.write(12, InputScript::keyCode("pageDown"), true);
+        recorder.write(40, InputScript::keyCode("pageDown"), false);
+        recorder.close(90);
+        ASSERT_FALSE(recorder.isRecording());
+    }
+
+    InputScript script;
+    ASSERT_TRUE(script.load(path));
+    ASSERT_EQ(2u, script.getEvents().size());
+    ASSERT_EQ(12u, script.getEvents()[0].frame);
+    ASSERT_EQ(std::string("pageDown"), InputScript::keyName(script.getEvents()[1].key));
+    ASSERT_FALSE(script.isFinished(89));
+    ASSERT_TRUE(script.isFinished(90));
+
+    remove(path);
+}
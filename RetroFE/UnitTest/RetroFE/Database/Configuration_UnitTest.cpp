@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Database/Configuration.h>
+#include <string>
+
+class ConfigurationTest : public ::testing::Test
+{
+protected:
+    Configuration config;
+
+    virtual void SetUp()
+    {
+        config.layouts_.push_back(Configuration::LayoutPair("/usr/games/layouts/Classic", false));
+        config.layouts_.push_back(Configuration::LayoutPair("/mnt/layouts/Custom", true));
+        config.currentLayoutIdx_ = 0;
+    }
+};
+
+TEST_F(ConfigurationTest, SetCurrentLayoutUpdatesProperties)
+{
+    std::string layout;
+    bool userTheme = false;
+
+    ASSERT_TRUE(config.setCurrentLayout(1));
+    ASSERT_TRUE(config.getProperty("layout", layout));
+    ASSERT_TRUE(config.getProperty("userTheme", userTheme));
+    ASSERT_EQ("Custom", layout);
+    ASSERT_TRUE(userTheme);
+    ASSERT_EQ(1, config.currentLayoutIdx_);
+    ASSERT_TRUE(Configuration::isUserLayout_);
+}
+
+// only the layout bookkeeping; the pages, fonts and collections a switch
+// reloads are owned by RetroFE and not covered here
+TEST_F(ConfigurationTest, RepeatedSwitchingEndsOnTheLastLayout)
+{
+    std::string layout;
+    bool userTheme = true;
+
+    for(int i = 0; i < 1000; ++i)
+    {
+        ASSERT_TRUE(config.setCurrentLayout(i % 2));
+    }
+
+    ASSERT_TRUE(config.getProperty("layout", layout));
+    ASSERT_TRUE(config.getProperty("userTheme", userTheme));
+    ASSERT_EQ("Custom", layout);
+    ASSERT_TRUE(userTheme);
+
+    ASSERT_TRUE(config.setCurrentLayout(0));
+    ASSERT_TRUE(config.getProperty("layout", layout));
+    ASSERT_TRUE(config.getProperty("userTheme", userTheme));
+    ASSERT_EQ("Classic", layout);
+    ASSERT_FALSE(userTheme);
+}
+
+TEST_F(ConfigurationTest, SetCurrentLayoutRejectsUnknownIndex)
+{
+    ASSERT_FALSE(config.setCurrentLayout(-1));
+    ASSERT_FALSE(config.setCurrentLayout(2));
+    ASSERT_EQ(0, config.currentLayoutIdx_);
+}
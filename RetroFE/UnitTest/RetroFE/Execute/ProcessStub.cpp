@@ -0,0 +1,26 @@
+#include <cstdio>
+
+// Test helper for Process_UnitTest: writes each argument after the first to
+// the file named by the first, one per line, and exits with the number of
+// arguments written.
+int main(int argc, char *argv[])
+{
+    if(argc < 2)
+    {
+        return 255;
+    }
+
+    FILE *out = fopen(argv[1], "w");
+    if(!out)
+    {
+        return 254;
+    }
+
+    for(int i = 2; i < argc; i++)
+    {
+        fprintf(out, "%s\n", argv[i]);
+    }
+    fclose(out);
+
+    return argc - 2;
+}
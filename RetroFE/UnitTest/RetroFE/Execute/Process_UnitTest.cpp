@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Execute/Process.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+class ProcessTest : public ::testing::Test
+{
+protected:
+    std::string outputFile()
+    {
+        char name[] = "/tmp/retrofe_process_XXXXXX";
+        int fd = mkstemp(name);
+        close(fd);
+        return name;
+    }
+
+    Process::Args readLines(const std::string &file)
+    {
+        Process::Args lines;
+        std::ifstream in(file.c_str());
+        std::string line;
+        while(std::getline(in, line))
+        {
+            lines.push_back(line);
+        }
+        std::remove(file.c_str());
+        return lines;
+    }
+};
+
+TEST_F(ProcessTest, ArgumentsReachTheProgramUnchanged)
+{
+    std::string file = outputFile();
+    Process::Args argv;
+    argv.push_back(PROCESS_STUB);
+    argv.push_back(file);
+    argv.push_back("Pac-Man's Revenge (1982).zip");
+    argv.push_back("$HOME and `ls`");
+    argv.push_back("\"double\" 'single'");
+    argv.push_back("");
+
+    ASSERT_EQ(4, Process::run(argv));
+
+    Process::Args lines = readLines(file);
+    ASSERT_EQ(4u, lines.size());
+    ASSERT_EQ(argv[2], lines[0]);
+    ASSERT_EQ(argv[3], lines[1]);
+    ASSERT_EQ(argv[4], lines[2]);
+    ASSERT_EQ("", lines[3]);
+}
+
+TEST_F(ProcessTest, RunsFromCurrentDirectory)
+{
+    std::string file = outputFile();
+    std::string name = file.substr(file.rfind('/') + 1);
+    Process::Args argv;
+    argv.push_back(PROCESS_STUB);
+    argv.push_back(name);
+    argv.push_back("a b");
+
+    ASSERT_EQ(1, Process::run(argv, "/tmp"));
+
+    Process::Args lines = readLines(file);
+    ASSERT_EQ(1u, lines.size());
+    ASSERT_EQ("a b", lines[0]);
+}
+
+TEST_F(ProcessTest, MissingProgramFailsToSpawn)
+{
+    Process::Args argv(1, "/nonexistent/retrofe_stub");
+
+    ASSERT_EQ(-1, Process::spawn(argv));
+    ASSERT_EQ(-1, Process::spawn(argv, "/tmp"));
+    ASSERT_EQ(-1, Process::spawn(argv, "/nonexistent"));
+}
+
+TEST_F(ProcessTest, WaitTimesOut)
+{
+    Process::Args argv;
+    argv.push_back("sleep");
+    argv.push_back("1");
+
+    pid_t pid = Process::spawn(argv);
+    ASSERT_GT(pid, 0);
+    ASSERT_EQ(Process::TIMEOUT, Process::wait(pid, 10));
+    ASSERT_EQ(0, Process::wait(pid));
+}
+
+TEST_F(ProcessTest, SplitArgumentsFollowsShellQuoting)
+{
+    Process::Args words = Process::splitArguments("  -L \"/cores/a b.so\" '%ITEM_FILEPATH%' x\\ y \"q\\\"uote\" '' ");
+
+    ASSERT_EQ(6u, words.size());
+    ASSERT_EQ("-L", words[0]);
+    ASSERT_EQ("/cores/a b.so", words[1]);
+    ASSERT_EQ("%ITEM_FILEPATH%", words[2]);
+    ASSERT_EQ("x y", words[3]);
+    ASSERT_EQ("q\"uote", words[4]);
+    ASSERT_EQ("", words[5]);
+}
@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Graphics/AlphaBlend.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+class AlphaBlendTest : public ::testing::Test
+{
+protected:
+    static const int WIDTH  = 37;
+    static const int HEIGHT = 5;
+    static const int PITCH  = 40 * 4;
+
+    std::vector<uint32_t> src;
+    std::vector<uint32_t> dst;
+
+    virtual void SetUp()
+    {
+        srand(7);
+        src.resize(PITCH / 4 * HEIGHT);
+        dst.resize(PITCH / 4 * HEIGHT);
+        for(unsigned int i = 0; i < src.size(); ++i)
+        {
+            src[i] = random32();
+            dst[i] = random32();
+        }
+        // fully transparent and fully opaque pixels take their own paths
+        src[3] = (src[3] & 0x00ffffff);
+        src[4] = (src[4] | 0xff000000);
+    }
+
+    static uint32_t random32()
+    {
+        return (static_cast<uint32_t>(rand() & 0xffff) << 16) | static_cast<uint32_t>(rand() & 0xffff);
+    }
+
+    // Floating point model of source-over with a global alpha.
+    static uint32_t golden(uint32_t s, uint32_t d, uint8_t alpha, bool srcHasAlpha, bool swap)
+    {
+        if(swap)
+        {
+            s = (s & 0xff00ff00) | ((s >> 16) & 0xff) | ((s & 0xff) << 16);
+        }
+        int a = srcHasAlpha ? static_cast<int>(std::floor((s >> 24) * alpha / 255.0 + 0.5)) : alpha;
+        uint32_t out = d & 0xff000000;
+        for(int shift = 0; shift < 24; shift += 8)
+        {
+            int sc = (s >> shift) & 0xff;
+            int dc = (d >> shift) & 0xff;
+            out |= static_cast<uint32_t>(std::floor((sc * a + dc * (255 - a)) / 255.0 + 0.5)) << shift;
+        }
+        return out;
+    }
+};
+
+const int AlphaBlendTest::WIDTH;
+const int AlphaBlendTest::HEIGHT;
+const int AlphaBlendTest::PITCH;
+
+TEST_F(AlphaBlendTest, ScalarMatchesGolden)
+{
+    const uint8_t alphas[] = { 0, 1, 64, 128, 254, 255 };
+
+    for(int mode = 0; mode < 4; ++mode)
+    {
+        bool srcHasAlpha = (mode & 1) != 0;
+        bool swap        = (mode & 2) != 0;
+        for(unsigned int i = 0; i < sizeof(alphas); ++i)
+        {
+            std::vector<uint32_t> out = dst;
+            AlphaBlend::blendScalar(&src[0], PITCH, &out[0], PITCH, WIDTH, HEIGHT, alphas[i], srcHasAlpha, swap);
+
+            for(int y = 0; y < HEIGHT; ++y)
+            {
+                for(int x = 0; x < PITCH / 4; ++x)
+                {
+                    unsigned int p = y * PITCH / 4 + x;
+                    uint32_t expected = (x < WIDTH && alphas[i] > 0) ? golden(src[p], dst[p], alphas[i], srcHasAlpha, swap) : dst[p];
+                    ASSERT_EQ(expected, out[p]) << "mode " << mode << " alpha " << int(alphas[i]) << " at " << x << "," << y;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(AlphaBlendTest, VectorMatchesScalar)
+{
+    for(int mode = 0; mode < 4; ++mode)
+    {
+        bool srcHasAlpha = (mode & 1) != 0;
+        bool swap        = (mode & 2) != 0;
+        for(int alpha = 0; alpha <= 255; ++alpha)
+        {
+            std::vector<uint32_t> expected = dst;
+            std::vector<uint32_t> out      = dst;
+            AlphaBlend::blendScalar(&src[0], PITCH, &expected[0], PITCH, WIDTH, HEIGHT, static_cast<uint8_t>(alpha), srcHasAlpha, swap);
+            AlphaBlend::blend(&src[0], PITCH, &out[0], PITCH, WIDTH, HEIGHT, static_cast<uint8_t>(alpha), srcHasAlpha, swap);
+            ASSERT_EQ(expected, out) << "mode " << mode << " alpha " << alpha;
+        }
+    }
+}
+
+TEST_F(AlphaBlendTest, OpaqueSourceAtFullAlphaCopies)
+{
+    std::vector<uint32_t> out = dst;
+    AlphaBlend::blend(&src[0], PITCH, &out[0], PITCH, WIDTH, 1, 255, false, true);
+
+    uint32_t s = src[0];
+    ASSERT_EQ((dst[0] & 0xff000000) | ((s >> 16) & 0xff) | (s & 0xff00) | ((s & 0xff) << 16), out[0]);
+    ASSERT_EQ(dst[WIDTH], out[WIDTH]);
+}
@@ -0,0 +1,52 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Graphics/Animate/Tween.h>
+#include <Graphics/Animate/TweenBatch.h>
+
+class TweenBatchTest : public ::testing::Test
+{
+};
+
+TEST_F(TweenBatchTest, EasingMatchesDoublePrecision)
+{
+    for(int type = LINEAR; type <= EASE_INOUT_CIRCULAR; ++type)
+    {
+        for(int step = 0; step <= 1000; ++step)
+        {
+            double elapsed = step / 1000.0;
+            float expected = Tween::animateSingle(static_cast<TweenAlgorithm>(type), 0, 1, 1, elapsed);
+            float actual = TweenBatch::ease(static_cast<TweenAlgorithm>(type), static_cast<float>(elapsed));
+
+            ASSERT_NEAR(expected, actual, 1.0 / 256) << "algorithm " << type << " at " << elapsed;
+        }
+    }
+}
+
+TEST_F(TweenBatchTest, FlushWritesResultsInPushOrder)
+{
+    float x = 0;
+    unsigned int layer = 0;
+    TweenBatch batch;
+
+    batch.begin();
+    batch.push(EASE_INOUT_QUADRATIC, 100, 300, 0.5f, &x);
+    batch.push(LINEAR, 0, 10, 0.25f, &layer);
+    batch.push(LINEAR, 0, 40, 1.0f, &x);
+    ASSERT_EQ(3u, batch.size());
+    ASSERT_EQ(0, x);
+
+    batch.end();
+    ASSERT_EQ(0u, batch.size());
+    ASSERT_FLOAT_EQ(40, x);
+    ASSERT_EQ(2u, layer);
+}
+
+TEST_F(TweenBatchTest, ImmediateModeWritesOnPush)
+{
+    float alpha = 0;
+    TweenBatch batch;
+
+    batch.push(EASE_IN_SINE, 0, 1, 1.0f, &alpha);
+    ASSERT_NEAR(1, alpha, 1.0 / 256);
+    ASSERT_FALSE(batch.isDeferred());
+}
@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Graphics/FrameCapture.h>
+#include <cstring>
+#include <vector>
+#include <zlib.h>
+
+class FrameCaptureTest : public ::testing::Test
+{
+protected:
+    static const int WIDTH  = 5;
+    static const int HEIGHT = 3;
+
+    // XRGB pixels with two words of row padding
+    std::vector<uint32_t> xrgb;
+    // the same image stored as XBGR without padding
+    std::vector<uint32_t> xbgr;
+
+    virtual void SetUp()
+    {
+        xrgb.assign((WIDTH + 2) * HEIGHT, 0xdeadbeef);
+        xbgr.resize(WIDTH * HEIGHT);
+        for(int y = 0; y < HEIGHT; ++y)
+        {
+            for(int x = 0; x < WIDTH; ++x)
+            {
+                uint32_t r = 40 * x + 3;
+                uint32_t g = 70 * y + 5;
+                uint32_t b = (x * y * 31) & 0xff;
+                xrgb[y * (WIDTH + 2) + x] = 0xff000000 | (r << 16) | (g << 8) | b;
+                xbgr[y * WIDTH + x]       = (b << 16) | (g << 8) | r;
+            }
+        }
+    }
+
+    FrameCapture::Frame frameXrgb()
+    {
+        FrameCapture::Frame frame = { reinterpret_cast<const uint8_t *>(xrgb.data()), WIDTH, HEIGHT, (WIDTH + 2) * 4, 16, 8, 0 };
+        return frame;
+    }
+
+    FrameCapture::Frame frameXbgr()
+    {
+        FrameCapture::Frame frame = { reinterpret_cast<const uint8_t *>(xbgr.data()), WIDTH, HEIGHT, WIDTH * 4, 0, 8, 16 };
+        return frame;
+    }
+
+    static uint32_t readUint32(const std::vector<uint8_t> &data, size_t offset)
+    {
+        return (static_cast<uint32_t>(data[offset]) << 24) | (data[offset + 1] << 16) | (data[offset + 2] << 8) | data[offset + 3];
+    }
+};
+
+TEST_F(FrameCaptureTest, ChecksumIgnoresFormatAndPadding)
+{
+    uint64_t checksum = FrameCapture::checksum(frameXrgb());
+
+    ASSERT_EQ(checksum, FrameCapture::checksum(frameXbgr()));
+    ASSERT_EQ(16u, FrameCapture::checksumString(checksum).size());
+
+    xbgr[7] ^= 0x00000100;
+    ASSERT_NE(checksum, FrameCapture::checksum(frameXbgr()));
+}
+
+TEST_F(FrameCaptureTest, RawIsPackedRgb)
+{
+    std::vector<uint8_t> raw;
+
+    FrameCapture::encodeRaw(frameXrgb(), raw);
+    ASSERT_EQ(static_cast<size_t>(WIDTH * HEIGHT * 3), raw.size());
+
+    size_t pixel = (2 * WIDTH + 4) * 3;
+    ASSERT_EQ(40 * 4 + 3, raw[pixel]);
+    ASSERT_EQ(70 * 2 + 5, raw[pixel + 1]);
+    ASSERT_EQ((4 * 2 * 31) & 0xff, raw[pixel + 2]);
+}
+
+TEST_F(FrameCaptureTest, PngDecodesToTheSamePixels)
+{
+    std::vector<uint8_t> png;
+    std::vector<uint8_t> raw;
+
+    ASSERT_TRUE(FrameCapture::encodePng(frameXrgb(), png));
+    FrameCapture::encodeRaw(frameXrgb(), raw);
+
+    ASSERT_EQ(0, memcmp(png.data(), "\x89PNG\r\n\x1a\n", 8));
+    ASSERT_EQ(13u, readUint32(png, 8));
+    ASSERT_EQ(0, memcmp(&png[12], "IHDR", 4));
+    ASSERT_EQ(static_cast<uint32_t>(WIDTH), readUint32(png, 16));
+    ASSERT_EQ(static_cast<uint32_t>(HEIGHT), readUint32(png, 20));
+    ASSERT_EQ(crc32(0, &png[12], 17), readUint32(png, 29));
+
+    size_t idat = 33;
+    uint32_t size = readUint32(png, idat);
+    ASSERT_EQ(0, memcmp(&png[idat + 4], "IDAT", 4));
+    ASSERT_EQ(crc32(0, &png[idat + 4], size + 4), readUint32(png, idat + 8 + size));
+
+    std::vector<uint8_t> scanlines((WIDTH * 3 + 1) * HEIGHT);
+    uLongf length = scanlines.size();
+    ASSERT_EQ(Z_OK, uncompress(scanlines.data(), &length, &png[idat + 8], size));
+    ASSERT_EQ(scanlines.size(), length);
+    for(int y = 0; y < HEIGHT; ++y)
+    {
+        ASSERT_EQ(0, scanlines[y * (WIDTH * 3 + 1)]);
+        ASSERT_EQ(0, memcmp(&scanlines[y * (WIDTH * 3 + 1) + 1], &raw[y * WIDTH * 3], WIDTH * 3));
+    }
+
+    ASSERT_EQ(0, memcmp(&png[png.size() - 8], "IEND", 4));
+}
@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Graphics/Reflector.h>
+#include <vector>
+
+class ReflectorTest : public ::testing::Test
+{
+protected:
+    static const int WIDTH  = 6;
+    static const int HEIGHT = 4;
+
+    std::vector<uint32_t> src;
+    std::vector<uint32_t> dst;
+    Resampler::Image      source;
+
+    virtual void SetUp()
+    {
+        // colour only, so the opaque mask decides the alpha
+        src.resize(WIDTH * HEIGHT);
+        for(int i = 0; i < WIDTH * HEIGHT; ++i)
+        {
+            src[i] = static_cast<uint32_t>(i * 0x030507);
+        }
+        source.pixels = &src[0];
+        source.pitch  = WIDTH * 4;
+        source.width  = WIDTH;
+        source.height = HEIGHT;
+    }
+
+    void build(ViewInfo::ReflectionSide side, float alpha)
+    {
+        dst.assign(WIDTH * HEIGHT, 0);
+        ASSERT_TRUE(Reflector::build(source, side, alpha, 0xff000000, &dst[0], WIDTH * 4, WIDTH, HEIGHT));
+    }
+
+    uint32_t at(int x, int y)
+    {
+        return dst[y * WIDTH + x];
+    }
+};
+
+const int ReflectorTest::WIDTH;
+const int ReflectorTest::HEIGHT;
+
+TEST_F(ReflectorTest, SizeSquashesTowardsTheSide)
+{
+    int width, height;
+
+    ASSERT_TRUE(Reflector::size(40, 20, ViewInfo::ReflectionTop, 0.25f, width, height));
+    ASSERT_EQ(40, width);
+    ASSERT_EQ(5, height);
+
+    ASSERT_TRUE(Reflector::size(40, 20, ViewInfo::ReflectionRight, 0.25f, width, height));
+    ASSERT_EQ(10, width);
+    ASSERT_EQ(20, height);
+
+    ASSERT_FALSE(Reflector::size(40, 20, ViewInfo::ReflectionNone, 0.25f, width, height));
+    ASSERT_FALSE(Reflector::size(40, 20, ViewInfo::ReflectionBottom, 0.01f, width, height));
+}
+
+TEST_F(ReflectorTest, BottomMirrorsAndFades)
+{
+    build(ViewInfo::ReflectionBottom, 1.0f);
+
+    for(int y = 0; y < HEIGHT; ++y)
+    {
+        for(int x = 0; x < WIDTH; ++x)
+        {
+            ASSERT_EQ(src[(HEIGHT - 1 - y) * WIDTH + x], at(x, y) & 0x00ffffff);
+        }
+    }
+    ASSERT_EQ(255u, at(0, 0) >> 24);
+    ASSERT_EQ(64u, at(0, HEIGHT - 1) >> 24);
+}
+
+TEST_F(ReflectorTest, TopFadesUpwards)
+{
+    build(ViewInfo::ReflectionTop, 0.5f);
+
+    ASSERT_EQ(src[0], at(0, HEIGHT - 1) & 0x00ffffff);
+    ASSERT_EQ(128u, at(0, HEIGHT - 1) >> 24);
+    ASSERT_LT(at(0, 0) >> 24, at(0, 1) >> 24);
+}
+
+TEST_F(ReflectorTest, LeftAndRightMirrorColumns)
+{
+    build(ViewInfo::ReflectionLeft, 1.0f);
+    ASSERT_EQ(src[0], at(WIDTH - 1, 0) & 0x00ffffff);
+    ASSERT_EQ(255u, at(WIDTH - 1, 0) >> 24);
+
+    build(ViewInfo::ReflectionRight, 1.0f);
+    ASSERT_EQ(src[WIDTH - 1], at(0, 0) & 0x00ffffff);
+    ASSERT_EQ(255u, at(0, 0) >> 24);
+    ASSERT_LT(at(WIDTH - 1, 0) >> 24, 255u);
+}
@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Graphics/MipChain.h>
+#include <Graphics/Resampler.h>
+#include <cstdlib>
+#include <vector>
+
+class ResamplerTest : public ::testing::Test
+{
+protected:
+    std::vector<uint32_t> pixels;
+    Resampler::Image source;
+
+    void makeSource(int width, int height)
+    {
+        pixels.resize(width * height);
+        for(unsigned int i = 0; i < pixels.size(); ++i)
+        {
+            pixels[i] = (static_cast<uint32_t>(rand() & 0xffff) << 16) | static_cast<uint32_t>(rand() & 0xffff);
+        }
+        source.pixels = &pixels[0];
+        source.pitch  = width * 4;
+        source.width  = width;
+        source.height = height;
+    }
+
+    static uint8_t channel(uint32_t pixel, int c)
+    {
+        return static_cast<uint8_t>(pixel >> (c * 8));
+    }
+};
+
+TEST_F(ResamplerTest, SameSizeIsACopy)
+{
+    makeSource(13, 7);
+    std::vector<uint32_t> out(13 * 7);
+
+    ASSERT_TRUE(Resampler::scale(source, 13, 7, &out[0], 13 * 4, 0, 0, 13, 7));
+    ASSERT_EQ(pixels, out);
+}
+
+TEST_F(ResamplerTest, HalvingAveragesBlocks)
+{
+    makeSource(8, 6);
+    std::vector<uint32_t> out(4 * 3);
+
+    ASSERT_TRUE(Resampler::scale(source, 4, 3, &out[0], 4 * 4, 0, 0, 4, 3));
+    for(int y = 0; y < 3; ++y)
+    {
+        for(int x = 0; x < 4; ++x)
+        {
+            for(int c = 0; c < 4; ++c)
+            {
+                int sum = channel(pixels[(2 * y) * 8 + 2 * x], c) + channel(pixels[(2 * y) * 8 + 2 * x + 1], c) +
+                          channel(pixels[(2 * y + 1) * 8 + 2 * x], c) + channel(pixels[(2 * y + 1) * 8 + 2 * x + 1], c);
+                ASSERT_EQ((sum + 2) / 4, channel(out[y * 4 + x], c));
+            }
+        }
+    }
+}
+
+TEST_F(ResamplerTest, UniformColourStaysUniform)
+{
+    makeSource(97, 61);
+    std::fill(pixels.begin(), pixels.end(), 0x80ff3301);
+    std::vector<uint32_t> out(240 * 240);
+
+    ASSERT_TRUE(Resampler::scale(source, 240, 240, &out[0], 240 * 4, 0, 0, 240, 240));
+    ASSERT_EQ(std::vector<uint32_t>(240 * 240, 0x80ff3301), out);
+    ASSERT_TRUE(Resampler::scale(source, 31, 17, &out[0], 31 * 4, 0, 0, 31, 17));
+    ASSERT_EQ(std::vector<uint32_t>(31 * 17, 0x80ff3301), std::vector<uint32_t>(out.begin(), out.begin() + 31 * 17));
+}
+
+TEST_F(ResamplerTest, CropMatchesFullImage)
+{
+    makeSource(300, 200);
+    std::vector<uint32_t> full(120 * 90);
+    std::vector<uint32_t> crop(50 * 40);
+
+    ASSERT_TRUE(Resampler::scale(source, 120, 90, &full[0], 120 * 4, 0, 0, 120, 90));
+    ASSERT_TRUE(Resampler::scale(source, 120, 90, &crop[0], 50 * 4, 35, 25, 50, 40));
+    for(int y = 0; y < 40; ++y)
+    {
+        for(int x = 0; x < 50; ++x)
+        {
+            ASSERT_EQ(full[(y + 25) * 120 + x + 35], crop[y * 50 + x]) << x << "," << y;
+        }
+    }
+}
+
+TEST_F(ResamplerTest, VectorMatchesScalar)
+{
+    const int sizes[][2] = { { 240, 240 }, { 37, 19 }, { 1, 1 }, { 611, 457 }, { 1300, 5 } };
+    makeSource(640, 480);
+
+    for(unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        int width  = sizes[i][0];
+        int height = sizes[i][1];
+        std::vector<uint32_t> expected(width * height);
+        std::vector<uint32_t> out(width * height);
+        ASSERT_TRUE(Resampler::scaleScalar(source, width, height, &expected[0], width * 4, 0, 0, width, height));
+        ASSERT_TRUE(Resampler::scale(source, width, height, &out[0], width * 4, 0, 0, width, height));
+        ASSERT_EQ(expected, out) << width << "x" << height;
+    }
+}
+
+TEST_F(ResamplerTest, MipChainBuildsHalfSizeLevels)
+{
+    makeSource(256, 160);
+    MipChain mips;
+
+    mips.build(source, 16);
+    MipChain::wait();
+    ASSERT_EQ(3, mips.levels());
+    ASSERT_EQ((128u * 80 + 64 * 40 + 32 * 20) * 4, mips.bytes());
+
+    Resampler::Image level = mips.nearest(100, 60);
+    ASSERT_EQ(128, level.width);
+    ASSERT_EQ(80, level.height);
+    ASSERT_EQ(20, mips.nearest(10, 10).height);
+    ASSERT_EQ(&pixels[0], mips.nearest(200, 100).pixels);
+
+    std::vector<uint32_t> expected(128 * 80);
+    Resampler::scale(source, 128, 80, &expected[0], 128 * 4, 0, 0, 128, 80);
+    ASSERT_EQ(expected, std::vector<uint32_t>(level.pixels, level.pixels + 128 * 80));
+
+    mips.reset();
+    ASSERT_EQ(0, mips.levels());
+    ASSERT_EQ(0u, mips.bytes());
+    MipChain::shutdown();
+}
+
+TEST_F(ResamplerTest, MipChainResetCancelsTheBuild)
+{
+    makeSource(2048, 2048);
+    MipChain mips;
+
+    mips.build(source, 16);
+    mips.reset();
+    ASSERT_EQ(0, mips.levels());
+
+    mips.build(source, 512);
+    MipChain::wait();
+    ASSERT_EQ(2, mips.levels());
+    MipChain::shutdown();
+}
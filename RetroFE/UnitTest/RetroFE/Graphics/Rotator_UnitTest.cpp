@@ -0,0 +1,115 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Graphics/Rotator.h>
+#include <vector>
+
+class RotatorTest : public ::testing::Test
+{
+protected:
+    std::vector<uint32_t> src;
+    std::vector<uint32_t> dst;
+
+    // width x height opaque pixels, each one different
+    Resampler::Image image(int width, int height)
+    {
+        src.resize(width * height);
+        for(int i = 0; i < width * height; ++i)
+        {
+            src[i] = 0xff000000 | static_cast<uint32_t>(i * 0x010203 + 0x10);
+        }
+        Resampler::Image source;
+        source.pixels = &src[0];
+        source.pitch  = width * 4;
+        source.width  = width;
+        source.height = height;
+        return source;
+    }
+
+    bool rotate(const Resampler::Image &source, float angle, uint32_t opaqueMask, int &width, int &height)
+    {
+        Rotator::boundingBox(source.width, source.height, angle, width, height);
+        dst.assign(width * height, 0xdeadbeef);
+        return Rotator::rotate(source, angle, opaqueMask, &dst[0], width * 4, width, height);
+    }
+};
+
+TEST_F(RotatorTest, BoundingBox)
+{
+    int width, height;
+
+    Rotator::boundingBox(30, 20, 0, width, height);
+    ASSERT_EQ(30, width);
+    ASSERT_EQ(20, height);
+
+    Rotator::boundingBox(30, 20, 90, width, height);
+    ASSERT_EQ(20, width);
+    ASSERT_EQ(30, height);
+
+    Rotator::boundingBox(10, 10, 45, width, height);
+    ASSERT_EQ(15, width);
+    ASSERT_EQ(15, height);
+}
+
+TEST_F(RotatorTest, ZeroAngleCopies)
+{
+    Resampler::Image source = image(7, 5);
+    int width, height;
+
+    ASSERT_TRUE(rotate(source, 0, 0, width, height));
+    ASSERT_EQ(src, dst);
+}
+
+TEST_F(RotatorTest, RightAnglesMovePixels)
+{
+    Resampler::Image source = image(3, 2);
+    int width, height;
+
+    // clockwise: the left column becomes the top row, reading upwards
+    ASSERT_TRUE(rotate(source, 90, 0, width, height));
+    ASSERT_EQ(2, width);
+    ASSERT_EQ(3, height);
+    for(int y = 0; y < 3; ++y)
+    {
+        ASSERT_EQ(src[3 + y], dst[y * 2 + 0]);
+        ASSERT_EQ(src[y], dst[y * 2 + 1]);
+    }
+
+    ASSERT_TRUE(rotate(source, 180, 0, width, height));
+    for(int i = 0; i < 6; ++i)
+    {
+        ASSERT_EQ(src[5 - i], dst[i]);
+    }
+}
+
+TEST_F(RotatorTest, CornersAreTransparent)
+{
+    Resampler::Image source = image(16, 16);
+    for(unsigned int i = 0; i < src.size(); ++i)
+    {
+        src[i] &= 0x00ffffff;
+    }
+    int width, height;
+
+    ASSERT_TRUE(rotate(source, 45, 0xff000000, width, height));
+    ASSERT_EQ(0u, dst[0]);
+    ASSERT_EQ(0u, dst[width - 1]);
+    ASSERT_EQ(0u, dst[(height - 1) * width]);
+    ASSERT_EQ(0u, dst[height * width - 1]);
+
+    // the opaque mask gives the inside a full alpha
+    ASSERT_EQ(0xffu, dst[(height / 2) * width + width / 2] >> 24);
+
+    // and every pixel was written
+    for(unsigned int i = 0; i < dst.size(); ++i)
+    {
+        ASSERT_NE(0xdeadbeef, dst[i]);
+    }
+}
+
+TEST_F(RotatorTest, QuantizeFoldsAngles)
+{
+    ASSERT_FLOAT_EQ(1.0f, Rotator::quantize(361.2f, 0.5f));
+    ASSERT_FLOAT_EQ(270.0f, Rotator::quantize(-90.0f, 1.0f));
+    ASSERT_FLOAT_EQ(0.0f, Rotator::quantize(359.9f, 0.5f));
+    ASSERT_FLOAT_EQ(12.25f, Rotator::quantize(12.25f, 0));
+}
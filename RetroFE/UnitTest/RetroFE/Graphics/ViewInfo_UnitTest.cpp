@@ -0,0 +1,46 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Graphics/ViewInfo.h>
+#include <cstring>
+#include <vector>
+
+TEST(ViewInfoTest, BoundsMatchesTheSeparateGetters)
+{
+    ViewInfo info;
+    info.X           = 100;
+    info.Y           = 50;
+    info.XOffset     = 3;
+    info.YOffset     = -7;
+    info.XOrigin     = 0.5f;
+    info.YOrigin     = 1;
+    info.ImageWidth  = 320;
+    info.ImageHeight = 240;
+    info.Height      = 120;
+    info.MaxWidth    = 150;
+
+    float x, y, width, height;
+    info.Bounds(x, y, width, height);
+
+    ASSERT_FLOAT_EQ(info.XRelativeToOrigin(), x);
+    ASSERT_FLOAT_EQ(info.YRelativeToOrigin(), y);
+    ASSERT_FLOAT_EQ(info.ScaledWidth(), width);
+    ASSERT_FLOAT_EQ(info.ScaledHeight(), height);
+    ASSERT_FLOAT_EQ(150, width);
+    ASSERT_FLOAT_EQ(112.5f, height);
+}
+
+TEST(ViewInfoTest, ScrollPointsCopyAsPlainMemory)
+{
+    std::vector<ViewInfo> points(3);
+    for(size_t i = 0; i < points.size(); ++i)
+    {
+        points[i].Y          = static_cast<float>(i * 40);
+        points[i].Reflection = ViewInfo::ReflectionBottom;
+    }
+
+    ViewInfo copy;
+    std::memcpy(&copy, &points[2], sizeof(ViewInfo));
+    ASSERT_FLOAT_EQ(80, copy.Y);
+    ASSERT_EQ(ViewInfo::ReflectionBottom, copy.Reflection);
+    ASSERT_EQ(NULL, copy.font);
+}
@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Utility/FrameStats.h>
+#include <vector>
+
+TEST(FrameStatsTest, PercentilesUseNearestRank)
+{
+    std::vector<double> sorted;
+    for(int i = 1; i <= 200; ++i)
+    {
+        sorted.push_back(i);
+    }
+
+    ASSERT_EQ(100, FrameStats::percentile(sorted, 50));
+    ASSERT_EQ(190, FrameStats::percentile(sorted, 95));
+    ASSERT_EQ(198, FrameStats::percentile(sorted, 99));
+    ASSERT_EQ(1, FrameStats::percentile(sorted, 0));
+    ASSERT_EQ(0, FrameStats::percentile(std::vector<double>(), 50));
+}
+
+TEST(FrameStatsTest, CountsProbesAndAllocationsPerFrame)
+{
+    FrameStats stats;
+
+    stats.beginFrame();
+    FrameStats::countFileProbe();
+    FrameStats::countFileProbe();
+    // stored through a volatile pointer so the allocation is not elided
+    int *volatile value = new int(3);
+    stats.endFrame(0);
+    delete value;
+
+    stats.beginFrame();
+    stats.pause();
+    FrameStats::countFileProbe();
+    stats.resume();
+    stats.endFrame(1);
+
+    FrameStats::Summary summary = stats.summarize();
+    ASSERT_EQ(2u, summary.frames);
+    ASSERT_EQ(3u, summary.fileProbes);
+#ifdef RETROFE_COUNT_ALLOCATIONS
+    ASSERT_GE(summary.allocations, 1u);
+#else
+    ASSERT_EQ(0u, summary.allocations);
+#endif
+    ASSERT_GE(summary.max, summary.p50);
+    ASSERT_FALSE(stats.isEmpty());
+}
@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Utility/Log.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+class LogTest : public ::testing::Test
+{
+protected:
+    std::string file;
+
+    virtual void SetUp()
+    {
+        std::stringstream ss;
+        ss << "/tmp/retrofe_log_test_" << getpid() << ".txt";
+        file = ss.str();
+        Logger::setZones("DEBUG,INFO,NOTICE,WARNING,ERROR");
+        ASSERT_TRUE(Logger::initialize(file));
+    }
+
+    virtual void TearDown()
+    {
+        Logger::deInitialize();
+        std::remove(file.c_str());
+    }
+
+    std::vector<std::string> readLines()
+    {
+        std::vector<std::string> lines;
+        std::ifstream ifs(file.c_str());
+        std::string line;
+        while(std::getline(ifs, line))
+        {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+};
+
+TEST_F(LogTest, ConcurrentWritersKeepEveryRecordInOrder)
+{
+    const int threads = 4;
+    const int records = 5000;
+    std::vector<std::thread> writers;
+
+    for(int t = 0; t < threads; ++t)
+    {
+        writers.push_back(std::thread([t]() {
+            for(int i = 0; i < records; ++i)
+            {
+                std::stringstream ss;
+                ss << t << " " << i;
+                Logger::write(Logger::ZONE_INFO, "Test", ss.str());
+            }
+        }));
+    }
+    for(int t = 0; t < threads; ++t)
+    {
+        writers[t].join();
+    }
+    Logger::deInitialize();
+
+    std::vector<std::string> lines = readLines();
+    ASSERT_EQ(static_cast<size_t>(threads * records), lines.size());
+
+    std::vector<int> next(threads, 0);
+    for(size_t i = 0; i < lines.size(); ++i)
+    {
+        std::string payload = lines[i].substr(lines[i].find("[Test] ") + 7);
+        std::stringstream ss(payload);
+        int t, n;
+        ss >> t >> n;
+        ASSERT_EQ(next[t], n);
+        next[t]++;
+    }
+}
+
+TEST_F(LogTest, ErrorIsOnDiskBeforeWriteReturns)
+{
+    Logger::write(Logger::ZONE_INFO, "Test", "queued");
+    Logger::write(Logger::ZONE_ERROR, "Test", "failed");
+
+    std::vector<std::string> lines = readLines();
+    ASSERT_EQ(2u, lines.size());
+    ASSERT_NE(std::string::npos, lines[0].find("[INFO] [Test] queued"));
+    ASSERT_NE(std::string::npos, lines[1].find("[ERROR] [Test] failed"));
+}
+
+TEST_F(LogTest, DisabledZonesAreDropped)
+{
+    Logger::setZones("warning, error");
+    ASSERT_FALSE(Logger::isEnabled(Logger::ZONE_DEBUG));
+    ASSERT_TRUE(Logger::isEnabled(Logger::ZONE_WARNING));
+
+    Logger::write(Logger::ZONE_DEBUG, "Test", "dropped");
+    Logger::write(Logger::ZONE_WARNING, "Test", "kept");
+    Logger::flush();
+
+    std::vector<std::string> lines = readLines();
+    ASSERT_EQ(1u, lines.size());
+    ASSERT_NE(std::string::npos, lines[0].find("kept"));
+}
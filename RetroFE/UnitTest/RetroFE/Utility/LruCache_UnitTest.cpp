@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Utility/LruCache.h>
+#include <string>
+#include <vector>
+
+class LruCacheTest : public ::testing::Test
+{
+protected:
+    std::vector<std::string> evicted;
+
+    LruCache<std::string, int>::EvictCallback recorder()
+    {
+        return [this](const std::string &key, int &) { evicted.push_back(key); };
+    }
+};
+
+TEST_F(LruCacheTest, EvictsLeastRecentlyUsed)
+{
+    LruCache<std::string, int> cache(2, recorder());
+
+    cache.insert("a", 1);
+    cache.insert("b", 2);
+    ASSERT_EQ(1, *cache.find("a"));
+
+    cache.insert("c", 3);
+    ASSERT_EQ(2u, cache.size());
+    ASSERT_TRUE(cache.contains("a"));
+    ASSERT_FALSE(cache.contains("b"));
+    ASSERT_EQ(NULL, cache.find("b"));
+    ASSERT_EQ(1u, evicted.size());
+    ASSERT_EQ("b", evicted[0]);
+}
+
+TEST_F(LruCacheTest, ReplacingReleasesOldValue)
+{
+    LruCache<std::string, int> cache(4, recorder());
+
+    cache.insert("a", 1);
+    cache.insert("a", 2);
+    ASSERT_EQ(1u, cache.size());
+    ASSERT_EQ(2, *cache.find("a"));
+    ASSERT_EQ(1u, evicted.size());
+}
+
+TEST_F(LruCacheTest, ShrinkingAndClearingReleaseEverything)
+{
+    {
+        LruCache<std::string, int> cache(3, recorder());
+        cache.insert("a", 1);
+        cache.insert("b", 2);
+        cache.insert("c", 3);
+
+        cache.setCapacity(1);
+        ASSERT_EQ(1u, cache.size());
+        ASSERT_TRUE(cache.contains("c"));
+        ASSERT_EQ(2u, evicted.size());
+
+        ASSERT_TRUE(cache.erase("c"));
+        ASSERT_FALSE(cache.erase("c"));
+        cache.insert("d", 4);
+    }
+    ASSERT_EQ(4u, evicted.size());
+    ASSERT_EQ("d", evicted.back());
+}
+
+TEST_F(LruCacheTest, TakeHandsBackOwnership)
+{
+    LruCache<std::string, int> cache(3, recorder());
+    int value = 0;
+
+    cache.insert("a", 1);
+    cache.insert("b", 2);
+    ASSERT_TRUE(cache.take("a", value));
+    ASSERT_EQ(1, value);
+    ASSERT_FALSE(cache.take("a", value));
+    ASSERT_TRUE(evicted.empty());
+
+    ASSERT_TRUE(cache.evictOldest());
+    ASSERT_FALSE(cache.evictOldest());
+    ASSERT_EQ(1u, evicted.size());
+    ASSERT_EQ("b", evicted[0]);
+}
+
+TEST_F(LruCacheTest, EraseIfEvictsMatches)
+{
+    LruCache<std::string, int> cache(4, recorder());
+
+    cache.insert("a", 1);
+    cache.insert("b", 2);
+    cache.insert("c", 3);
+    ASSERT_EQ(2u, cache.eraseIf([](const std::string &, int &value) { return value != 2; }));
+    ASSERT_EQ(1u, cache.size());
+    ASSERT_TRUE(cache.contains("b"));
+    ASSERT_EQ(2u, evicted.size());
+    ASSERT_EQ(0u, cache.eraseIf([](const std::string &, int &) { return false; }));
+}
+
+TEST_F(LruCacheTest, OldestDoesNotTouchTheOrder)
+{
+    LruCache<std::string, int> cache(4, recorder());
+    std::string key;
+    int value = 0;
+
+    ASSERT_FALSE(cache.oldest(key, value));
+    cache.insert("a", 1);
+    cache.insert("b", 2);
+    ASSERT_TRUE(cache.oldest(key, value));
+    ASSERT_EQ("a", key);
+    ASSERT_EQ(1, value);
+    ASSERT_TRUE(cache.oldest(key, value));
+    ASSERT_EQ("a", key);
+
+    cache.find("a");
+    ASSERT_TRUE(cache.oldest(key, value));
+    ASSERT_EQ("b", key);
+    ASSERT_TRUE(evicted.empty());
+}
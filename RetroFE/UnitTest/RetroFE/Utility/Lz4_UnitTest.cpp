@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Utility/Lz4.h>
+#include <cstdlib>
+#include <vector>
+
+class Lz4Test : public ::testing::Test
+{
+protected:
+    std::vector<unsigned char> roundTrip(const std::vector<unsigned char> &input, size_t &compressedSize)
+    {
+        std::vector<unsigned char> compressed(Lz4::compressBound(input.size()));
+        compressedSize = Lz4::compress(input.data(), input.size(), compressed.data());
+        EXPECT_LE(compressedSize, compressed.size());
+
+        std::vector<unsigned char> output(input.size());
+        EXPECT_TRUE(Lz4::decompress(compressed.data(), compressedSize, output.data(), output.size()));
+        return output;
+    }
+};
+
+TEST_F(Lz4Test, RoundTripsEverySmallSize)
+{
+    for(size_t size = 0; size < 64; ++size)
+    {
+        std::vector<unsigned char> input(size);
+        for(size_t i = 0; i < size; ++i)
+        {
+            input[i] = static_cast<unsigned char>(i % 3);
+        }
+
+        size_t compressedSize;
+        ASSERT_EQ(input, roundTrip(input, compressedSize)) << "size " << size;
+    }
+}
+
+TEST_F(Lz4Test, CompressesRepetitivePixels)
+{
+    // a mostly transparent 256x256 ARGB surface with a few opaque rows
+    std::vector<unsigned char> input(256 * 256 * 4, 0);
+    for(size_t i = 100 * 256 * 4; i < 110 * 256 * 4; ++i)
+    {
+        input[i] = static_cast<unsigned char>(i * 7);
+    }
+
+    size_t compressedSize;
+    ASSERT_EQ(input, roundTrip(input, compressedSize));
+    ASSERT_LT(compressedSize, input.size() / 10);
+}
+
+TEST_F(Lz4Test, RoundTripsIncompressibleData)
+{
+    srand(1);
+    std::vector<unsigned char> input(100000);
+    for(size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = static_cast<unsigned char>(rand());
+    }
+
+    size_t compressedSize;
+    ASSERT_EQ(input, roundTrip(input, compressedSize));
+}
+
+TEST_F(Lz4Test, RejectsCorruptInput)
+{
+    std::vector<unsigned char> input(4096, 'a');
+    std::vector<unsigned char> compressed(Lz4::compressBound(input.size()));
+    size_t compressedSize = Lz4::compress(input.data(), input.size(), compressed.data());
+    std::vector<unsigned char> output(input.size());
+
+    ASSERT_FALSE(Lz4::decompress(compressed.data(), compressedSize - 1, output.data(), output.size()));
+    ASSERT_FALSE(Lz4::decompress(compressed.data(), compressedSize, output.data(), output.size() - 1));
+
+    // offset pointing before the start of the output
+    unsigned char bad[] = { 0x10, 'a', 0x05, 0x00, 0x00 };
+    ASSERT_FALSE(Lz4::decompress(bad, sizeof(bad), output.data(), output.size()));
+}
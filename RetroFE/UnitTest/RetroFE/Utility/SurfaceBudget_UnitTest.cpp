@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Utility/SurfaceBudget.h>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    const size_t ArtworkBytes = 256 * 256 * 4;
+    const size_t ScaledBytes  = 128 * 128 * 4;
+
+    // An image which decodes its artwork when created and reloads it when
+    // drawn after an eviction, like Image.
+    class Artwork : public SurfaceBudget::Client
+    {
+    public:
+        Artwork()
+            : loaded(false)
+            , reloads(0)
+        {
+            load();
+        }
+
+        void draw()
+        {
+            if(!loaded)
+            {
+                load();
+                reloads++;
+            }
+            SurfaceBudget::drawn(this);
+        }
+
+        void releaseSurfaces()
+        {
+            account.set(SurfaceBudget::CategoryArtwork, 0);
+            account.set(SurfaceBudget::CategoryScaled, 0);
+            loaded = false;
+        }
+
+        bool loaded;
+        int  reloads;
+
+    private:
+        void load()
+        {
+            account.set(SurfaceBudget::CategoryArtwork, ArtworkBytes);
+            account.set(SurfaceBudget::CategoryScaled, ScaledBytes);
+            loaded = true;
+            SurfaceBudget::loaded(this);
+        }
+
+        SurfaceBudget::Account account;
+    };
+}
+
+class SurfaceBudgetTest : public ::testing::Test
+{
+protected:
+    void SetUp()
+    {
+        SurfaceBudget::setBudget(0);
+        SurfaceBudget::endFrame();
+        ASSERT_EQ(0u, SurfaceBudget::total());
+    }
+
+    void TearDown()
+    {
+        SurfaceBudget::setBudget(0);
+    }
+};
+
+TEST_F(SurfaceBudgetTest, AccountsTrackBytesPerCategory)
+{
+    {
+        SurfaceBudget::Account text;
+        text.set(SurfaceBudget::CategoryText, 1000);
+        Artwork artwork;
+
+        ASSERT_EQ(1000u, SurfaceBudget::bytes(SurfaceBudget::CategoryText));
+        ASSERT_EQ(ArtworkBytes, SurfaceBudget::bytes(SurfaceBudget::CategoryArtwork));
+        ASSERT_EQ(1000 + ArtworkBytes + ScaledBytes, SurfaceBudget::total());
+        ASSERT_GE(SurfaceBudget::peak(), SurfaceBudget::total());
+
+        text.set(SurfaceBudget::CategoryText, 400);
+        ASSERT_EQ(400u, SurfaceBudget::bytes(SurfaceBudget::CategoryText));
+    }
+    ASSERT_EQ(0u, SurfaceBudget::total());
+    ASSERT_THAT(SurfaceBudget::report(), ::testing::HasSubstr("artwork 0.0 MB"));
+}
+
+TEST_F(SurfaceBudgetTest, SurfacesDrawnThisFrameAreKept)
+{
+    Artwork visible;
+    Artwork hidden;
+
+    visible.draw();
+    hidden.draw();
+    SurfaceBudget::endFrame();
+
+    SurfaceBudget::setBudget(ArtworkBytes);
+    visible.draw();
+    SurfaceBudget::endFrame();
+    ASSERT_TRUE(visible.loaded);
+    ASSERT_FALSE(hidden.loaded);
+
+    // nothing left which may be evicted
+    visible.draw();
+    SurfaceBudget::endFrame();
+    ASSERT_TRUE(visible.loaded);
+    ASSERT_GT(SurfaceBudget::total(), SurfaceBudget::budget());
+}
+
+// Scroll a 10k item collection through a list of 16 slots of which 10 are on
+// screen, with a cached page of artwork left behind, and check the budget is
+// kept at the end of every frame.
+TEST_F(SurfaceBudgetTest, ScrollingStaysUnderBudget)
+{
+    const size_t items   = 10000;
+    const size_t slots   = 16;
+    const size_t visible = 10;
+    const size_t budget  = 12 * (ArtworkBytes + ScaledBytes);
+
+    std::vector< std::unique_ptr<Artwork> > cachedPage(20);
+    for(size_t i = 0; i < cachedPage.size(); ++i)
+    {
+        cachedPage[i].reset(new Artwork());
+        cachedPage[i]->draw();
+    }
+    SurfaceBudget::endFrame();
+
+    SurfaceBudget::setBudget(budget);
+    uint64_t evictions = SurfaceBudget::evictions();
+
+    std::deque< std::unique_ptr<Artwork> > list;
+    for(size_t i = 0; i < slots; ++i)
+    {
+        list.push_back(std::unique_ptr<Artwork>(new Artwork()));
+    }
+
+    for(size_t item = slots; item < items; ++item)
+    {
+        list.pop_front();
+        list.push_back(std::unique_ptr<Artwork>(new Artwork()));
+
+        for(size_t i = 0; i < visible; ++i)
+        {
+            list[i]->draw();
+        }
+        SurfaceBudget::endFrame();
+
+        ASSERT_LE(SurfaceBudget::total(), budget) << "after item " << item;
+        for(size_t i = 0; i < visible; ++i)
+        {
+            ASSERT_TRUE(list[i]->loaded);
+        }
+    }
+
+    for(size_t i = 0; i < cachedPage.size(); ++i)
+    {
+        ASSERT_FALSE(cachedPage[i]->loaded);
+    }
+    ASSERT_GT(SurfaceBudget::evictions(), evictions);
+    ASSERT_GT(SurfaceBudget::peak(), budget);
+}
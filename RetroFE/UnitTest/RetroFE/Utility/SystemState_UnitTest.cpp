@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Utility/SystemState.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+
+class SystemStateTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        char root[] = "/tmp/retrofe_sysfs_XXXXXX";
+        root_ = mkdtemp(root);
+        capacity_ = root_ + "/capacity";
+        batteryPresent_ = root_ + "/battery_present";
+        usbPresent_ = root_ + "/usb_present";
+    }
+
+    virtual void TearDown()
+    {
+        SystemState::stop();
+        std::remove(capacity_.c_str());
+        std::remove(batteryPresent_.c_str());
+        std::remove(usbPresent_.c_str());
+        std::remove(root_.c_str());
+    }
+
+    void writeValue(const std::string &file, int value)
+    {
+        std::ofstream out(file.c_str(), std::ios::trunc);
+        out << value << "\n";
+    }
+
+    // waits for a poll that started after this call
+    bool waitForPoll()
+    {
+        unsigned int target = SystemState::getPollCount() + 2;
+        SystemState::refresh();
+        for(int i = 0; i < 500 && SystemState::getPollCount() < target; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            SystemState::refresh();
+        }
+        return SystemState::getPollCount() >= target;
+    }
+
+    std::string root_;
+    std::string capacity_;
+    std::string batteryPresent_;
+    std::string usbPresent_;
+};
+
+TEST_F(SystemStateTest, ValuesAreReadBeforeStartReturns)
+{
+    writeValue(capacity_, 87);
+    writeValue(batteryPresent_, 1);
+    writeValue(usbPresent_, 0);
+
+    SystemState::start(capacity_, batteryPresent_, usbPresent_, 1000);
+
+    ASSERT_EQ(87, SystemState::getBatteryPercent());
+    ASSERT_TRUE(SystemState::isBatteryConnected());
+    ASSERT_FALSE(SystemState::isUsbConnected());
+}
+
+TEST_F(SystemStateTest, PollsSeeChangesThroughOpenDescriptors)
+{
+    writeValue(capacity_, 100);
+    writeValue(batteryPresent_, 1);
+    writeValue(usbPresent_, 0);
+    SystemState::start(capacity_, batteryPresent_, usbPresent_, 1000);
+
+    writeValue(capacity_, 5);
+    writeValue(usbPresent_, 1);
+    ASSERT_TRUE(waitForPoll());
+
+    ASSERT_EQ(5, SystemState::getBatteryPercent());
+    ASSERT_TRUE(SystemState::isUsbConnected());
+}
+
+TEST_F(SystemStateTest, MissingFilesReadAsNoBattery)
+{
+    SystemState::start(capacity_, batteryPresent_, usbPresent_, 1000);
+
+    ASSERT_EQ(0, SystemState::getBatteryPercent());
+    ASSERT_FALSE(SystemState::isBatteryConnected());
+    ASSERT_FALSE(SystemState::isUsbConnected());
+
+    writeValue(batteryPresent_, 1);
+    ASSERT_TRUE(waitForPoll());
+    ASSERT_TRUE(SystemState::isBatteryConnected());
+}
+
+TEST_F(SystemStateTest, LevelChangesAreVisibleImmediately)
+{
+    SystemState::start(capacity_, batteryPresent_, usbPresent_, 1000);
+
+    for(int volume = 0; volume <= 100; volume += 10)
+    {
+        SystemState::setVolume(volume);
+    }
+    SystemState::setBrightness(30);
+
+    ASSERT_EQ(100, SystemState::getVolume());
+    ASSERT_EQ(30, SystemState::getBrightness());
+}
+
+TEST_F(SystemStateTest, FailedLevelReloadsKeepTheLastLevel)
+{
+    SystemState::start(capacity_, batteryPresent_, usbPresent_, 1000);
+    SystemState::setVolume(70);
+    ASSERT_TRUE(waitForPoll());
+
+    // there is no volume command here, so every read fails
+    SystemState::reloadLevels();
+    ASSERT_TRUE(waitForPoll());
+    ASSERT_EQ(70, SystemState::getVolume());
+
+    SystemState::reloadLevels();
+    ASSERT_EQ(70, SystemState::getVolume());
+    ASSERT_TRUE(waitForPoll());
+    ASSERT_EQ(70, SystemState::getVolume());
+}
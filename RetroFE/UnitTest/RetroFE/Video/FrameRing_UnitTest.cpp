@@ -0,0 +1,65 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Video/FrameRing.h>
+#include <thread>
+
+class FrameRingTest : public ::testing::Test
+{
+};
+
+TEST_F(FrameRingTest, PushFailsWhenFull)
+{
+    FrameRing<int, 4> ring;
+    int value = 0;
+
+    ASSERT_FALSE(ring.pop(value));
+
+    for(int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(ring.push(i));
+    }
+    ASSERT_FALSE(ring.push(4));
+    ASSERT_EQ(4u, ring.size());
+
+    for(int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(ring.pop(value));
+        ASSERT_EQ(i, value);
+    }
+    ASSERT_FALSE(ring.pop(value));
+}
+
+TEST_F(FrameRingTest, ProducerAndConsumerThreadsKeepOrder)
+{
+    FrameRing<int, 4> ring;
+    const int count = 10000;
+
+    std::thread producer([&ring, count]()
+    {
+        for(int i = 0; i < count; ++i)
+        {
+            while(!ring.push(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    while(expected < count)
+    {
+        int value;
+        if(ring.pop(value))
+        {
+            ASSERT_EQ(expected, value);
+            expected++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    ASSERT_EQ(0u, ring.size());
+}
@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "../../../Source/SDL.h"
+#include <Database/Configuration.h>
+#include <Video/GStreamerVideo.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+// Plays a videotestsrc clip through GStreamerVideo's playbin and fakesink
+// handoff, headless, and checks that frames arrive and are converted.
+class GStreamerVideoTest : public ::testing::Test
+{
+protected:
+    static const int WIDTH  = 64;
+    static const int HEIGHT = 48;
+
+    std::string clip;
+
+    virtual void SetUp()
+    {
+        static Configuration config;
+        static bool sdlReady = false;
+        if(!sdlReady)
+        {
+            config.setProperty("headless", "yes");
+            config.setProperty("horizontal", "320");
+            config.setProperty("vertical", "240");
+            config.setProperty("fullscreen", "no");
+            config.setProperty("showFrame", "yes");
+            sdlReady = SDL::initialize(config);
+        }
+        ASSERT_TRUE(sdlReady);
+
+        std::stringstream ss;
+        ss << "/tmp/retrofe_video_" << getpid() << ".avi";
+        clip = ss.str();
+    }
+
+    virtual void TearDown()
+    {
+        std::remove(clip.c_str());
+    }
+
+    // Writes one second of SMPTE bars as raw I420 in an AVI, which playbin
+    // demuxes without any codec plugin. CMake only builds this test when
+    // both plugins are installed, so a false here is a real failure.
+    bool writeClip()
+    {
+        std::stringstream ss;
+        ss << "videotestsrc num-buffers=30 pattern=smpte"
+           << " ! video/x-raw,format=I420,width=" << WIDTH << ",height=" << HEIGHT << ",framerate=30/1"
+           << " ! avimux ! filesink location=" << clip;
+
+        GError *error = NULL;
+        GstElement *pipeline = gst_parse_launch(ss.str().c_str(), &error);
+        if(!pipeline || error)
+        {
+            std::cout << "Cannot build \"" << ss.str() << "\": " << (error ? error->message : "") << std::endl;
+            if(error)
+            {
+                g_error_free(error);
+            }
+            if(pipeline)
+            {
+                gst_object_unref(pipeline);
+            }
+            return false;
+        }
+
+        gst_element_set_state(pipeline, GST_STATE_PLAYING);
+        GstBus *bus = gst_element_get_bus(pipeline);
+        GstMessage *msg = gst_bus_timed_pop_filtered(bus, 10 * GST_SECOND,
+                                                     static_cast<GstMessageType>(GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+        bool retVal = msg && GST_MESSAGE_TYPE(msg) == GST_MESSAGE_EOS;
+        if(msg)
+        {
+            gst_message_unref(msg);
+        }
+        gst_object_unref(bus);
+        gst_element_set_state(pipeline, GST_STATE_NULL);
+        gst_object_unref(pipeline);
+
+        return retVal;
+    }
+
+    // Pumps the bus and the frame ring like the render loop does.
+    bool waitForFrame(GStreamerVideo &video)
+    {
+        for(int i = 0; i < 500 && video.getWidth() == 0; ++i)
+        {
+            while(g_main_context_iteration(NULL, FALSE));
+            video.update(0);
+            usleep(10000);
+        }
+        return video.getWidth() != 0;
+    }
+};
+
+const int GStreamerVideoTest::WIDTH;
+const int GStreamerVideoTest::HEIGHT;
+
+TEST_F(GStreamerVideoTest, HandoffFramesAreConverted)
+{
+    GStreamerVideo video;
+    ASSERT_TRUE(video.initialize());
+
+    ASSERT_TRUE(writeClip());
+
+    ASSERT_TRUE(video.play(clip));
+    ASSERT_TRUE(waitForFrame(video));
+    ASSERT_EQ(WIDTH, video.getWidth());
+    ASSERT_EQ(HEIGHT, video.getHeight());
+
+    SDL_Surface *texture = video.getTexture(WIDTH, HEIGHT);
+    ASSERT_TRUE(texture != NULL);
+    ASSERT_EQ(WIDTH, texture->w);
+    ASSERT_EQ(HEIGHT, texture->h);
+    ASSERT_EQ(1u, video.getPresentedFrames());
+
+    // the leftmost SMPTE bar is 75% white
+    Uint8 r, g, b;
+    SDL_LockSurface(texture);
+    Uint8 *pixel = static_cast<Uint8 *>(texture->pixels) + texture->pitch * (HEIGHT / 4);
+    Uint32 value = 0;
+    memcpy(&value, pixel, texture->format->BytesPerPixel);
+    SDL_UnlockSurface(texture);
+    SDL_GetRGB(value, texture->format, &r, &g, &b);
+    ASSERT_NEAR(191, r, 16);
+    ASSERT_NEAR(191, g, 16);
+    ASSERT_NEAR(191, b, 16);
+
+    video.stop();
+}
+
+TEST_F(GStreamerVideoTest, ReplayQueuesEachFrameOnce)
+{
+    GStreamerVideo video;
+    ASSERT_TRUE(video.initialize());
+    ASSERT_TRUE(writeClip());
+
+    ASSERT_TRUE(video.play(clip));
+    ASSERT_TRUE(waitForFrame(video));
+    video.stop();
+
+    ASSERT_TRUE(video.play(clip));
+    ASSERT_TRUE(waitForFrame(video));
+
+    // a second handoff handler would queue every frame twice, and the
+    // copy behind each presented frame would be counted as late
+    unsigned int late = video.getLateFrames();
+    for(int i = 0; i < 50; ++i)
+    {
+        g_main_context_iteration(NULL, FALSE);
+        video.update(0);
+        video.getTexture(WIDTH, HEIGHT);
+        usleep(10000);
+    }
+    ASSERT_LT(1u, video.getPresentedFrames());
+    ASSERT_GE(late + 3, video.getLateFrames());
+
+    video.stop();
+}
@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <Video/YuvConverter.h>
+#include <vector>
+
+class YuvConverterTest : public ::testing::Test
+{
+protected:
+    static YuvConverter::PixelLayout layout32()
+    {
+        YuvConverter::PixelLayout layout = { 4, 16, 8, 0, 0, 0, 0, 0xFF000000 };
+        return layout;
+    }
+
+    static YuvConverter::PixelLayout layout565()
+    {
+        YuvConverter::PixelLayout layout = { 2, 11, 5, 0, 3, 2, 3, 0 };
+        return layout;
+    }
+};
+
+TEST_F(YuvConverterTest, RowKernelMatchesScalarReference)
+{
+    const int count = 256 + 7;
+    std::vector<unsigned char> y(count), u(count), v(count);
+
+    for(int i = 0; i < count; ++i)
+    {
+        y[i] = static_cast<unsigned char>(i * 7);
+        u[i] = static_cast<unsigned char>(i * 13 + 5);
+        v[i] = static_cast<unsigned char>(255 - i * 3);
+    }
+
+    std::vector<unsigned int> fast32(count), slow32(count);
+    YuvConverter::convertRow(&y[0], &u[0], &v[0], layout32(), &fast32[0], count);
+    YuvConverter::convertRowScalar(&y[0], &u[0], &v[0], layout32(), &slow32[0], 0, count);
+    ASSERT_EQ(slow32, fast32);
+
+    std::vector<unsigned short> fast16(count), slow16(count);
+    YuvConverter::convertRow(&y[0], &u[0], &v[0], layout565(), &fast16[0], count);
+    YuvConverter::convertRowScalar(&y[0], &u[0], &v[0], layout565(), &slow16[0], 0, count);
+    ASSERT_EQ(slow16, fast16);
+}
+
+TEST_F(YuvConverterTest, ConvertsReferenceColours)
+{
+    unsigned char y[3] = { 16, 235, 81 };
+    unsigned char u[3] = { 128, 128, 90 };
+    unsigned char v[3] = { 128, 128, 240 };
+    unsigned int out[3];
+
+    YuvConverter::convertRowScalar(y, u, v, layout32(), out, 0, 3);
+
+    ASSERT_EQ(0xFF000000u, out[0]);
+    ASSERT_EQ(0xFFFFFFFFu, out[1]);
+    ASSERT_NEAR(255, (out[2] >> 16) & 0xFF, 2);
+    ASSERT_NEAR(0, (out[2] >> 8) & 0xFF, 2);
+    ASSERT_NEAR(0, out[2] & 0xFF, 2);
+}
+
+TEST_F(YuvConverterTest, ScalesToDestinationRect)
+{
+    // 4x2 source: left half black, right half white
+    unsigned char y[8] = { 16, 16, 235, 235, 16, 16, 235, 235 };
+    unsigned char u[2] = { 128, 128 };
+    unsigned char v[2] = { 128, 128 };
+    YuvConverter::Planes planes = { y, u, v, 4, 2, 2, 4, 2 };
+    std::vector<unsigned int> out(8 * 3, 0);
+    YuvConverter converter;
+
+    ASSERT_TRUE(converter.convert(planes, layout32(), &out[0], 8 * 4, 8, 3));
+
+    for(int row = 0; row < 3; ++row)
+    {
+        for(int x = 0; x < 8; ++x)
+        {
+            ASSERT_EQ(x < 4 ? 0xFF000000u : 0xFFFFFFFFu, out[row * 8 + x]);
+        }
+    }
+
+    ASSERT_FALSE(converter.convert(planes, layout32(), &out[0], 8 * 4, 0, 3));
+}
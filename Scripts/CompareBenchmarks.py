@@ -0,0 +1,43 @@
+import argparse
+import json
+import sys
+
+#####################################################################
+# Compare two RunBenchmarks --json=<file> results (base and new)
+#####################################################################
+parser = argparse.ArgumentParser(description='Compare two RetroFE benchmark runs.')
+parser.add_argument('base', help='JSON results of the reference build')
+parser.add_argument('new', help='JSON results of the build to check')
+parser.add_argument('--threshold', type=float, default=5.0, help='Percentage slowdown reported as a regression (default 5)')
+parser.add_argument('--fail', action='store_true', help='Exit with status 1 when any benchmark regressed')
+
+args = parser.parse_args()
+
+def load(path):
+  with open(path) as f:
+    results = json.load(f)
+  return dict((b['name'], b) for b in results['benchmarks'])
+
+base = load(args.base)
+new = load(args.new)
+
+print('%-40s %14s %14s %9s' % ('Benchmark', 'Base (ns)', 'New (ns)', 'Change'))
+regressions = 0
+for name in sorted(set(base) | set(new)):
+  if name not in base or name not in new:
+    print('%-40s %s' % (name, 'only in base' if name in base else 'only in new'))
+    continue
+
+  before = base[name]['real_time']
+  after = new[name]['real_time']
+  change = (after - before) * 100.0 / before if before > 0 else 0.0
+  flag = ''
+  if change > args.threshold:
+    flag = '  REGRESSION'
+    regressions += 1
+  elif change < -args.threshold:
+    flag = '  improved'
+  print('%-40s %14.0f %14.0f %+8.1f%%%s' % (name, before, after, change, flag))
+
+if args.fail and regressions > 0:
+  sys.exit(1)